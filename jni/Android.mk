@@ -16,13 +16,23 @@ include $(CLEAR_VARS)
 
 # 2. Modul: native Invisiboga-Bibliothes erstellen
 LOCAL_MODULE := Invisiboga
-TARGET_PLATFORM := android-8
-OPENGLES_LIB  := -lGLESv1_CM
-OPENGLES_DEF  := -DUSE_OPENGL_ES_1_1
+TARGET_PLATFORM := android-9
+OPENGLES_LIB  := -lGLESv1_CM -lGLESv2
+OPENGLES_DEF  := -DUSE_OPENGL_ES_1_1 -DUSE_OPENGL_ES_2_0
 LOCAL_CFLAGS := -Wno-write-strings $(OPENGLES_DEF)
-LOCAL_LDLIBS := -llog $(OPENGLES_LIB)
+LOCAL_LDLIBS := -landroid -llog -lz $(OPENGLES_LIB)
 LOCAL_SHARED_LIBRARIES := QCAR-prebuilt
-LOCAL_SRC_FILES := field.cpp game.cpp invisiboga.cpp invisibogaGlSurfaceView.cpp mathUtils.cpp \
-	overlayView.cpp pawn.cpp player.cpp renderer.cpp Texture.cpp timeUtilities.cpp utils.cpp
+LOCAL_SRC_FILES := board.cpp dragPath.cpp etc1.cpp field.cpp game.cpp glState.cpp invisiboga.cpp \
+	invisibogaGlSurfaceView.cpp ktxTexture.cpp latheMesh.cpp mathUtils.cpp mesh.cpp overlayView.cpp \
+	pawn.cpp player.cpp pngDecoder.cpp renderer.cpp shaderRenderer.cpp spaceGrid.cpp spaceKernels.cpp \
+	Texture.cpp textureAtlas.cpp textureLoader.cpp timeUtilities.cpp utils.cpp
+# NEON-Kernel nur für armeabi-v7a, verwendet werden sie erst nach einer Prüfung des Prozessors
+ifeq ($(TARGET_ARCH_ABI),armeabi-v7a)
+LOCAL_CFLAGS += -DHAVE_NEON_KERNELS
+LOCAL_SRC_FILES += spaceKernelsNeon.cpp.neon
+endif
+LOCAL_STATIC_LIBRARIES := cpufeatures
 LOCAL_ARM_MODE := arm
 include $(BUILD_SHARED_LIBRARY)
+
+$(call import-module,android/cpufeatures)
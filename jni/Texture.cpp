@@ -8,74 +8,217 @@
  * @date 28.05.2011
  */
 
+#include <stdlib.h>
 #include <string.h>
+#include <GLES/gl.h>
 
+#include "ktxTexture.h"
+#include "pngDecoder.h"
 #include "Texture.h"
+#include "timeUtilities.h"
 #include "utils.h"
 
 /**
  * @class Texture
  *
- * @brief Textur.
+ * @brief Textur. Liegt entweder unkomprimiert (mData, RGBA) oder als ETC1-komprimierte Farb- und
+ * Alpha-Ebene (mColorImage und mAlphaImage, siehe ktxTexture.cpp) vor. Wird die Alpha-Ebene als
+ * eigene Textur in den Grafikspeicher geladen, ist mAlphaTextureID ungleich 0. Nach dem Hochladen
+ * werden die Pixel-Daten mit releasePixelData() freigegeben.
  */
 Texture::Texture() :
-        mWidth(0), mHeight(0), mChannelCount(0), mData(0), mTextureID(0) {
+        mWidth(0), mHeight(0), mChannelCount(0), mData(0), mTextureID(0), mAlphaTextureID(0),
+        mColorImage(0), mAlphaImage(0) {
 }
 
 Texture::~Texture() {
+    releasePixelData();
+}
+
+/**
+ * Gibt die Größe der Pixel-Daten im Hauptspeicher zurück.
+ *
+ * @return Größe der unkomprimierten oder komprimierten Pixel-Daten in Byte.
+ */
+unsigned int Texture::getPixelDataSize() const {
+    unsigned int size = mData != 0 ? mWidth * mHeight * mChannelCount : 0;
+    const KtxImage* images[2] = { mColorImage, mAlphaImage };
+    for (int i = 0; i < 2; ++i) {
+        for (uint32_t level = 0; images[i] != 0 && images[i]->header != NULL
+                && level < images[i]->header->numberOfMipmapLevels; ++level) {
+            size += images[i]->levelSizes[level];
+        }
+    }
+    return size;
+}
+
+/**
+ * Gibt die Pixel-Daten im Hauptspeicher frei. Die Textur-Objekte im Grafikspeicher bleiben
+ * erhalten; geht der GL-Kontext verloren, muss die Textur neu geladen werden.
+ */
+void Texture::releasePixelData() {
     if (mData != 0) {
         delete[] mData;
+        mData = 0;
+    }
+    if (mColorImage != 0) {
+        freeKtxImage(mColorImage);
+        delete mColorImage;
+        mColorImage = 0;
+    }
+    if (mAlphaImage != 0) {
+        freeKtxImage(mAlphaImage);
+        delete mAlphaImage;
+        mAlphaImage = 0;
     }
 }
 
 /**
- * Erezugt eine Textur-Instanz für die Verwendung auf der nativen Ebene aus einem Textur-Objekt auf
- * Java-Ebene.
+ * Lädt eine Textur aus einer PNG-Datei im Android Package. Die Datei wird mit decodePng() direkt in
+ * mData dekodiert (RGBA, erste Zeile unten), ohne Umweg über eine Java-Bitmap.
  *
- * @param env JNI interface pointer.
- * @param textureObject Textur-Objekt.
- * @return Erzeugte Textur-Instanz.
+ * @param assetManager Der Asset-Manager des Android Packages.
+ * @param fileName Name der PNG-Datei im Verzeichnis "assets".
+ * @return Die Textur oder NULL, wenn die Datei nicht geladen werden konnte.
  */
-Texture* Texture::create(JNIEnv* env, jobject textureObject) {
-    Texture* newTexture = new Texture();
-    jclass textureClass = env->GetObjectClass(textureObject);
-    jfieldID widthID = env->GetFieldID(textureClass, "mWidth", "I");
-    if (!widthID) {
-        LOG("Field mWidth not found.");
-        return 0;
+Texture* Texture::load(AAssetManager* assetManager, const char* fileName) {
+    unsigned long startTime = getCurrentTimeInMs();
+    AAsset* asset = AAssetManager_open(assetManager, fileName, AASSET_MODE_BUFFER);
+    if (asset == NULL) {
+        LOGE("Texture::load: could not open %s", fileName);
+        return NULL;
     }
-    newTexture->mWidth = env->GetIntField(textureObject, widthID);
-    jfieldID heightID = env->GetFieldID(textureClass, "mHeight", "I");
-    if (!heightID) {
-        LOG("Field mHeight not found.");
-        return 0;
+    // komprimiert abgelegte Dateien liefern keinen Puffer und werden einmal kopiert
+    size_t size = AAsset_getLength(asset);
+    const void* data = AAsset_getBuffer(asset);
+    void* buffer = NULL;
+    if (data == NULL) {
+        buffer = malloc(size);
+        if (buffer == NULL || AAsset_read(asset, buffer, size) != (int)size) {
+            LOGE("Texture::load: could not read %s", fileName);
+            free(buffer);
+            AAsset_close(asset);
+            return NULL;
+        }
+        data = buffer;
     }
-    newTexture->mHeight = env->GetIntField(textureObject, heightID);
-    newTexture->mChannelCount = 4;
-    jmethodID texBufferMethodId = env->GetMethodID(textureClass, "getData", "()[B");
-    if (!texBufferMethodId) {
-        LOG("Function GetTextureBuffer() not found.");
-        return 0;
+    uint32_t width;
+    uint32_t height;
+    uint8_t* pixels;
+    bool decoded = decodePng((const uint8_t*)data, size, &width, &height, &pixels);
+    free(buffer);
+    AAsset_close(asset);
+    if (!decoded) {
+        LOGE("Texture::load: could not decode %s", fileName);
+        return NULL;
+    }
+    Texture* texture = new Texture();
+    texture->mWidth = width;
+    texture->mHeight = height;
+    texture->mChannelCount = 4;
+    texture->mData = pixels;
+    LOG("Texture::load(%s): %ux%u in %lu ms", fileName, width, height,
+            getCurrentTimeInMs() - startTime);
+    return texture;
+}
+
+/**
+ * Prüft, ob ein Wert eine Zweierpotenz ist.
+ *
+ * @param value Der Wert.
+ * @return true, wenn value eine Zweierpotenz ist.
+ */
+static bool isPowerOfTwo(unsigned int value) {
+    return value != 0 && (value & (value - 1)) == 0;
+}
+
+/**
+ * Berechnet aus einer Mipmap-Stufe (RGBA) die nächstkleinere Stufe mit halber Breite und Höhe
+ * (mindestens 1). Jedes Texel ist der Mittelwert der 2x2 darüberliegenden Texel. Die Farben werden
+ * dabei mit dem Alpha-Wert gewichtet, damit transparente Texel die Ränder nicht abdunkeln.
+ *
+ * @param source Die größere Stufe.
+ * @param width Breite der größeren Stufe.
+ * @param height Höhe der größeren Stufe.
+ * @param destination Erhält die kleinere Stufe.
+ */
+static void downsample(const unsigned char *source, unsigned int width, unsigned int height,
+        unsigned char *destination) {
+    unsigned int halfWidth = width > 1 ? width / 2 : 1;
+    unsigned int halfHeight = height > 1 ? height / 2 : 1;
+    for (unsigned int y = 0; y < halfHeight; ++y) {
+        // bei einer Seitenlänge von 1 wird dieselbe Zeile bzw. Spalte doppelt verwendet
+        const unsigned char *rows[2];
+        rows[0] = source + 2 * y * width * 4;
+        rows[1] = height > 1 ? rows[0] + width * 4 : rows[0];
+        for (unsigned int x = 0; x < halfWidth; ++x) {
+            unsigned int columns[2] = { 2 * x, width > 1 ? 2 * x + 1 : 2 * x };
+            unsigned int color[3] = { 0, 0, 0 };
+            unsigned int alpha = 0;
+            for (int i = 0; i < 4; ++i) {
+                const unsigned char *texel = rows[i / 2] + columns[i % 2] * 4;
+                for (int c = 0; c < 3; ++c) {
+                    color[c] += texel[c] * texel[3];
+                }
+                alpha += texel[3];
+            }
+            unsigned char *result = destination + (y * halfWidth + x) * 4;
+            for (int c = 0; c < 3; ++c) {
+                result[c] = alpha == 0 ? 0 : (color[c] + alpha / 2) / alpha;
+            }
+            result[3] = (alpha + 2) / 4;
+        }
+    }
+}
+
+/**
+ * Erzeugt ein GL-Textur-Objekt für die Textur und lädt die Pixeldaten in den Grafikspeicher.
+ *
+ * Bei Texturen mit Zweierpotenzen als Seitenlängen wird die vollständige Mipmap-Kette auf der CPU
+ * berechnet und mit trilinearer Filterung (GL_LINEAR_MIPMAP_LINEAR) verwendet. Das funktioniert
+ * unter OpenGL ES 1.1 und 2.0 gleichermaßen, anders als GL_GENERATE_MIPMAP bzw. glGenerateMipmap.
+ * Andere Texturen werden nur bilinear gefiltert, da OpenGL ES 2.0 für sie keine Mipmaps erlaubt.
+ *
+ * Komprimierte Texturen bringen ihre Mipmap-Kette mit und werden mit uploadKtxTexture() geladen.
+ *
+ * Die Textur muss vier Kanäle haben. Das Textur-Objekt muss zum Zeitpunkt des Aufrufs gebunden
+ * werden dürfen, also ein aktueller GL-Kontext vorhanden sein.
+ */
+void Texture::upload() {
+    if (mColorImage != 0) {
+        uploadKtxTexture(this);
+        return;
     }
-    jbyteArray pixelBuffer = (jbyteArray)env->CallObjectMethod(textureObject, texBufferMethodId);
-    if (pixelBuffer == NULL) {
-        LOG("Get image buffer returned zero pointer");
-        return 0;
+    if (mData == 0) {
+        LOGE("Texture::upload: pixel data already released");
+        return;
     }
-    jboolean isCopy;
-    jbyte* pixels = env->GetByteArrayElements(pixelBuffer, &isCopy);
-    if (pixels == NULL) {
-        LOG("Failed to get texture buffer.");
-        return 0;
+    glGenTextures(1, &mTextureID);
+    glBindTexture(GL_TEXTURE_2D, mTextureID);
+    bool mipmapped = isPowerOfTwo(mWidth) && isPowerOfTwo(mHeight);
+    glTexParameterf(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER,
+            mipmapped ? GL_LINEAR_MIPMAP_LINEAR : GL_LINEAR);
+    glTexParameterf(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, GL_LINEAR);
+    glTexImage2D(GL_TEXTURE_2D, 0, GL_RGBA, mWidth, mHeight, 0, GL_RGBA, GL_UNSIGNED_BYTE,
+            (GLvoid*)mData);
+    if (!mipmapped) {
+        return;
     }
-    newTexture->mData = new unsigned char[newTexture->mWidth * newTexture->mHeight
-            * newTexture->mChannelCount];unsigned
-    char* textureData = (unsigned char*)pixels;
-    int rowSize = newTexture->mWidth * newTexture->mChannelCount;
-    for (int r = 0; r < newTexture->mHeight; ++r) {
-        memcpy(newTexture->mData + rowSize * r, pixels + rowSize * (newTexture->mHeight - 1 - r),
-                newTexture->mWidth * 4);
+    // zwei Puffer für die Stufen, die abwechselnd als Quelle und Ziel dienen
+    unsigned int bufferSize = (mWidth > 1 ? mWidth / 2 : 1) * (mHeight > 1 ? mHeight / 2 : 1) * 4;
+    unsigned char *buffers[2] = { new unsigned char[bufferSize], new unsigned char[bufferSize] };
+    const unsigned char *source = mData;
+    unsigned int width = mWidth;
+    unsigned int height = mHeight;
+    for (int level = 1; width > 1 || height > 1; ++level) {
+        unsigned char *destination = buffers[level % 2];
+        downsample(source, width, height, destination);
+        width = width > 1 ? width / 2 : 1;
+        height = height > 1 ? height / 2 : 1;
+        glTexImage2D(GL_TEXTURE_2D, level, GL_RGBA, width, height, 0, GL_RGBA, GL_UNSIGNED_BYTE,
+                (GLvoid*)destination);
+        source = destination;
     }
-    env->ReleaseByteArrayElements(pixelBuffer, pixels, 0);
-    return newTexture;
+    delete[] buffers[0];
+    delete[] buffers[1];
 }
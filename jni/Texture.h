@@ -11,7 +11,9 @@
 #ifndef TEXTURE_H
 #define TEXTURE_H
 
-#include <jni.h>
+#include <android/asset_manager.h>
+
+struct KtxImage;
 
 class Texture {
 public:
@@ -19,12 +21,18 @@ public:
     ~Texture();
     unsigned int getWidth() const;
     unsigned int getHeight() const;
-    static Texture* create(JNIEnv* env, jobject textureObject);
+    static Texture* load(AAssetManager* assetManager, const char* fileName);
+    void upload();
+    unsigned int getPixelDataSize() const;
+    void releasePixelData();
     unsigned int mWidth;
     unsigned int mHeight;
     unsigned int mChannelCount;
     unsigned char* mData;
     unsigned int mTextureID;
+    unsigned int mAlphaTextureID;
+    KtxImage* mColorImage;
+    KtxImage* mAlphaImage;
 };
 
 #endif
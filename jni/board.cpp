@@ -0,0 +1,173 @@
+/**
+ * @file board.cpp
+ *
+ * @brief Schreiben und Abbilden der Spielfeld-Dateien (siehe boardFile.h).
+ *
+ * @details Eine Datei wird zuerst unter einem temporären Namen vollständig geschrieben und erst
+ *      danach umbenannt, ein Abbruch beim Schreiben hinterlässt also nie eine halbe Datei unter
+ *      dem eigentlichen Namen. Beim Laden wird die Datei mit mmap() in den Speicher abgebildet und
+ *      vor jeder Verwendung über Kennung, Version, Größe und Prüfsumme geprüft. Die Abschnitte
+ *      werden dabei nicht gelesen oder umgewandelt, sondern stehen direkt als Arrays zur
+ *      Verfügung.
+ *
+ *      Die Datei hängt nur von der Standard-Bibliothek, POSIX und zlib ab, damit sie auch auf dem
+ *      Entwicklungsrechner übersetzt werden kann (siehe tools/boardBenchmark.cpp).
+ *
+ * @author Alexander Bertram
+ *
+ * @date 16.10.2026
+ */
+
+#include <errno.h>
+#include <fcntl.h>
+#include <stdio.h>
+#include <string.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+#include <zlib.h>
+
+#include "board.h"
+
+/**
+ * Berechnet die Größe der Abschnitte hinter dem Header.
+ *
+ * @param spaceCount Anzahl der Felder.
+ * @return Größe in Byte.
+ */
+static size_t getBoardSectionsSize(size_t spaceCount) {
+    return 3 * spaceCount * sizeof(float) + ((spaceCount + 3) & ~(size_t)3);
+}
+
+/**
+ * Schreibt ein Spielfeld in eine Datei. Eine vorhandene Datei wird erst ersetzt, wenn die neue
+ * vollständig geschrieben wurde.
+ *
+ * @param fileName Name der Datei.
+ * @param markerName Name des Markers, wird auf BOARD_FILE_MARKER_NAME_LENGTH - 1 Zeichen gekürzt.
+ * @param spaceCount Anzahl der Felder.
+ * @param x X-Koordinaten der Felder.
+ * @param y Y-Koordinaten der Felder.
+ * @param angles Winkel der Felder in Grad.
+ * @param types Typen der Felder.
+ * @return false, wenn die Datei nicht geschrieben werden konnte.
+ */
+bool writeBoardFile(const char *fileName, const char *markerName, int spaceCount, const float *x,
+        const float *y, const float *angles, const uint8_t *types) {
+    BoardFileHeader header;
+    memset(&header, 0, sizeof(header));
+    memcpy(header.magic, BOARD_FILE_MAGIC, sizeof(header.magic));
+    header.version = BOARD_FILE_VERSION;
+    header.spaceCount = spaceCount;
+    strncpy(header.markerName, markerName, BOARD_FILE_MARKER_NAME_LENGTH - 1);
+    // Prüfsumme in der Reihenfolge der Datei berechnen
+    static const uint8_t padding[3] = { 0, 0, 0 };
+    size_t paddingSize = (4 - spaceCount % 4) % 4;
+    size_t floatsSize = spaceCount * sizeof(float);
+    uLong checksum = crc32(0L, Z_NULL, 0);
+    checksum = crc32(checksum, (const Bytef*)&header.spaceCount,
+            sizeof(header) - offsetof(BoardFileHeader, spaceCount));
+    checksum = crc32(checksum, (const Bytef*)x, floatsSize);
+    checksum = crc32(checksum, (const Bytef*)y, floatsSize);
+    checksum = crc32(checksum, (const Bytef*)angles, floatsSize);
+    checksum = crc32(checksum, types, spaceCount);
+    checksum = crc32(checksum, padding, paddingSize);
+    header.checksum = checksum;
+    // unter temporärem Namen schreiben
+    char temporaryFileName[FILENAME_MAX];
+    if (snprintf(temporaryFileName, sizeof(temporaryFileName), "%s.tmp", fileName)
+            >= (int)sizeof(temporaryFileName)) {
+        return false;
+    }
+    FILE *file = fopen(temporaryFileName, "wb");
+    if (file == NULL) {
+        return false;
+    }
+    bool written = fwrite(&header, sizeof(header), 1, file) == 1
+            && fwrite(x, 1, floatsSize, file) == floatsSize
+            && fwrite(y, 1, floatsSize, file) == floatsSize
+            && fwrite(angles, 1, floatsSize, file) == floatsSize
+            && fwrite(types, 1, spaceCount, file) == (size_t)spaceCount
+            && fwrite(padding, 1, paddingSize, file) == paddingSize
+            && fflush(file) == 0 && fsync(fileno(file)) == 0;
+    if (fclose(file) != 0 || !written) {
+        unlink(temporaryFileName);
+        return false;
+    }
+    // erst die vollständige Datei ersetzt die alte
+    if (rename(temporaryFileName, fileName) != 0) {
+        unlink(temporaryFileName);
+        return false;
+    }
+    return true;
+}
+
+/**
+ * Bildet eine Spielfeld-Datei in den Speicher ab und prüft sie.
+ *
+ * @param fileName Name der Datei.
+ * @param maxSpaceCount Maximale Anzahl der Felder, Dateien mit mehr Feldern sind ungültig.
+ * @param board Abgebildete Datei, nur bei BOARD_FILE_MAPPED gesetzt und dann mit
+ *      unmapBoardFile() freizugeben.
+ * @return Ergebnis des Abbildens.
+ */
+BoardFileStatus mapBoardFile(const char *fileName, int maxSpaceCount, MappedBoardFile *board) {
+    int fd = open(fileName, O_RDONLY);
+    if (fd < 0) {
+        return errno == ENOENT ? BOARD_FILE_MISSING : BOARD_FILE_UNREADABLE;
+    }
+    struct stat status;
+    if (fstat(fd, &status) != 0) {
+        close(fd);
+        return BOARD_FILE_UNREADABLE;
+    }
+    size_t size = status.st_size;
+    if (size < sizeof(BoardFileHeader)) {
+        close(fd);
+        return BOARD_FILE_INVALID;
+    }
+    // die Abbildung bleibt nach dem Schließen der Datei bestehen
+    void *data = mmap(NULL, size, PROT_READ, MAP_PRIVATE, fd, 0);
+    close(fd);
+    if (data == MAP_FAILED) {
+        return BOARD_FILE_UNREADABLE;
+    }
+    const BoardFileHeader *header = (const BoardFileHeader*)data;
+    if (memcmp(header->magic, BOARD_FILE_MAGIC, sizeof(header->magic)) != 0
+            || header->version != BOARD_FILE_VERSION
+            || header->spaceCount > (uint32_t)maxSpaceCount
+            || size != sizeof(BoardFileHeader) + getBoardSectionsSize(header->spaceCount)
+            || header->markerName[BOARD_FILE_MARKER_NAME_LENGTH - 1] != '\0') {
+        munmap(data, size);
+        return BOARD_FILE_INVALID;
+    }
+    const uint8_t *checked = (const uint8_t*)&header->spaceCount;
+    if (crc32(crc32(0L, Z_NULL, 0), checked, (const uint8_t*)data + size - checked)
+            != header->checksum) {
+        munmap(data, size);
+        return BOARD_FILE_CORRUPTED;
+    }
+    // die Abschnitte liegen an 4-Byte-Grenzen direkt hinter dem Header
+    board->data = data;
+    board->size = size;
+    board->spaceCount = header->spaceCount;
+    board->markerName = header->markerName;
+    board->x = (const float*)(header + 1);
+    board->y = board->x + board->spaceCount;
+    board->angles = board->y + board->spaceCount;
+    board->types = (const uint8_t*)(board->angles + board->spaceCount);
+    return BOARD_FILE_MAPPED;
+}
+
+/**
+ * Hebt die Abbildung einer Spielfeld-Datei auf.
+ *
+ * @param board Abgebildete Datei.
+ */
+void unmapBoardFile(MappedBoardFile *board) {
+    if (board->data != NULL) {
+        munmap(board->data, board->size);
+        board->data = NULL;
+    }
+}
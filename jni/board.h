@@ -0,0 +1,89 @@
+/**
+ * @file board.h
+ *
+ * @brief Schnittstelle zu board.cpp.
+ *
+ * @author Alexander Bertram
+ *
+ * @date 16.10.2026
+ */
+
+#ifndef BOARD_H
+#define BOARD_H
+
+#include <stddef.h>
+#include <stdint.h>
+
+#include "boardFile.h"
+
+/**
+ * @brief Ergebnis beim Abbilden einer Spielfeld-Datei.
+ */
+typedef enum BoardFileStatus {
+    /**
+     * Die Datei wurde abgebildet und ist gültig.
+     */
+    BOARD_FILE_MAPPED,
+    /**
+     * Die Datei existiert nicht, z.B. beim ersten Start.
+     */
+    BOARD_FILE_MISSING,
+    /**
+     * Die Datei konnte nicht gelesen werden.
+     */
+    BOARD_FILE_UNREADABLE,
+    /**
+     * Kennung, Version oder Größe der Datei passen nicht.
+     */
+    BOARD_FILE_INVALID,
+    /**
+     * Die Prüfsumme passt nicht zum Inhalt.
+     */
+    BOARD_FILE_CORRUPTED
+} BoardFileStatus;
+
+/**
+ * @brief In den Speicher abgebildete Spielfeld-Datei. Die Zeiger zeigen direkt in die Abbildung
+ * und bleiben bis unmapBoardFile() gültig.
+ */
+typedef struct MappedBoardFile {
+    /**
+     * Anfang der Abbildung.
+     */
+    void *data;
+    /**
+     * Größe der Abbildung in Byte.
+     */
+    size_t size;
+    /**
+     * Anzahl der Felder.
+     */
+    int spaceCount;
+    /**
+     * Name des Markers mit abschließender Null.
+     */
+    const char *markerName;
+    /**
+     * X-Koordinaten der Felder.
+     */
+    const float *x;
+    /**
+     * Y-Koordinaten der Felder.
+     */
+    const float *y;
+    /**
+     * Winkel der Felder in Grad.
+     */
+    const float *angles;
+    /**
+     * Typen der Felder (SpaceType).
+     */
+    const uint8_t *types;
+} MappedBoardFile;
+
+bool writeBoardFile(const char*, const char*, int, const float*, const float*, const float*,
+        const uint8_t*);
+BoardFileStatus mapBoardFile(const char*, int, MappedBoardFile*);
+void unmapBoardFile(MappedBoardFile*);
+
+#endif
@@ -0,0 +1,70 @@
+/**
+ * @file boardFile.h
+ *
+ * @brief Beschreibt das binäre Dateiformat der gespeicherten Spielfelder.
+ *
+ * @details Die Datei wird in field.cpp beim Verlassen der Spielfeld-Erstellung in den Speicher der
+ *      App geschrieben und beim nächsten Start in den Speicher abgebildet. Die Abschnitte haben
+ *      dasselbe Layout wie die Arrays in SpaceChunk, damit sie blockweise in das Spielfeld kopiert
+ *      werden können. Alle Werte liegen in Little-Endian-Byte-Reihenfolge vor. Auf den Header
+ *      folgen ohne Lücken:
+ *
+ *      - spaceCount X-Koordinaten (float),
+ *      - spaceCount Y-Koordinaten (float),
+ *      - spaceCount Winkel in Grad (float),
+ *      - spaceCount Feld-Typen (uint8_t, SpaceType), mit Nullen auf 4 Byte aufgefüllt.
+ *
+ *      Die Prüfsumme schützt alles ab spaceCount bis zum Ende der Datei, also auch die Anzahl
+ *      und den Marker-Namen. Die Datei wird nicht erweitert, sondern bei jeder Änderung des
+ *      Formats die Version erhöht. Dateien einer anderen Version werden verworfen.
+ *
+ * @author Alexander Bertram
+ *
+ * @date 16.10.2026
+ */
+
+#ifndef BOARD_FILE_H
+#define BOARD_FILE_H
+
+#include <stdint.h>
+
+/**
+ * Kennung am Anfang jeder Spielfeld-Datei.
+ */
+#define BOARD_FILE_MAGIC "IBGB"
+/**
+ * Aktuelle Version des Dateiformats.
+ */
+#define BOARD_FILE_VERSION 1
+/**
+ * Länge des Marker-Namens einschließlich der abschließenden Null.
+ */
+#define BOARD_FILE_MARKER_NAME_LENGTH 32
+
+/**
+ * @brief Header einer Spielfeld-Datei.
+ */
+typedef struct BoardFileHeader {
+    /**
+     * Kennung der Datei (BOARD_FILE_MAGIC ohne abschließende Null).
+     */
+    char magic[4];
+    /**
+     * Version des Dateiformats.
+     */
+    uint32_t version;
+    /**
+     * CRC-32 (wie zlib) über alle Bytes ab spaceCount bis zum Ende der Datei.
+     */
+    uint32_t checksum;
+    /**
+     * Anzahl der Felder.
+     */
+    uint32_t spaceCount;
+    /**
+     * Name des Markers, auf dem das Spielfeld erstellt wurde, mit Nullen aufgefüllt.
+     */
+    char markerName[BOARD_FILE_MARKER_NAME_LENGTH];
+} BoardFileHeader;
+
+#endif
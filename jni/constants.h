@@ -17,6 +17,22 @@
  * Feld-Radius.
  */
 #define SPACE_RADIUS 10.0f
+/**
+ * Abstand der Abtastpunkte des Zieh-Pfades. Etwas größer als der doppelte Feld-Radius, damit
+ * benachbarte Abtastpunkte trotz Rundungsfehlern und leichter Krümmungen des Pfades den von
+ * canCreateSpace() geforderten Abstand überschreiten.
+ */
+#define DRAG_SAMPLE_SPACING (2.01f * SPACE_RADIUS)
+/**
+ * Maximale Anzahl der Abtastpunkte des Zieh-Pfades, an denen pro Frame Felder erzeugt werden.
+ */
+#define MAX_DRAG_SAMPLE_COUNT 256
+/**
+ * Anzahl der Felder, bis zu der Abstandsabfragen alle Felder mit den SIMD-Kerneln aus
+ * spaceKernels.cpp durchlaufen, statt das Gitter zu verwenden (ein Block, gemessen mit
+ * tools/fieldBenchmark.cpp).
+ */
+#define MAX_SPACE_SCAN_COUNT SPACE_CHUNK_SIZE
 /**
  * Zeit in Millisekunden, bis zu der eine Bildschirm-Berührung als Tippen gilt.
  */
@@ -35,13 +51,17 @@ static const float UNIT_SQUARE_VERTICES[] = {
     -1.0, -1.0, 0.0,
     1.0, -1.0, 0.0 };
 /**
- * Normalen der Ecken des Einheitsquadrates. Diese zeigen alle in die positive z-Richtung.
+ * Ecken des Einheitsquadrates, aus denen die beiden Dreiecke eines Feldes bestehen.
  */
-static const float UNIT_SQUARE_NORMALS[] = {
-    0.0, 0.0, 1.0,
-    0.0, 0.0, 1.0,
-    0.0, 0.0, 1.0,
-    0.0, 0.0, 1.0 };
+static const int UNIT_SQUARE_TRIANGLE_CORNERS[] = { 0, 1, 2, 2, 1, 3 };
+/**
+ * Anzahl der Vertices eines Feldes.
+ */
+#define SPACE_VERTEX_COUNT 4
+/**
+ * Anzahl der Indizes eines Feldes.
+ */
+#define SPACE_INDEX_COUNT 6
 /**
  * Textur-Koordinaten eines Einheitsquadrates.
  */
@@ -50,6 +70,35 @@ static const float UNIT_SQUARE_TEXTURE_COORDINATES[] = {
     1.0, 1.0,
     0.0, 0.0,
     1.0, 0.0 };
+/**
+ * Index des Textur-Atlas der Felder in den Texturen.
+ */
+#define SPACE_TEXTURE_ATLAS 0
+/**
+ * Anzahl der Texturen.
+ */
+#define TEXTURE_COUNT 1
+/**
+ * Breite des Randes um jede Kachel eines Textur-Atlas in Texeln. Der Rand liegt innerhalb der
+ * Zelle: Kacheln mit 256 Texeln Kantenlänge werden auf 240 Texel verkleinert, damit vier Kacheln
+ * in 512x512 Texel passen. Die Mipmap-Stufen greifen bis zu einer Zellengröße von 16 Texeln nicht
+ * auf die Nachbarkacheln zu.
+ */
+#define TEXTURE_ATLAS_PADDING 8
+/**
+ * Anzahl der Frames, nach denen die Render-Statistik ausgegeben wird.
+ */
+#define RENDER_STATISTICS_INTERVAL 300
+/**
+ * Maximale Abweichung der Rotationsanteile der Model-View-Matrix, bis zu der ein Frame als
+ * unverändert gilt.
+ */
+#define IDLE_FRAME_ROTATION_EPSILON 0.001f
+/**
+ * Maximale Abweichung der Translationsanteile der Model-View-Matrix, bis zu der ein Frame als
+ * unverändert gilt.
+ */
+#define IDLE_FRAME_TRANSLATION_EPSILON 0.1f
 /**
  * Anzahl der Spieler.
  */
@@ -66,6 +115,15 @@ static const float UNIT_SQUARE_TEXTURE_COORDINATES[] = {
  * Anzahl der Felder, bei der der "Neustart"-Button angezeigt wird.
  */
 #define SPACE_COUNT_TO_SHOW_RESTART_BUTTON 1
+/**
+ * Auftrag aus dem UI-Thread, das Spielfeld zu leeren und das Spiel neu zu starten (siehe
+ * requestGameAction() in game.cpp).
+ */
+#define GAME_REQUEST_RESTART 1
+/**
+ * Auftrag aus dem UI-Thread, das fertige Spielfeld zu speichern.
+ */
+#define GAME_REQUEST_SAVE_FIELD 2
 /**
  * Maximale Anzahl der Augenwürfel.
  */
@@ -107,6 +165,52 @@ static const Light PAWN_LIGHTS[PLAYER_COUNT] = {
  * Skalierungsfaktor für die Spielfigur.
  */
 #define PAWN_SCALE_FACTOR 20.f
+/**
+ * Name der Model-Datei der Spielfigur im Verzeichnis "assets".
+ */
+#define PAWN_MESH_FILE_NAME "pawn.mesh"
+/**
+ * Name der KTX-Datei mit der Farb-Ebene des komprimierten Textur-Atlas der Felder im Verzeichnis
+ * "assets" (erzeugt mit tools/textureBuilder.cpp). Fehlt sie, wird der Atlas aus den PNG-Dateien
+ * zusammengesetzt.
+ */
+#define SPACE_TEXTURE_ATLAS_FILE_NAME "spaceAtlas.ktx"
+/**
+ * Name der KTX-Datei mit der Alpha-Ebene des komprimierten Textur-Atlas der Felder.
+ */
+#define SPACE_TEXTURE_ATLAS_ALPHA_FILE_NAME "spaceAtlasAlpha.ktx"
+/**
+ * Name der Datei, in der das zuletzt erstellte Spielfeld im Speicher der App abgelegt wird (siehe
+ * boardFile.h).
+ */
+#define BOARD_FILE_NAME "board.ibgb"
+/**
+ * Anzahl der Segmente in Umfangsrichtung, mit der die Spielfigur beim Start als Rotationskörper
+ * erzeugt wird. 32 entspricht der Unterteilung der Quelldaten, auf schwachen Geräten kann ein
+ * kleinerer Wert gewählt werden. Bei 0 wird stattdessen PAWN_MESH_FILE_NAME geladen.
+ */
+#define PAWN_LATHE_SEGMENT_COUNT 32
+/**
+ * Anzahl der Detailstufen des Rotationskörpers. Jede weitere Detailstufe halbiert die Anzahl der
+ * Segmente.
+ */
+#define PAWN_LATHE_LEVEL_OF_DETAIL_COUNT 4
+/**
+ * Knickwinkel in Grad, bis zu dem die Normalen des Rotationskörpers gemittelt werden.
+ */
+#define PAWN_LATHE_CREASE_ANGLE 45.f
+/**
+ * Größe der Spielfigur auf dem Bildschirm in Pixeln (Durchmesser der Umkugel), ab der die volle
+ * Detailstufe verwendet wird. Jede weitere Detailstufe wird ab der halben Größe der vorherigen
+ * verwendet.
+ */
+#define PAWN_LEVEL_OF_DETAIL_SCREEN_SIZE 256.f
+/**
+ * Relativer Abstand zu den Schwellwerten der Detailstufen, den die Größe der Spielfigur auf dem
+ * Bildschirm überschreiten muss, bevor die Detailstufe gewechselt wird. Verhindert ständiges
+ * Wechseln, wenn die Höhe um einen Schwellwert schwankt.
+ */
+#define PAWN_LEVEL_OF_DETAIL_HYSTERESIS 0.15f
 
 /**
  * Definition des Spieler-Typen pro Spieler.
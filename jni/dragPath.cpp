@@ -0,0 +1,77 @@
+/**
+ * @file dragPath.cpp
+ *
+ * @brief Tastet den Zieh-Pfad des Fingers in gleichen Abständen ab.
+ *
+ * @details Die Positionen des Fingers werden als Linienzug in Koordinaten des Trackables
+ *      betrachtet. Entlang dieses Linienzuges wird nach jeweils gleicher Bogenlänge ein Punkt
+ *      ausgegeben, unabhängig davon, wie schnell der Finger gezogen wird und wie viele Positionen
+ *      zwischen zwei Frames anfallen. Der Rest der Bogenlänge wird bis zum nächsten Frame
+ *      mitgeführt.
+ *
+ * @author Alexander Bertram
+ *
+ * @date 16.10.2026
+ */
+
+#include <math.h>
+
+#include "dragPath.h"
+#include "types.h"
+
+/**
+ * Setzt einen Zieh-Pfad zurück, der nächste Punkt beginnt einen neuen Pfad.
+ *
+ * @param path Der Zieh-Pfad.
+ */
+void resetDragPath(DragPath *path) {
+    path->started = false;
+    path->distanceSinceSample = 0.f;
+}
+
+/**
+ * Verlängert einen Zieh-Pfad um mehrere Punkte und gibt die dabei überschrittenen Abtastpunkte
+ * zurück. Der erste Punkt eines neuen Pfades ist immer ein Abtastpunkt.
+ *
+ * @param path Der Zieh-Pfad.
+ * @param points Neue Punkte des Pfades.
+ * @param count Anzahl der neuen Punkte.
+ * @param spacing Bogenlänge zwischen zwei Abtastpunkten.
+ * @param samples Erhält die Abtastpunkte.
+ * @param maxSampleCount Anzahl der Abtastpunkte, für die in samples Platz ist. Weitere
+ *      Abtastpunkte werden verworfen, der Pfad wird trotzdem vollständig verlängert.
+ * @return Anzahl der Abtastpunkte.
+ */
+int extendDragPath(DragPath *path, const QCAR::Vec2F *points, int count, float spacing,
+        QCAR::Vec2F *samples, int maxSampleCount) {
+    int sampleCount = 0;
+    for (int i = 0; i < count; ++i) {
+        const QCAR::Vec2F &point = points[i];
+        if (!path->started) {
+            path->started = true;
+            path->lastPoint = point;
+            path->distanceSinceSample = 0.f;
+            if (sampleCount < maxSampleCount) {
+                samples[sampleCount++] = point;
+            }
+            continue;
+        }
+        float deltaX = point.data[0] - path->lastPoint.data[0];
+        float deltaY = point.data[1] - path->lastPoint.data[1];
+        float length = sqrtf(deltaX * deltaX + deltaY * deltaY);
+        // Bogenlänge vom Anfang des Abschnitts bis zum nächsten Abtastpunkt
+        float distance = spacing - path->distanceSinceSample;
+        while (distance <= length) {
+            if (sampleCount < maxSampleCount) {
+                float t = distance / length;
+                samples[sampleCount].data[0] = path->lastPoint.data[0] + t * deltaX;
+                samples[sampleCount].data[1] = path->lastPoint.data[1] + t * deltaY;
+                ++sampleCount;
+            }
+            distance += spacing;
+        }
+        path->distanceSinceSample = length - (distance - spacing);
+        path->lastPoint = point;
+    }
+    return sampleCount;
+}
@@ -0,0 +1,19 @@
+/**
+ * @file dragPath.h
+ *
+ * @brief Schnittstelle zu dragPath.cpp.
+ *
+ * @author Alexander Bertram
+ *
+ * @date 16.10.2026
+ */
+
+#ifndef DRAG_PATH_H
+#define DRAG_PATH_H
+
+#include "types.h"
+
+void resetDragPath(DragPath*);
+int extendDragPath(DragPath*, const QCAR::Vec2F*, int, float, QCAR::Vec2F*, int);
+
+#endif
@@ -0,0 +1,124 @@
+/**
+ * @file etc1.cpp
+ *
+ * @brief Beinhaltet Funktionen zum Dekodieren von ETC1-komprimierten Bildern.
+ *
+ * @details Wird zur Laufzeit verwendet, wenn der Grafiktreiber ETC1 nicht unterstützt, und in
+ *      tools/textureBuilder.cpp, um die erzeugten Texturen gegen die Quellbilder zu prüfen. Die
+ *      Datei hängt deshalb nur von der C-Standardbibliothek ab.
+ *
+ *      Ein Block beschreibt 4x4 Pixel mit 64 Bit (Big-Endian). Er besteht aus zwei Teilblöcken
+ *      (2x4 nebeneinander oder, mit gesetztem Flip-Bit, 4x2 übereinander) mit je einer Grundfarbe
+ *      und einer Modifikator-Tabelle. Die Grundfarben liegen entweder einzeln mit 4 Bit pro Kanal
+ *      oder differentiell als 5 Bit und vorzeichenbehaftete 3-Bit-Differenz vor. Jedes Pixel wählt
+ *      mit 2 Bit einen Helligkeits-Modifikator aus der Tabelle seines Teilblocks.
+ *
+ * @author Alexander Bertram
+ *
+ * @date 16.10.2026
+ */
+
+#include "etc1.h"
+
+/**
+ * Beträge der Helligkeits-Modifikatoren der acht ETC1-Tabellen.
+ */
+const int ETC1_MODIFIERS[8][2] = { { 2, 8 }, { 5, 17 }, { 9, 29 }, { 13, 42 }, { 18, 60 },
+        { 24, 80 }, { 33, 106 }, { 47, 183 } };
+
+/**
+ * Begrenzt einen Wert auf den Bereich 0 bis 255.
+ *
+ * @param value Der Wert.
+ * @return Der begrenzte Wert.
+ */
+static inline uint8_t clampColor(int value) {
+    return value < 0 ? 0 : (value > 255 ? 255 : value);
+}
+
+/**
+ * Berechnet die Größe eines ETC1-komprimierten Bildes.
+ *
+ * @param width Breite in Pixeln.
+ * @param height Höhe in Pixeln.
+ * @return Größe in Byte.
+ */
+uint32_t etc1ImageSize(uint32_t width, uint32_t height) {
+    return ((width + 3) / 4) * ((height + 3) / 4) * ETC1_BLOCK_SIZE;
+}
+
+/**
+ * Dekodiert einen ETC1-Block. Es werden nur die Farbkanäle geschrieben, der Alpha-Kanal bleibt
+ * unverändert.
+ *
+ * @param block Der Block (8 Byte).
+ * @param pixels Erhält die 4x4 Pixel (RGBA, zeilenweise).
+ * @param rowLength Abstand zweier Zeilen in pixels in Pixeln.
+ */
+void decodeEtc1Block(const uint8_t *block, uint8_t *pixels, uint32_t rowLength) {
+    uint32_t high = (block[0] << 24) | (block[1] << 16) | (block[2] << 8) | block[3];
+    uint32_t low = (block[4] << 24) | (block[5] << 16) | (block[6] << 8) | block[7];
+    bool differential = (high & 2) != 0;
+    bool flipped = (high & 1) != 0;
+    // Grundfarben der beiden Teilblöcke
+    int baseColors[2][3];
+    for (int c = 0; c < 3; ++c) {
+        int shift = 27 - 8 * c;
+        if (differential) {
+            int base = (high >> shift) & 0x1f;
+            int delta = (int)((high >> (shift - 3)) & 7);
+            delta = delta >= 4 ? delta - 8 : delta;
+            int second = base + delta;
+            baseColors[0][c] = (base << 3) | (base >> 2);
+            baseColors[1][c] = ((second << 3) | (second >> 2)) & 0xff;
+        } else {
+            int first = (high >> (shift + 1)) & 0xf;
+            int second = (high >> (shift - 3)) & 0xf;
+            baseColors[0][c] = (first << 4) | first;
+            baseColors[1][c] = (second << 4) | second;
+        }
+    }
+    const int *tables[2] = { ETC1_MODIFIERS[(high >> 5) & 7], ETC1_MODIFIERS[(high >> 2) & 7] };
+    // die Pixel-Indizes sind spaltenweise abgelegt
+    for (int x = 0; x < 4; ++x) {
+        for (int y = 0; y < 4; ++y) {
+            int i = x * 4 + y;
+            int index = (((low >> (i + 16)) & 1) << 1) | ((low >> i) & 1);
+            int subblock = flipped ? (y >= 2) : (x >= 2);
+            int modifier = tables[subblock][index & 1];
+            modifier = index & 2 ? -modifier : modifier;
+            uint8_t *pixel = pixels + (y * rowLength + x) * 4;
+            for (int c = 0; c < 3; ++c) {
+                pixel[c] = clampColor(baseColors[subblock][c] + modifier);
+            }
+        }
+    }
+}
+
+/**
+ * Dekodiert ein ETC1-komprimiertes Bild. Es werden nur die Farbkanäle geschrieben, der
+ * Alpha-Kanal bleibt unverändert.
+ *
+ * @param data Die Blöcke des Bildes, zeilenweise.
+ * @param width Breite in Pixeln.
+ * @param height Höhe in Pixeln.
+ * @param pixels Erhält das Bild (RGBA, zeilenweise, width * height Pixel).
+ */
+void decodeEtc1Image(const uint8_t *data, uint32_t width, uint32_t height, uint8_t *pixels) {
+    uint8_t block[4 * 4 * 4];
+    for (uint32_t blockY = 0; blockY < height; blockY += 4) {
+        for (uint32_t blockX = 0; blockX < width; blockX += 4) {
+            decodeEtc1Block(data, block, 4);
+            data += ETC1_BLOCK_SIZE;
+            // Randblöcke ragen bei Kantenlängen unter 4 über das Bild hinaus
+            for (uint32_t y = 0; y < 4 && blockY + y < height; ++y) {
+                for (uint32_t x = 0; x < 4 && blockX + x < width; ++x) {
+                    uint8_t *pixel = pixels + ((blockY + y) * width + blockX + x) * 4;
+                    for (int c = 0; c < 3; ++c) {
+                        pixel[c] = block[(y * 4 + x) * 4 + c];
+                    }
+                }
+            }
+        }
+    }
+}
@@ -0,0 +1,31 @@
+/**
+ * @file etc1.h
+ *
+ * @brief Schnittstelle zu etc1.cpp.
+ *
+ * @author Alexander Bertram
+ *
+ * @date 16.10.2026
+ */
+
+#ifndef ETC1_H
+#define ETC1_H
+
+#include <stdint.h>
+
+/**
+ * Größe eines ETC1-Blocks (4x4 Pixel) in Byte.
+ */
+#define ETC1_BLOCK_SIZE 8
+
+/**
+ * Beträge der Helligkeits-Modifikatoren der acht ETC1-Tabellen. Die Pixel-Indizes 0 bis 3 stehen
+ * für +a, +b, -a und -b.
+ */
+extern const int ETC1_MODIFIERS[8][2];
+
+uint32_t etc1ImageSize(uint32_t, uint32_t);
+void decodeEtc1Block(const uint8_t*, uint8_t*, uint32_t);
+void decodeEtc1Image(const uint8_t*, uint32_t, uint32_t, uint8_t*);
+
+#endif
@@ -9,9 +9,16 @@
  */
 
 #include <math.h>
+#include <stdlib.h>
+#include <string.h>
 
+#include "board.h"
 #include "constants.h"
+#include "field.h"
 #include "mathUtils.h"
+#include "spaceGrid.h"
+#include "spaceKernels.h"
+#include "timeUtilities.h"
 #include "types.h"
 #include "utils.h"
 
@@ -20,33 +27,124 @@
  */
 Field field;
 
+/**
+ * Entfernt alle Felder vom Spielfeld. Angeforderte Blöcke bleiben erhalten und werden für die
+ * nächsten Felder wiederverwendet.
+ */
+void clearField() {
+    LOGD("clearField");
+    if (field.chunkCount == 0) {
+        field.chunks[0] = &field.firstChunk;
+        field.chunkCount = 1;
+    }
+    field.length = 0;
+    field.markerName[0] = '\0';
+    field.dirty = true;
+    // die Zellen sind so groß wie der geforderte Abstand zwischen zwei Feldern
+    clearSpaceGrid(&field.grid, 2 * SPACE_RADIUS);
+}
+
+/**
+ * Gibt alle angeforderten Blöcke und den Speicher des Gitters frei und leert das Spielfeld.
+ */
+void releaseField() {
+    LOGD("releaseField: %d chunks", field.chunkCount);
+    for (int i = 1; i < field.chunkCount; ++i) {
+        free(field.chunks[i]);
+        field.chunks[i] = NULL;
+    }
+    field.chunkCount = 0;
+    clearField();
+}
+
+/**
+ * Stellt sicher, dass für das nächste Feld ein Block vorhanden ist. Neue Blöcke werden nur
+ * angefordert, wenn keiner der beim Leeren erhaltenen Blöcke mehr frei ist.
+ *
+ * @return false, wenn kein Speicher angefordert werden konnte.
+ */
+static bool reserveSpace() {
+    int chunk = field.length >> SPACE_CHUNK_SHIFT;
+    if (chunk < field.chunkCount) {
+        return true;
+    }
+    SpaceChunk *spaceChunk = (SpaceChunk*)malloc(sizeof(SpaceChunk));
+    if (spaceChunk == NULL) {
+        LOGE("reserveSpace: could not allocate space chunk %d", chunk);
+        return false;
+    }
+    field.chunks[field.chunkCount++] = spaceChunk;
+    return true;
+}
+
+/**
+ * Setzt den Typ eines Feldes und aktualisiert die Typen seines Blocks.
+ *
+ * @param index Index des Feldes.
+ * @param type Neuer Typ.
+ */
+void setSpaceType(int index, SpaceType type) {
+    getSpace(index)->type = type;
+    field.chunks[index >> SPACE_CHUNK_SHIFT]->types[index & (SPACE_CHUNK_SIZE - 1)] = type;
+    field.dirty = true;
+}
+
+/**
+ * Setzt das Besetzt-Flag eines Feldes und aktualisiert die Besetzt-Flags seines Blocks.
+ *
+ * @param index Index des Feldes.
+ * @param occupied Flag, das anzeigt, ob das Feld durch eine Spielfigur besetzt ist.
+ */
+void setSpaceOccupied(int index, bool occupied) {
+    getSpace(index)->occupied = occupied;
+    uint32_t &bits = field.chunks[index >> SPACE_CHUNK_SHIFT]->occupied[
+            (index & (SPACE_CHUNK_SIZE - 1)) >> 5];
+    uint32_t bit = 1u << (index & 31);
+    bits = occupied ? bits | bit : bits & ~bit;
+}
+
 /**
  * Überprüft anhand der Abstände zu den anderen Feldern, ob an der übergebenen Position ein Feld
- * erstellt werden kann.
+ * erstellt werden kann. Dafür werden nur die Felder in den benachbarten Zellen des Gitters geprüft.
  *
  * @param position Die zu überprüfende Position.
  * @return True, wenn an der übergebenen Position ein Feld erstell werden kann.
  */
 bool canCreateSpace(QCAR::Vec2F position) {
-    bool result = true;
-    // nur ausführen, wenn mindestens ein Feld vorhanden ist
-    if (field.length > 0) {
-        // Abstand zum zuletzt erzeugten Feld berechnen
-        float distance = vec2FDistance(position, field.spaces[field.length - 1].position);
-        // Prüfung, ob der Abstand zum zuletzt erzeugten Feld den doppelten Feldradius überschreitet
-        result = distance > 2 * SPACE_RADIUS;
-        if (result) {
-            // Abstand zu allen anderen Feldern berechnen und prüfen, ob der Abstand ok ist
-            for (int i = 0; i < field.length && result; ++i) {
-                // das zuletzt erstellte Feld überspringen, das wurde bereits berechent.
-                if (i != field.length - 1) {
-                    distance = vec2FDistance(position, field.spaces[i].position);
-                    result = distance > 2 * SPACE_RADIUS;
-                }
-            }
+    // der Abstand zu allen anderen Feldern muss den doppelten Feldradius überschreiten
+    if (field.length > MAX_SPACE_SCAN_COUNT) {
+        return isSpaceGridAreaFree(&field.grid, position.data[0], position.data[1],
+                2 * SPACE_RADIUS);
+    }
+    // bei kleinen Spielfeldern ist es schneller, alle Felder blockweise zu prüfen
+    for (int start = 0; start < field.length; start += SPACE_CHUNK_SIZE) {
+        const SpaceChunk *spaceChunk = field.chunks[start >> SPACE_CHUNK_SHIFT];
+        int count = min(field.length - start, SPACE_CHUNK_SIZE);
+        if (!isSpaceArrayAreaFree(spaceChunk->x, spaceChunk->y, count, position.data[0],
+                position.data[1], 4 * SPACE_RADIUS * SPACE_RADIUS)) {
+            return false;
         }
     }
-    return result;
+    return true;
+}
+
+/**
+ * Setzt den Winkel eines Feldes und berechnet die zwischengespeicherte Rotations- und
+ * Skalierungsmatrix des Feldes neu.
+ *
+ * @param space Feld, dessen Winkel gesetzt werden soll.
+ * @param angle Winkel in Grad.
+ */
+static void setSpaceAngle(Space *space, float angle) {
+    float radians = angle * (float)M_PI / 180.f;
+    float cosine = SPACE_RADIUS * cosf(radians);
+    float sine = SPACE_RADIUS * sinf(radians);
+    space->angle = angle;
+    space->rotationScale[0] = cosine;
+    space->rotationScale[1] = sine;
+    space->rotationScale[2] = -sine;
+    space->rotationScale[3] = cosine;
+    field.dirty = true;
 }
 
 /**
@@ -56,26 +154,31 @@ bool canCreateSpace(QCAR::Vec2F position) {
  */
 void createSpace(QCAR::Vec2F position) {
     LOGD("createSpace");
-    // nichts tun, wenn die maximale Anzahl der Felder bereits erreicht wurde
-    if (field.length == MAX_SPACE_COUNT) {
+    // nichts tun, wenn die maximale Anzahl der Felder bereits erreicht wurde oder für das Feld
+    // kein Speicher vorhanden ist
+    if (field.length == MAX_SPACE_COUNT || !reserveSpace()
+            || !insertIntoSpaceGrid(&field.grid, position.data[0], position.data[1])) {
         return;
     }
     // Feld initialisieren
-    Space* space = &field.spaces[field.length];
+    Space* space = getSpace(field.length);
+    SpaceChunk *spaceChunk = field.chunks[field.length >> SPACE_CHUNK_SHIFT];
+    spaceChunk->x[field.length & (SPACE_CHUNK_SIZE - 1)] = position.data[0];
+    spaceChunk->y[field.length & (SPACE_CHUNK_SIZE - 1)] = position.data[1];
     space->id = field.length;
     space->position = position;
-    space->angle = 0.f;
-    space->occupied = false;
+    setSpaceAngle(space, 0.f);
+    setSpaceOccupied(field.length, false);
     if (field.length == 0) {
         // wenn noch keine Felder da sind, ist das aktuelle Feld das Startfeld
-        space->type = START_SPACE;
+        setSpaceType(field.length, START_SPACE);
     } else if (field.length == 1) {
         // bei zwei Feldern ist das zweite Feld per Definition das Zielfeld
-        space->type = TARGET_SPACE;
+        setSpaceType(field.length, TARGET_SPACE);
         // Winkel vom ersten Feld in Richtung des zweiten Feldes berechnen, um das erste Feld in
         // diese Richtung drehen zu können
         float angle = 0.f;
-        QCAR::Vec2F d = vec2FSub(space->position, field.spaces[0].position);
+        QCAR::Vec2F d = vec2FSub(space->position, getSpace(0)->position);
         angle = atan2(d.data[1], d.data[0]);
         angle *= 180.f / M_PI;
         while (angle < -180.f) {
@@ -84,34 +187,165 @@ void createSpace(QCAR::Vec2F position) {
         while (angle > 180.f) {
             angle -= 360.f;
         }
-        field.spaces[0].angle = angle;
+        setSpaceAngle(getSpace(0), angle);
     } else {
         // das zuletzt erstellte Feld ist das Zielfeld
-        space->type = TARGET_SPACE;
+        setSpaceType(field.length, TARGET_SPACE);
         // das vorletzte erstellte Feld ist ein normales Feld
-        field.spaces[field.length - 1].type = SPACE;
+        setSpaceType(field.length - 1, SPACE);
     }
     field.length++;
+    field.dirty = true;
 }
 
 /**
- * Überprüft, ob sich an einer bestimmten Position bereits ein Feld befindet.
+ * Überprüft, ob sich an einer bestimmten Position bereits ein Feld befindet. Überlappen sich an
+ * der Position mehrere Felder, wird das nächstgelegene gewählt, bei gleichem Abstand das zuerst
+ * erstellte.
  *
  * @param position Position, die überprüft werden soll.
  * @return Das Feld, wenn eins gefunden wird, sonst NULL.
  */
 Space* selectSpace(QCAR::Vec2F position) {
-    Space* space = NULL;
-    // nur ausführen, wenn mindestens ein Feld vorhanden ist
-    if (field.length > 0) {
-        // über die Felder iterieren
-        for (int i = 0; i < field.length && space == NULL; ++i) {
-            // Distanz zur übergebenen Position berechnen und prüfen ob diese den Feldradius
-            // unterschreitet
-            if (vec2FDistance(position, field.spaces[i].position) <= SPACE_RADIUS) {
-                space = &field.spaces[i];
+    int32_t index = -1;
+    if (field.length > MAX_SPACE_SCAN_COUNT) {
+        // nur die Felder in den benachbarten Zellen des Gitters kommen in Frage
+        index = findNearestInSpaceGrid(&field.grid, position.data[0], position.data[1],
+                SPACE_RADIUS);
+    } else {
+        // bei kleinen Spielfeldern alle Felder blockweise prüfen, ein Feld im Abstand von genau
+        // SPACE_RADIUS zählt wie beim Gitter noch
+        float distanceSquared = nextafterf(SPACE_RADIUS * SPACE_RADIUS, INFINITY);
+        for (int start = 0; start < field.length; start += SPACE_CHUNK_SIZE) {
+            const SpaceChunk *spaceChunk = field.chunks[start >> SPACE_CHUNK_SHIFT];
+            int count = min(field.length - start, SPACE_CHUNK_SIZE);
+            // nur echt kleinere Abstände gewinnen, bei gleichem Abstand bleibt das frühere Feld
+            int32_t nearest = findNearestInSpaceArray(spaceChunk->x, spaceChunk->y, count,
+                    position.data[0], position.data[1], &distanceSquared);
+            if (nearest >= 0) {
+                index = start + nearest;
+            }
+        }
+    }
+    return index >= 0 ? getSpace(index) : NULL;
+}
+
+/**
+ * Merkt sich den Marker, auf dem das Spielfeld liegt. Gehört ein vorhandenes Spielfeld zu einem
+ * anderen Marker (z.B. ein gespeichertes Spielfeld), wird es verworfen, da die Positionen in den
+ * Koordinaten des Markers angegeben sind.
+ *
+ * @param markerName Name des aktuell erkannten Markers.
+ */
+void setFieldMarker(const char *markerName) {
+    if (strncmp(field.markerName, markerName, BOARD_FILE_MARKER_NAME_LENGTH - 1) == 0) {
+        return;
+    }
+    if (field.markerName[0] != '\0' && field.length > 0) {
+        LOGI("setFieldMarker: discarding field of marker %s", field.markerName);
+        clearField();
+    }
+    strncpy(field.markerName, markerName, BOARD_FILE_MARKER_NAME_LENGTH - 1);
+    field.markerName[BOARD_FILE_MARKER_NAME_LENGTH - 1] = '\0';
+}
+
+/**
+ * Speichert das Spielfeld in einer Datei (siehe boardFile.h).
+ *
+ * @param fileName Name der Datei.
+ * @return false, wenn das Spielfeld nicht gespeichert werden konnte.
+ */
+bool saveField(const char *fileName) {
+    // die Anzahl nur einmal lesen, damit Puffer, Kopie und Datei zusammenpassen
+    int spaceCount = field.length;
+    LOGD("saveField: %d spaces", spaceCount);
+    // Abschnitte aus den Blöcken zusammensetzen, ein Byte mehr, damit auch ein leeres Spielfeld
+    // Speicher erhält
+    float *x = (float*)malloc(spaceCount * (3 * sizeof(float) + sizeof(uint8_t)) + 1);
+    if (x == NULL) {
+        LOGE("saveField: could not allocate %d spaces", spaceCount);
+        return false;
+    }
+    float *y = x + spaceCount;
+    float *angles = y + spaceCount;
+    uint8_t *types = (uint8_t*)(angles + spaceCount);
+    for (int start = 0; start < spaceCount; start += SPACE_CHUNK_SIZE) {
+        const SpaceChunk *spaceChunk = field.chunks[start >> SPACE_CHUNK_SHIFT];
+        int count = min(spaceCount - start, SPACE_CHUNK_SIZE);
+        memcpy(x + start, spaceChunk->x, count * sizeof(float));
+        memcpy(y + start, spaceChunk->y, count * sizeof(float));
+        memcpy(types + start, spaceChunk->types, count);
+        for (int i = 0; i < count; ++i) {
+            angles[start + i] = spaceChunk->spaces[i].angle;
+        }
+    }
+    bool saved = writeBoardFile(fileName, field.markerName, spaceCount, x, y, angles, types);
+    free(x);
+    if (!saved) {
+        LOGE("saveField: could not write %s", fileName);
+    }
+    return saved;
+}
+
+/**
+ * Ersetzt das Spielfeld durch ein gespeichertes Spielfeld. Die Datei wird in den Speicher
+ * abgebildet und ihre Abschnitte blockweise in die Arrays der Blöcke kopiert, nur die Felder
+ * selbst und das Gitter werden pro Feld aufgebaut. Ist die Datei ungültig, bleibt das Spielfeld
+ * leer.
+ *
+ * @param fileName Name der Datei.
+ * @return true, wenn ein Spielfeld geladen wurde.
+ */
+bool loadField(const char *fileName) {
+    unsigned long startTime = getCurrentTimeInMs();
+    clearField();
+    MappedBoardFile board;
+    BoardFileStatus status = mapBoardFile(fileName, MAX_SPACE_COUNT, &board);
+    if (status == BOARD_FILE_MISSING) {
+        LOGD("loadField: no saved field");
+        return false;
+    } else if (status != BOARD_FILE_MAPPED) {
+        LOGE("loadField: could not load %s (status %d)", fileName, status);
+        return false;
+    }
+    bool loaded = true;
+    while (loaded && field.length < board.spaceCount) {
+        int start = field.length;
+        int count = min(board.spaceCount - start, SPACE_CHUNK_SIZE);
+        if (!reserveSpace()) {
+            loaded = false;
+            break;
+        }
+        SpaceChunk *spaceChunk = field.chunks[start >> SPACE_CHUNK_SHIFT];
+        memcpy(spaceChunk->x, board.x + start, count * sizeof(float));
+        memcpy(spaceChunk->y, board.y + start, count * sizeof(float));
+        memcpy(spaceChunk->types, board.types + start, count);
+        memset(spaceChunk->occupied, 0, sizeof(spaceChunk->occupied));
+        for (int i = 0; i < count; ++i) {
+            Space *space = &spaceChunk->spaces[i];
+            if (spaceChunk->types[i] >= SPACE_TYPE_COUNT || !insertIntoSpaceGrid(&field.grid,
+                    spaceChunk->x[i], spaceChunk->y[i])) {
+                loaded = false;
+                break;
             }
+            space->id = start + i;
+            space->type = (SpaceType)spaceChunk->types[i];
+            space->position.data[0] = spaceChunk->x[i];
+            space->position.data[1] = spaceChunk->y[i];
+            setSpaceAngle(space, board.angles[start + i]);
+            space->occupied = false;
         }
+        field.length = start + count;
+    }
+    if (loaded) {
+        strcpy(field.markerName, board.markerName);
+        LOGI("loadField: %d spaces of marker %s in %lu ms", field.length, field.markerName,
+                getCurrentTimeInMs() - startTime);
+    } else {
+        LOGE("loadField: could not restore %s", fileName);
+        clearField();
     }
-    return space;
+    unmapBoardFile(&board);
+    field.dirty = true;
+    return loaded;
 }
@@ -11,8 +11,54 @@
 #ifndef FIELD_H
 #define FIELD_H
 
+#include "types.h"
+
+/*
+ * Spielfeld (verwaltet in field.cpp).
+ */
+extern Field field;
+
+/**
+ * Gibt ein Feld des Spielfeldes zurück.
+ *
+ * @param index Index des Feldes, kleiner als field.length.
+ * @return Das Feld. Der Zeiger bleibt gültig, bis das Spielfeld geleert wird.
+ */
+inline Space* getSpace(int index) {
+    return &field.chunks[index >> SPACE_CHUNK_SHIFT]->spaces[index & (SPACE_CHUNK_SIZE - 1)];
+}
+
+/**
+ * Gibt den Typ eines Feldes zurück, ohne das Feld selbst zu lesen.
+ *
+ * @param index Index des Feldes, kleiner als field.length.
+ * @return Typ des Feldes.
+ */
+inline SpaceType getSpaceType(int index) {
+    return (SpaceType)field.chunks[index >> SPACE_CHUNK_SHIFT]->types[
+            index & (SPACE_CHUNK_SIZE - 1)];
+}
+
+/**
+ * Prüft, ob ein Feld durch eine Spielfigur besetzt ist, ohne das Feld selbst zu lesen.
+ *
+ * @param index Index des Feldes, kleiner als field.length.
+ * @return true, wenn das Feld besetzt ist.
+ */
+inline bool isSpaceOccupied(int index) {
+    return (field.chunks[index >> SPACE_CHUNK_SHIFT]->occupied[
+            (index & (SPACE_CHUNK_SIZE - 1)) >> 5] >> (index & 31) & 1) != 0;
+}
+
+void clearField();
+void releaseField();
+void setSpaceType(int, SpaceType);
+void setSpaceOccupied(int, bool);
 bool canCreateSpace(QCAR::Vec2F);
 void createSpace(QCAR::Vec2F);
 Space* selectSpace(QCAR::Vec2F);
+void setFieldMarker(const char*);
+bool saveField(const char*);
+bool loadField(const char*);
 
 #endif
@@ -10,9 +10,11 @@
  * @date 23.06.2011
  */
 
+#include <pthread.h>
 #include <stdlib.h>
 
 #include "constants.h"
+#include "field.h"
 #include "game.h"
 #include "invisibogaGlSurfaceView.h"
 #include "pawn.h"
@@ -37,10 +39,18 @@ int currentPlayerIndex;
  * Spieler, der an der Reihe ist.
  */
 Player *currentPlayer;
+/**
+ * Aufträge aus dem UI-Thread (GAME_REQUEST_*), die noch im GL-Thread ausgeführt werden müssen.
+ */
+static int pendingGameRequests = 0;
+/**
+ * Schützt pendingGameRequests.
+ */
+static pthread_mutex_t gameRequestMutex = PTHREAD_MUTEX_INITIALIZER;
 /*
- * Spielfeld (verwaltet in field.cpp).
+ * Name der Spielfeld-Datei (verwaltet in invisiboga.cpp).
  */
-extern Field field;
+extern char boardFileName[];
 
 /**
  * Initialisiert das Spiel.
@@ -74,6 +84,57 @@ void restartGame() {
     }
 }
 
+/**
+ * Beauftragt den GL-Thread mit einer Aktion. Spielfeld und Gitter werden nur im GL-Thread
+ * verändert, da sie dort ohne Sperre gelesen werden. Aktionen aus dem UI-Thread werden deshalb
+ * erst im nächsten Frame von processGameRequests() ausgeführt.
+ *
+ * @param request Auftrag (GAME_REQUEST_*).
+ */
+void requestGameAction(int request) {
+    pthread_mutex_lock(&gameRequestMutex);
+    pendingGameRequests |= request;
+    pthread_mutex_unlock(&gameRequestMutex);
+}
+
+/**
+ * Führt die Aufträge aus dem UI-Thread aus. Wird im GL-Thread aufgerufen.
+ */
+void processGameRequests() {
+    pthread_mutex_lock(&gameRequestMutex);
+    int requests = pendingGameRequests;
+    pendingGameRequests = 0;
+    pthread_mutex_unlock(&gameRequestMutex);
+    // ein vor dem Neustart fertiges Spielfeld zuerst speichern
+    if (requests & GAME_REQUEST_SAVE_FIELD) {
+        saveField(boardFileName);
+    }
+    if (requests & GAME_REQUEST_RESTART) {
+        // Felder entfernen und Spiel neustarten
+        clearField();
+        restartGame();
+    }
+}
+
+/**
+ * Zeigt die Buttons an, deren Anzahl von Feldern seit dem Erzeugen der letzten Felder erreicht
+ * wurde.
+ *
+ * @param previousSpaceCount Anzahl der Felder vor dem Erzeugen.
+ */
+void showButtonsForSpaceCount(int previousSpaceCount) {
+    // Weiter-Button beim Erreichen einer bestimmten Anzahl von Feldern anzeigen
+    if (previousSpaceCount < SPACE_COUNT_TO_SHOW_NEXT_BUTTON
+            && field.length >= SPACE_COUNT_TO_SHOW_NEXT_BUTTON) {
+        showView("nextButton");
+    }
+    // Neustart-Button beim Erreichen einer bestimmten Anzahl von Feldern anzeigen
+    if (previousSpaceCount < SPACE_COUNT_TO_SHOW_RESTART_BUTTON
+            && field.length >= SPACE_COUNT_TO_SHOW_RESTART_BUTTON) {
+        showView("restartButton");
+    }
+}
+
 /**
  * Setzt den aktuellen Spieler anhand des Spieler-Indexes.
  *
@@ -135,6 +196,8 @@ void updateGameState(int newGameState) {
                     "... darf er um ein paar Felder vorruecken oder muss ein paar Felder zurueck.");
             showToast(text, TOAST_DURATION_LONG);
             gameState = GAME_STATE_CREATING_FIELD;
+            // ein beim Start geladenes Spielfeld kann sofort fertig sein
+            showButtonsForSpaceCount(0);
             break;
         case GAME_STATE_CREATING_FIELD:
             // Spielfeld kann erzeugt werden
@@ -184,7 +247,7 @@ void processMove(float timeIntervalSinceLastFrame) {
             // Prüfung, ob der aktuelle Spieler senen Zug beeendet hat
             if (currentPlayer->state == PLAYER_STATE_POST_MOVING) {
                 // Prüfung, ob der Spieler auf einem Sonderfeld gelandet ist
-                if (field.spaces[currentPlayer->targetSpaceIndex].type == SPECIAL_SPACE) {
+                if (getSpaceType(currentPlayer->targetSpaceIndex) == SPECIAL_SPACE) {
                     // Spieler ist auf einem Sonderfeld gelandet. Es wird per Zufall bestimmt, ob er
                     // vor oder zurück darf und wie weit.
 
@@ -15,6 +15,9 @@
 
 void initGame();
 void restartGame();
+void requestGameAction(int);
+void processGameRequests();
+void showButtonsForSpaceCount(int);
 int getGameState();
 void updateGameState(int);
 void processMove(float);
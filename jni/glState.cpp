@@ -0,0 +1,438 @@
+/**
+ * @file glState.cpp
+ *
+ * @brief Beinhaltet einen Zwischenspeicher für den GL-Zustand, der redundante GL-Aufrufe verwirft.
+ *
+ * @details Jede Funktion vergleicht den gewünschten Zustand mit dem zuletzt gesetzten und ruft die
+ *      GL-Funktion nur auf, wenn er sich unterscheidet. Ausgeführte und verworfene Aufrufe werden
+ *      in der Render-Statistik gezählt.
+ *
+ *      Da QCAR den Video-Hintergrund im selben GL-Kontext rendert, ist der zwischengespeicherte
+ *      Zustand nach QCAR::Renderer::begin() nicht mehr verlässlich und muss mit invalidateGlState()
+ *      verworfen werden. Die Lichtparameter verwendet QCAR nicht, sie bleiben über Frames hinweg
+ *      gültig.
+ *
+ *      Die Funktionen für Shader-Programme und Vertex-Attribute dürfen nur mit einem Kontext von
+ *      OpenGL ES 2.0 verwendet werden, die für Client-Zustände, Array-Pointer und Lichtquellen nur
+ *      mit einem Kontext von OpenGL ES 1.1.
+ *
+ * @author Alexander Bertram
+ *
+ * @date 16.10.2026
+ */
+
+#include <string.h>
+
+#include <GLES/gl.h>
+#include <GLES/glext.h>
+#include <GLES2/gl2.h>
+
+#include "glState.h"
+#include "types.h"
+
+/*
+ * Render-Statistik (verwaltet in renderer.cpp).
+ */
+extern RenderStatistics renderStatistics;
+
+/**
+ * Zustand ist unbekannt.
+ */
+#define GL_STATE_UNKNOWN -1
+/**
+ * Zwischengespeicherte Fähigkeiten (glEnable/glDisable).
+ */
+static const GLenum CACHED_CAPABILITIES[] = { GL_BLEND, GL_DEPTH_TEST, GL_LIGHT0, GL_LIGHTING,
+    GL_RESCALE_NORMAL, GL_TEXTURE_2D };
+/**
+ * Anzahl der zwischengespeicherten Fähigkeiten.
+ */
+#define CACHED_CAPABILITY_COUNT (int)(sizeof(CACHED_CAPABILITIES) / sizeof(GLenum))
+/**
+ * Zwischengespeicherte Client-Zustände (glEnableClientState/glDisableClientState).
+ */
+static const GLenum CACHED_CLIENT_STATES[] = { GL_NORMAL_ARRAY, GL_TEXTURE_COORD_ARRAY,
+    GL_VERTEX_ARRAY };
+/**
+ * Anzahl der zwischengespeicherten Client-Zustände.
+ */
+#define CACHED_CLIENT_STATE_COUNT (int)(sizeof(CACHED_CLIENT_STATES) / sizeof(GLenum))
+/**
+ * Zwischengespeicherte Lichtparameter der ersten Lichtquelle (glLightfv). Die Position wird nicht
+ * zwischengespeichert, weil sie beim Setzen mit der aktuellen Model-View-Matrix transformiert wird.
+ */
+static const GLenum CACHED_LIGHT_PARAMETERS[] = { GL_AMBIENT, GL_DIFFUSE, GL_SPECULAR };
+/**
+ * Anzahl der zwischengespeicherten Lichtparameter.
+ */
+#define CACHED_LIGHT_PARAMETER_COUNT (int)(sizeof(CACHED_LIGHT_PARAMETERS) / sizeof(GLenum))
+/**
+ * Anzahl der zwischengespeicherten Vertex-Attribute.
+ */
+#define CACHED_VERTEX_ATTRIB_COUNT 4
+
+/**
+ * Zustände der Fähigkeiten (0, 1 oder GL_STATE_UNKNOWN).
+ */
+static int capabilityStates[CACHED_CAPABILITY_COUNT];
+/**
+ * Zustände der Client-Zustände (0, 1 oder GL_STATE_UNKNOWN).
+ */
+static int clientStates[CACHED_CLIENT_STATE_COUNT];
+/**
+ * An GL_ARRAY_BUFFER und GL_ELEMENT_ARRAY_BUFFER gebundene Buffer.
+ */
+static GLuint boundBuffers[2];
+/**
+ * Flags, die anzeigen, ob die gebundenen Buffer bekannt sind.
+ */
+static bool boundBuffersValid[2];
+/**
+ * An GL_TEXTURE_2D gebundene Textur.
+ */
+static GLuint boundTexture;
+/**
+ * Flag, das anzeigt, ob die gebundene Textur bekannt ist.
+ */
+static bool boundTextureValid;
+/**
+ * Blending-Funktion (Quell- und Ziel-Faktor).
+ */
+static GLenum blendFunction[2];
+/**
+ * Flag, das anzeigt, ob die Blending-Funktion bekannt ist.
+ */
+static bool blendFunctionValid;
+/**
+ * Vertex-, Normalen- und Textur-Koordinaten-Pointer.
+ */
+static GlArrayPointer vertexPointer, normalPointer, texCoordPointer;
+/**
+ * Lichtparameter der ersten Lichtquelle.
+ */
+static GLfloat lightParameters[CACHED_LIGHT_PARAMETER_COUNT][4];
+/**
+ * Flags, die anzeigen, ob die Lichtparameter bekannt sind.
+ */
+static bool lightParametersValid[CACHED_LIGHT_PARAMETER_COUNT];
+/**
+ * Verwendetes Shader-Programm.
+ */
+static GLuint program;
+/**
+ * Flag, das anzeigt, ob das verwendete Shader-Programm bekannt ist.
+ */
+static bool programValid;
+/**
+ * Zustände der Vertex-Attribut-Arrays (0, 1 oder GL_STATE_UNKNOWN).
+ */
+static int vertexAttribArrayStates[CACHED_VERTEX_ATTRIB_COUNT];
+/**
+ * Pointer der Vertex-Attribute.
+ */
+static GlArrayPointer vertexAttribPointers[CACHED_VERTEX_ATTRIB_COUNT];
+
+/**
+ * Sucht einen GL-Namen in einer Liste.
+ *
+ * @param names Die Liste.
+ * @param count Länge der Liste.
+ * @param name Der gesuchte Name.
+ * @return Index des Namens oder -1, wenn er nicht in der Liste enthalten ist.
+ */
+static int findName(const GLenum *names, int count, GLenum name) {
+    for (int i = 0; i < count; ++i) {
+        if (names[i] == name) {
+            return i;
+        }
+    }
+    return -1;
+}
+
+/**
+ * Vergleicht einen zwischengespeicherten Zustand mit dem gewünschten Zustand und zählt den Aufruf.
+ *
+ * @param redundant True, wenn der gewünschte Zustand bereits gesetzt ist.
+ * @return True, wenn der GL-Aufruf ausgeführt werden muss.
+ */
+static bool countCall(bool redundant) {
+    if (redundant) {
+        ++renderStatistics.suppressedStateChangeCount;
+        return false;
+    }
+    ++renderStatistics.stateChangeCount;
+    return true;
+}
+
+/**
+ * Verwirft den gesamten zwischengespeicherten Zustand. Muss nach jedem (Neu-)Erzeugen des
+ * GL-Kontextes aufgerufen werden.
+ */
+void resetGlState() {
+    invalidateGlState();
+    for (int i = 0; i < CACHED_LIGHT_PARAMETER_COUNT; ++i) {
+        lightParametersValid[i] = false;
+    }
+}
+
+/**
+ * Verwirft den zwischengespeicherten Zustand, den anderer Code (QCAR beim Rendern des
+ * Video-Hintergrundes) verändert haben kann.
+ */
+void invalidateGlState() {
+    for (int i = 0; i < CACHED_CAPABILITY_COUNT; ++i) {
+        capabilityStates[i] = GL_STATE_UNKNOWN;
+    }
+    for (int i = 0; i < CACHED_CLIENT_STATE_COUNT; ++i) {
+        clientStates[i] = GL_STATE_UNKNOWN;
+    }
+    boundBuffersValid[0] = boundBuffersValid[1] = false;
+    boundTextureValid = false;
+    blendFunctionValid = false;
+    vertexPointer.valid = normalPointer.valid = texCoordPointer.valid = false;
+    programValid = false;
+    for (int i = 0; i < CACHED_VERTEX_ATTRIB_COUNT; ++i) {
+        vertexAttribArrayStates[i] = GL_STATE_UNKNOWN;
+        vertexAttribPointers[i].valid = false;
+    }
+}
+
+/**
+ * Schaltet eine Fähigkeit ein oder aus (glEnable/glDisable).
+ *
+ * @param capability Die Fähigkeit.
+ * @param enabled True, wenn die Fähigkeit eingeschaltet werden soll.
+ */
+void setGlCapability(GLenum capability, bool enabled) {
+    int i = findName(CACHED_CAPABILITIES, CACHED_CAPABILITY_COUNT, capability);
+    if (!countCall(i >= 0 && capabilityStates[i] == enabled)) {
+        return;
+    }
+    if (i >= 0) {
+        capabilityStates[i] = enabled;
+    }
+    if (enabled) {
+        glEnable(capability);
+    } else {
+        glDisable(capability);
+    }
+}
+
+/**
+ * Schaltet ein Vertex-Array ein oder aus (glEnableClientState/glDisableClientState).
+ *
+ * @param array Das Vertex-Array.
+ * @param enabled True, wenn das Vertex-Array eingeschaltet werden soll.
+ */
+void setGlClientState(GLenum array, bool enabled) {
+    int i = findName(CACHED_CLIENT_STATES, CACHED_CLIENT_STATE_COUNT, array);
+    if (!countCall(i >= 0 && clientStates[i] == enabled)) {
+        return;
+    }
+    if (i >= 0) {
+        clientStates[i] = enabled;
+    }
+    if (enabled) {
+        glEnableClientState(array);
+    } else {
+        glDisableClientState(array);
+    }
+}
+
+/**
+ * Bindet einen Buffer (glBindBuffer).
+ *
+ * @param target GL_ARRAY_BUFFER oder GL_ELEMENT_ARRAY_BUFFER.
+ * @param buffer Der Buffer.
+ */
+void bindGlBuffer(GLenum target, GLuint buffer) {
+    int i = target == GL_ARRAY_BUFFER ? 0 : 1;
+    if (!countCall(boundBuffersValid[i] && boundBuffers[i] == buffer)) {
+        return;
+    }
+    boundBuffers[i] = buffer;
+    boundBuffersValid[i] = true;
+    glBindBuffer(target, buffer);
+}
+
+/**
+ * Bindet eine 2D-Textur (glBindTexture).
+ *
+ * @param texture Die Textur.
+ */
+void bindGlTexture(GLuint texture) {
+    if (!countCall(boundTextureValid && boundTexture == texture)) {
+        return;
+    }
+    boundTexture = texture;
+    boundTextureValid = true;
+    glBindTexture(GL_TEXTURE_2D, texture);
+}
+
+/**
+ * Setzt die Blending-Funktion (glBlendFunc).
+ *
+ * @param source Quell-Faktor.
+ * @param destination Ziel-Faktor.
+ */
+void setGlBlendFunction(GLenum source, GLenum destination) {
+    if (!countCall(blendFunctionValid && blendFunction[0] == source
+            && blendFunction[1] == destination)) {
+        return;
+    }
+    blendFunction[0] = source;
+    blendFunction[1] = destination;
+    blendFunctionValid = true;
+    glBlendFunc(source, destination);
+}
+
+/**
+ * Aktualisiert einen zwischengespeicherten Array-Pointer. Ein Array-Pointer bezieht sich immer auf
+ * den beim Setzen gebundenen GL_ARRAY_BUFFER.
+ *
+ * @param arrayPointer Der zwischengespeicherte Array-Pointer.
+ * @param size Anzahl der Komponenten pro Vertex.
+ * @param type Datentyp der Komponenten.
+ * @param normalized True, wenn Ganzzahl-Komponenten normalisiert werden.
+ * @param stride Abstand zwischen zwei Vertices in Bytes.
+ * @param pointer Offset im gebundenen Buffer.
+ * @return True, wenn der GL-Aufruf ausgeführt werden muss.
+ */
+static bool updateArrayPointer(GlArrayPointer *arrayPointer, GLint size, GLenum type,
+        GLboolean normalized, GLsizei stride, const GLvoid *pointer) {
+    GLuint buffer = boundBuffersValid[0] ? boundBuffers[0] : 0;
+    if (!countCall(arrayPointer->valid && boundBuffersValid[0] && arrayPointer->buffer == buffer
+            && arrayPointer->size == size && arrayPointer->type == type
+            && arrayPointer->normalized == normalized && arrayPointer->stride == stride
+            && arrayPointer->pointer == pointer)) {
+        return false;
+    }
+    arrayPointer->buffer = buffer;
+    arrayPointer->size = size;
+    arrayPointer->type = type;
+    arrayPointer->normalized = normalized;
+    arrayPointer->stride = stride;
+    arrayPointer->pointer = pointer;
+    arrayPointer->valid = boundBuffersValid[0];
+    return true;
+}
+
+/**
+ * Setzt den Vertex-Pointer (glVertexPointer).
+ *
+ * @param size Anzahl der Komponenten pro Vertex.
+ * @param type Datentyp der Komponenten.
+ * @param stride Abstand zwischen zwei Vertices in Bytes.
+ * @param pointer Offset im gebundenen Buffer.
+ */
+void setGlVertexPointer(GLint size, GLenum type, GLsizei stride, const GLvoid *pointer) {
+    if (updateArrayPointer(&vertexPointer, size, type, GL_FALSE, stride, pointer)) {
+        glVertexPointer(size, type, stride, pointer);
+    }
+}
+
+/**
+ * Setzt den Normalen-Pointer (glNormalPointer).
+ *
+ * @param type Datentyp der Komponenten.
+ * @param stride Abstand zwischen zwei Normalen in Bytes.
+ * @param pointer Offset im gebundenen Buffer.
+ */
+void setGlNormalPointer(GLenum type, GLsizei stride, const GLvoid *pointer) {
+    if (updateArrayPointer(&normalPointer, 3, type, GL_TRUE, stride, pointer)) {
+        glNormalPointer(type, stride, pointer);
+    }
+}
+
+/**
+ * Setzt den Textur-Koordinaten-Pointer (glTexCoordPointer).
+ *
+ * @param size Anzahl der Komponenten pro Textur-Koordinate.
+ * @param type Datentyp der Komponenten.
+ * @param stride Abstand zwischen zwei Textur-Koordinaten in Bytes.
+ * @param pointer Offset im gebundenen Buffer.
+ */
+void setGlTexCoordPointer(GLint size, GLenum type, GLsizei stride, const GLvoid *pointer) {
+    if (updateArrayPointer(&texCoordPointer, size, type, GL_FALSE, stride, pointer)) {
+        glTexCoordPointer(size, type, stride, pointer);
+    }
+}
+
+/**
+ * Setzt einen Parameter einer Lichtquelle (glLightfv). Zwischengespeichert werden nur die
+ * Farbkomponenten der ersten Lichtquelle.
+ *
+ * @param light Die Lichtquelle.
+ * @param parameter Der Parameter.
+ * @param values Die Werte (vier Komponenten).
+ */
+void setGlLight(GLenum light, GLenum parameter, const GLfloat *values) {
+    int i = light == GL_LIGHT0 ? findName(CACHED_LIGHT_PARAMETERS, CACHED_LIGHT_PARAMETER_COUNT,
+            parameter) : -1;
+    if (!countCall(i >= 0 && lightParametersValid[i]
+            && memcmp(lightParameters[i], values, sizeof(lightParameters[i])) == 0)) {
+        return;
+    }
+    if (i >= 0) {
+        memcpy(lightParameters[i], values, sizeof(lightParameters[i]));
+        lightParametersValid[i] = true;
+    }
+    glLightfv(light, parameter, values);
+}
+
+/**
+ * Verwendet ein Shader-Programm (glUseProgram).
+ *
+ * @param newProgram Das Shader-Programm.
+ */
+void useGlProgram(GLuint newProgram) {
+    if (!countCall(programValid && program == newProgram)) {
+        return;
+    }
+    program = newProgram;
+    programValid = true;
+    glUseProgram(newProgram);
+}
+
+/**
+ * Schaltet ein Vertex-Attribut-Array ein oder aus
+ * (glEnableVertexAttribArray/glDisableVertexAttribArray).
+ *
+ * @param index Index des Vertex-Attributes.
+ * @param enabled True, wenn das Vertex-Attribut-Array eingeschaltet werden soll.
+ */
+void setGlVertexAttribArray(GLuint index, bool enabled) {
+    bool cached = index < CACHED_VERTEX_ATTRIB_COUNT;
+    if (!countCall(cached && vertexAttribArrayStates[index] == enabled)) {
+        return;
+    }
+    if (cached) {
+        vertexAttribArrayStates[index] = enabled;
+    }
+    if (enabled) {
+        glEnableVertexAttribArray(index);
+    } else {
+        glDisableVertexAttribArray(index);
+    }
+}
+
+/**
+ * Setzt den Pointer eines Vertex-Attributes (glVertexAttribPointer).
+ *
+ * @param index Index des Vertex-Attributes.
+ * @param size Anzahl der Komponenten pro Vertex.
+ * @param type Datentyp der Komponenten.
+ * @param normalized True, wenn Ganzzahl-Komponenten normalisiert werden.
+ * @param stride Abstand zwischen zwei Vertices in Bytes.
+ * @param pointer Offset im gebundenen Buffer.
+ */
+void setGlVertexAttribPointer(GLuint index, GLint size, GLenum type, GLboolean normalized,
+        GLsizei stride, const GLvoid *pointer) {
+    if (index >= CACHED_VERTEX_ATTRIB_COUNT) {
+        countCall(false);
+        glVertexAttribPointer(index, size, type, normalized, stride, pointer);
+    } else if (updateArrayPointer(&vertexAttribPointers[index], size, type, normalized, stride,
+            pointer)) {
+        glVertexAttribPointer(index, size, type, normalized, stride, pointer);
+    }
+}
@@ -0,0 +1,31 @@
+/**
+ * @file glState.h
+ *
+ * @brief Schnittstelle zu glState.cpp.
+ *
+ * @author Alexander Bertram
+ *
+ * @date 16.10.2026
+ */
+
+#ifndef GL_STATE_H
+#define GL_STATE_H
+
+#include <GLES/gl.h>
+
+void resetGlState();
+void invalidateGlState();
+void setGlCapability(GLenum, bool);
+void setGlClientState(GLenum, bool);
+void bindGlBuffer(GLenum, GLuint);
+void bindGlTexture(GLuint);
+void setGlBlendFunction(GLenum, GLenum);
+void setGlVertexPointer(GLint, GLenum, GLsizei, const GLvoid*);
+void setGlNormalPointer(GLenum, GLsizei, const GLvoid*);
+void setGlTexCoordPointer(GLint, GLenum, GLsizei, const GLvoid*);
+void setGlLight(GLenum, GLenum, const GLfloat*);
+void useGlProgram(GLuint);
+void setGlVertexAttribArray(GLuint, bool);
+void setGlVertexAttribPointer(GLuint, GLint, GLenum, GLboolean, GLsizei, const GLvoid*);
+
+#endif
@@ -10,9 +10,12 @@
 
 #include <jni.h>
 #include <math.h>
+#include <pthread.h>
+#include <stdio.h>
 #include <stdlib.h>
 #include <time.h>
 
+#include <android/asset_manager_jni.h>
 #include <android/log.h>
 
 #include <GLES/gl.h>
@@ -27,13 +30,18 @@
 #include <QCAR/VideoBackgroundConfig.h>
 
 #include "constants.h"
+#include "dragPath.h"
 #include "field.h"
 #include "game.h"
 #include "invisibogaGlSurfaceView.h"
 #include "mathUtils.h"
+#include "mesh.h"
 #include "pawn.h"
+#include "renderer.h"
+#include "spaceKernels.h"
 #include "utils.h"
 #include "Texture.h"
+#include "textureLoader.h"
 #include "timeUtilities.h"
 #include "types.h"
 
@@ -71,17 +79,52 @@ extern "C" {
      */
     unsigned int screenHeight = 0;
     /**
-     * Anzahl der Texturen.
+     * Texturen. Ein Eintrag bleibt NULL, bis die Textur im Hintergrund geladen und in den
+     * Grafikspeicher hochgeladen wurde (siehe textureLoader.cpp).
      */
-    int textureCount = 0;
+    Texture *textures[TEXTURE_COUNT];
     /**
-     * Texturen.
+     * Bereiche der Feld-Texturen im Textur-Atlas.
      */
-    Texture **textures = NULL;
+    TextureAtlasRegion spaceTextureRegions[SPACE_TYPE_COUNT];
+    /**
+     * Referenz auf den Java-Asset-Manager. Hält den Asset-Manager am Leben, solange der native
+     * Asset-Manager verwendet wird.
+     */
+    static jobject assetManagerReference = NULL;
+    /**
+     * Asset-Manager, über den Dateien aus dem Android Package gelesen werden.
+     */
+    AAssetManager *assetManager = NULL;
+    /**
+     * Name der Datei im Speicher der App, in der das Spielfeld gespeichert wird.
+     */
+    char boardFileName[FILENAME_MAX];
+    /**
+     * Model der Spielfigur.
+     */
+    Mesh pawnMesh;
+    /**
+     * Zeitpunkt, zu dem die native Initialisierung begonnen hat.
+     */
+    unsigned long applicationStartTime;
     /**
      * Touch-Ereignis.
      */
     TouchEvent touchEvent;
+    /**
+     * Schützt die Positionen im Touch-Ereignis, die im UI-Thread gesammelt und im Render-Thread
+     * verarbeitet werden.
+     */
+    static pthread_mutex_t touchEventMutex = PTHREAD_MUTEX_INITIALIZER;
+    /**
+     * Zieh-Pfad der aktuellen Druck-Geste in Koordinaten des Trackables.
+     */
+    static DragPath dragPath;
+    /**
+     * Startzeit der Druck-Geste, zu der dragPath gehört.
+     */
+    static unsigned long dragPathStartTime;
     /*
      * Flag zur Prüfung, ob ein Trackable sichtbar ist (verwaltet in invisibogaGlSurfaceView.cpp).
      */
@@ -90,10 +133,6 @@ extern "C" {
      * Spieler (verwaltet in game.cpp).
      */
     extern Player players[];
-    /*
-     * Spielfeld (verwaltet in field.cpp).
-     */
-    extern Field field;
     /*
      * Aktueller Spiel-Zustand, verwaltet in game.cpp.
      */
@@ -108,8 +147,14 @@ extern "C" {
     JNIEXPORT void JNICALL Java_de_fhwedel_vr2_invisiboga_Invisiboga_onQCARInitializedNative(
             JNIEnv*, jobject) {
         LOG("Java_de_fhwedel_vr2_invisiboga_Invisiboga_onQCARInitializedNative");
-        // Spielfeld-Länge initialisieren
-        field.length = 0;
+        // schnellste Umsetzung der Abstandsabfragen wählen (in Debug-Builds gegen die skalare
+        // geprüft)
+        if (!initSpaceKernels()) {
+            LOGE("space kernels differ from the scalar kernels, using scalar");
+        }
+        LOGI("space kernels: %s", getSpaceKernelName());
+        // Spielfeld initialisieren, ein beim letzten Mal erstelltes Spielfeld wiederherstellen
+        loadField(boardFileName);
         // Zeitpunkt des letzten Frames initialisieren
         lastFrameTime = getCurrentTimeInMs();
         // Spiel initialsieren
@@ -119,11 +164,62 @@ extern "C" {
     }
 
     /**
-     * Verarbeitet das Touch-Event.
+     * Erzeugt Felder entlang des Zieh-Pfades. Alle Bildschirm-Positionen seit dem letzten Frame
+     * werden gemeinsam auf die Ebene des Trackables projeziert und an den Pfad angehängt. An jedem
+     * dabei überschrittenen Abtastpunkt wird, wenn möglich, ein Feld erzeugt.
+     *
+     * @param event Kopie des Touch-Ereignisses mit den Positionen seit dem letzten Frame.
+     */
+    static void extendFieldAlongDrag(TouchEvent *event) {
+        // eine neue Druck-Geste beginnt einen neuen Pfad
+        if (event->startTime != dragPathStartTime) {
+            dragPathStartTime = event->startTime;
+            resetDragPath(&dragPath);
+        }
+        if (event->pointCount == 0) {
+            return;
+        }
+        // Projektion aller Positionen auf die Ebene des getrackten Objektes
+        ScreenPlaneProjection projection;
+        initScreenPlaneProjection(screenWidth, screenHeight, inverseProjectionMatrix,
+                modelViewMatrix, &projection);
+        int pointCount = projectScreenPointsToPlane(&projection, event->points,
+                event->pointCount, event->points);
+        // Abtastpunkte knapp über dem doppelten Feldradius, so dass sich die Felder berühren
+        QCAR::Vec2F samples[MAX_DRAG_SAMPLE_COUNT];
+        int sampleCount = extendDragPath(&dragPath, event->points, pointCount,
+                DRAG_SAMPLE_SPACING, samples, MAX_DRAG_SAMPLE_COUNT);
+        int previousSpaceCount = field.length;
+        for (int i = 0; i < sampleCount; ++i) {
+            // Prüfung, ob am Abtastpunkt ein Feld erzeugt werden kann
+            if (canCreateSpace(samples[i])) {
+                createSpace(samples[i]);
+            }
+        }
+        showButtonsForSpaceCount(previousSpaceCount);
+    }
+
+    /**
+     * Verarbeitet das Touch-Event. Das Ereignis wird einmal unter touchEventMutex kopiert, damit
+     * alle Entscheidungen in diesem Frame auf derselben Geste beruhen.
      */
     void handleTouchEvent() {
+        TouchEvent event;
+        pthread_mutex_lock(&touchEventMutex);
+        event = touchEvent;
         // Prüfung, ob ein Tipp auf den Touchscreen erkannt und dieser noch nicht verarbeitet wurde
-        if (touchEvent.isTap && touchEvent.startTime > lastTapTime) {
+        bool tap = event.isTap && event.startTime > lastTapTime;
+        // Touch-Ereignis ignorieren, wenn daraus noch ein Tipp werden könnte, die Positionen
+        // bleiben bis dahin gesammelt
+        bool drag = !tap && (event.isActive || event.pointCount > 0)
+                && (event.lifeTime > MAX_TAP_TIME
+                        || event.startPositionLastPositionDistance > MAX_TAP_SQUARED_DISTANCE);
+        // die kopierten Positionen werden in diesem Frame verbraucht
+        if (drag) {
+            touchEvent.pointCount = 0;
+        }
+        pthread_mutex_unlock(&touchEventMutex);
+        if (tap) {
             // Es wurde auf den Touchscreen getippt. Es wird versucht, an der Stelle ein Feld zu
             // erzeugen.
 
@@ -131,7 +227,7 @@ extern "C" {
             // Projektion der Koordinaten, auf die getippt wurde, auf die Ebene des getrackten
             // Objektes
             projectScreenPointToPlane(screenWidth, screenHeight,
-                    QCAR::Vec2F(touchEvent.tapPosition.data[0], touchEvent.tapPosition.data[1]),
+                    QCAR::Vec2F(event.tapPosition.data[0], event.tapPosition.data[1]),
                     inverseProjectionMatrix, modelViewMatrix, QCAR::Vec3F(0, 0, 0),
                     QCAR::Vec3F(0, 0, 1), intersection);
             // Prüfung, ob sich an den projezierten Koordinaten bereits ein Feld befindet
@@ -141,57 +237,25 @@ extern "C" {
 
                 // normales Feld in Sonderfeld umwandeln und umgekehrt
                 if (space->type == SPACE) {
-                    space->type = SPECIAL_SPACE;
+                    setSpaceType(space->id, SPECIAL_SPACE);
                 } else if (space->type == SPECIAL_SPACE) {
-                    space->type = SPACE;
+                    setSpaceType(space->id, SPACE);
                 }
             } else if (canCreateSpace(QCAR::Vec2F(intersection.data[0], intersection.data[1]))) {
                 // kein Feld gefunden, es kann ein neues erstellt werden
 
                 // Feld erzeugen
+                int previousSpaceCount = field.length;
                 createSpace(QCAR::Vec2F(intersection.data[0], intersection.data[1]));
-                // Weiter-Button beim Erreichen einer bestimmten Anzahl von Feldern anzeigen
-                if (field.length == SPACE_COUNT_TO_SHOW_NEXT_BUTTON) {
-                    showView("nextButton");
-                }
-                // Neustart-Button beim Erreichen einer bestimmten Anzahl von Feldern anzeigen
-                if (field.length == SPACE_COUNT_TO_SHOW_RESTART_BUTTON) {
-                    showView("restartButton");
-                }
+                showButtonsForSpaceCount(previousSpaceCount);
             }
             // Zeit des Verarbeitung manipulieren, damit dieser Tipp nicht mehr verarbeitet wird
-            lastTapTime = touchEvent.startTime;
-        } else if (touchEvent.isActive) {
-            // Der User hat den Finger immer noch auf dem Touchscreen. Wenn der Finger über den
-            // Bildschrim gezogen wird, dann wird versucht auf diesem Zieh-Pfad nacheinander Felder
-            // zu erzeugen.
-
-            // Touch-Ereignis ignorieren, wenn daraus noch ein Tipp werden könnte
-            if (touchEvent.lifeTime > MAX_TAP_TIME
-                    || touchEvent.startPositionLastPositionDistance > MAX_TAP_SQUARED_DISTANCE) {
-                QCAR::Vec3F intersection;
-                // Projektion der Koordinaten, auf denen sich der Finger befindet, auf die Ebene des
-                // getrackten Objektes
-                projectScreenPointToPlane(
-                        screenWidth,
-                        screenHeight,
-                        QCAR::Vec2F(touchEvent.currentPosition.data[0],
-                                touchEvent.currentPosition.data[1]), inverseProjectionMatrix,
-                        modelViewMatrix, QCAR::Vec3F(0, 0, 0), QCAR::Vec3F(0, 0, 1), intersection);
-                // Prüfung, ob an den projezierten Koordinaten ein Feld erzeugt werden kann
-                if (canCreateSpace(QCAR::Vec2F(intersection.data[0], intersection.data[1]))) {
-                    // Feld erzeugen
-                    createSpace(QCAR::Vec2F(intersection.data[0], intersection.data[1]));
-                    // Weiter-Button beim Erreichen einer bestimmten Anzahl von Feldern anzeigen
-                    if (field.length == SPACE_COUNT_TO_SHOW_NEXT_BUTTON) {
-                        showView("nextButton");
-                    }
-                    // Neustart-Button beim Erreichen einer bestimmten Anzahl von Feldern anzeigen
-                    if (field.length == SPACE_COUNT_TO_SHOW_RESTART_BUTTON) {
-                        showView("restartButton");
-                    }
-                }
-            }
+            lastTapTime = event.startTime;
+        } else if (drag) {
+            // Der User hat den Finger immer noch auf dem Touchscreen oder hat ihn seit dem letzten
+            // Frame abgehoben und ihn dabei über den Bildschrim gezogen. Entlang des Zieh-Pfades
+            // werden lückenlos Felder erzeugt.
+            extendFieldAlongDrag(&event);
         }
     }
 
@@ -208,6 +272,7 @@ extern "C" {
             jobject, jint actionType, jfloat x, jfloat y) {
         // Touch-Ereignisse nur behandeln, wenn ein Trackable sichtbar ist
         if (trackableVisible) {
+            pthread_mutex_lock(&touchEventMutex);
             // Prüfung, ob das Ereignis den Start einer Druck-Geste ist
             if (actionType == ACTION_DOWN) {
                 // Start-Parameter speichern
@@ -217,6 +282,7 @@ extern "C" {
                 touchEvent.startPosition.data[1] = y;
                 touchEvent.startTime = getCurrentTimeInMs();
                 touchEvent.isTap = false;
+                touchEvent.pointCount = 0;
             } else {
                 // letzte Position speichern
                 touchEvent.lastPosition = touchEvent.currentPosition;
@@ -243,6 +309,12 @@ extern "C" {
             touchEvent.actionType = (ActionType)actionType;
             touchEvent.currentPosition.data[0] = x;
             touchEvent.currentPosition.data[1] = y;
+            // Position für den Zieh-Pfad sammeln, bei vollem Puffer die letzte ersetzen
+            if (touchEvent.pointCount == MAX_TOUCH_POINT_COUNT) {
+                touchEvent.pointCount--;
+            }
+            touchEvent.points[touchEvent.pointCount++] = touchEvent.currentPosition;
+            pthread_mutex_unlock(&touchEventMutex);
         }
     }
 
@@ -252,21 +324,52 @@ extern "C" {
      * @param env Die JNI-Umgebung.
      * @param obj Das aufrufende Objekt.
      */
-    JNIEXPORT void JNICALL Java_de_fhwedel_vr2_invisiboga_Invisiboga_deinitNative(JNIEnv *,
+    JNIEXPORT void JNICALL Java_de_fhwedel_vr2_invisiboga_Invisiboga_deinitNative(JNIEnv *env,
             jobject) {
         LOGD("Java_de_fhwedel_vr2_invisiboga_Invisiboga_deinitNative");
-        // Texturen löschen und freigeben
-        if (textures != NULL) {
-            for (int i = 0; i < textureCount; i++) {
-                delete textures[i];
-                textures[i] = NULL;
-            }
-            delete[] textures;
-            textures = NULL;
-            textureCount = 0;
+        // auf den Lade-Thread warten, danach Texturen löschen und freigeben
+        stopTextureLoader();
+        for (int i = 0; i < TEXTURE_COUNT; i++) {
+            delete textures[i];
+            textures[i] = NULL;
+        }
+        // Model der Spielfigur freigeben
+        freeMesh(&pawnMesh);
+        // Blöcke des Spielfeldes und Render-Daten freigeben
+        releaseField();
+        releaseFieldRenderData();
+        // Asset-Manager freigeben
+        if (assetManagerReference != NULL) {
+            env->DeleteGlobalRef(assetManagerReference);
+            assetManagerReference = NULL;
+            assetManager = NULL;
         }
     }
 
+    /**
+     * Startet das Laden der Texturen im Hintergrund. Wird als erstes aufgerufen, damit die
+     * Texturen geladen werden, während das QCAR-Framework initialisiert wird.
+     *
+     * @param env Die JNI-Umgebung.
+     * @param obj Das aufrufende Objekt.
+     * @param javaAssetManager Asset-Manager des Android Packages.
+     * @param filesDirectory Verzeichnis für die Dateien der App.
+     */
+    JNIEXPORT void JNICALL Java_de_fhwedel_vr2_invisiboga_Invisiboga_startLoadingNative(
+            JNIEnv* env, jobject, jobject javaAssetManager, jstring filesDirectory) {
+        LOG("Java_de_fhwedel_vr2_invisiboga_Invisiboga_startLoadingNative");
+        applicationStartTime = getCurrentTimeInMs();
+        // Namen der Spielfeld-Datei bilden
+        const char *directory = env->GetStringUTFChars(filesDirectory, NULL);
+        snprintf(boardFileName, sizeof(boardFileName), "%s/%s", directory, BOARD_FILE_NAME);
+        env->ReleaseStringUTFChars(filesDirectory, directory);
+        // Asset-Manager speichern
+        assetManagerReference = env->NewGlobalRef(javaAssetManager);
+        assetManager = AAssetManager_fromJava(env, assetManagerReference);
+        // Texturen im Hintergrund laden
+        startTextureLoader(assetManager);
+    }
+
     /**
      * Initialisiert die Anwendung.
      *
@@ -276,40 +379,13 @@ extern "C" {
      * @param height Bildschrim-Höhe.
      */
     JNIEXPORT void JNICALL Java_de_fhwedel_vr2_invisiboga_Invisiboga_initApplicationNative(
-            JNIEnv* env, jobject obj, jint width, jint height) {
+            JNIEnv*, jobject, jint width, jint height) {
         LOG("Java_de_fhwedel_vr2_invisiboga_Invisiboga_initApplicationNative");
         // Display-Größe speichern
         screenWidth = width;
         screenHeight = height;
-        // Anzahl der Texturen ermitteln
-        jclass activityClass = env->GetObjectClass(obj);
-        jmethodID getTextureCountMethodID = env->GetMethodID(activityClass, "getTextureCount",
-                "()I");
-        if (getTextureCountMethodID == NULL) {
-            LOGE("Function getTextureCount() not found.");
-            return;
-        }
-        textureCount = env->CallIntMethod(obj, getTextureCountMethodID);
-        if (!textureCount) {
-            LOGE("getTextureCount() returned zero.");
-            return;
-        }
-        // Texturen erzeugen
-        textures = new Texture*[textureCount];
-        jmethodID getTextureMethodId = env->GetMethodID(activityClass, "getTexture",
-                "(I)Lde/fhwedel/vr2/invisiboga/Texture;");
-        if (getTextureMethodId == 0) {
-            LOGE("Function getTexture() not found.");
-            return;
-        }
-        for (int i = 0; i < textureCount; ++i) {
-            jobject textureObject = env->CallObjectMethod(obj, getTextureMethodId, i);
-            if (textureObject == NULL) {
-                LOG("getTexture() returned zero pointer");
-                return;
-            }
-            textures[i] = Texture::create(env, textureObject);
-        }
+        // Model der Spielfigur erzeugen
+        initPawnMesh(assetManager, &pawnMesh);
     }
 
     /**
@@ -371,6 +447,14 @@ extern "C" {
      */
     JNIEXPORT void JNICALL Java_de_fhwedel_vr2_invisiboga_Invisiboga_stopCamera(JNIEnv*, jobject) {
         LOG("Java_de_fhwedel_vr2_invisiboga_Invisiboga_stopCamera");
+        // der GL-Thread ist bereits angehalten, offene Aufträge (z.B. das Speichern nach
+        // "Weiter") hier ausführen
+        processGameRequests();
+        // ein Spielfeld, das gerade erstellt wird, sichern, da die App im Hintergrund beendet
+        // werden kann
+        if (gameState == GAME_STATE_CREATING_FIELD) {
+            saveField(boardFileName);
+        }
         QCAR::CameraDevice::getInstance().stop();
         QCAR::CameraDevice::getInstance().deinit();
     }
@@ -16,10 +16,13 @@
 #include <QCAR/Tool.h>
 #include <QCAR/Trackable.h>
 
+#include "constants.h"
+#include "field.h"
 #include "game.h"
 #include "invisiboga.h"
 #include "renderer.h"
 #include "Texture.h"
+#include "textureLoader.h"
 #include "timeUtilities.h"
 #include "types.h"
 #include "utils.h"
@@ -67,13 +70,21 @@ extern "C" {
      */
     extern unsigned int screenWidth;
     /*
-     * Anzahl der Texturen (verwaltet in invisiboga.cpp).
+     * Texturen (verwaltet in invisiboga.cpp).
      */
-    extern int textureCount;
+    extern Texture *textures[];
     /*
-     * Texturen (verwaltet in invisiboga.cpp).
+     * Zeitpunkt, zu dem die native Initialisierung begonnen hat (verwaltet in invisiboga.cpp).
+     */
+    extern unsigned long applicationStartTime;
+    /**
+     * Flag, das anzeigt, ob der erste Frame bereits gerendert wurde.
      */
-    extern Texture **textures;
+    static bool firstFrameRendered = false;
+    /**
+     * Flag, das anzeigt, ob der erste Frame mit allen Texturen bereits gerendert wurde.
+     */
+    static bool firstTexturedFrameRendered = false;
 
     /**
      * Führt Initialiserungen durch.
@@ -103,6 +114,10 @@ extern "C" {
             JNIEnv*, jobject) {
         // Zeitintervall seit letztem Frame in Sekunden
         float timeIntervalSinceLastFrame = (getCurrentTimeInMs() - lastFrameTime) / 1000.0f;
+        // im Hintergrund fertig geladene Texturen hochladen
+        uploadLoadedTextures();
+        // Aufträge aus dem UI-Thread ausführen, bevor das Spielfeld gelesen wird
+        processGameRequests();
         // GL-Buffer leeren
         glClear(GL_COLOR_BUFFER_BIT | GL_DEPTH_BUFFER_BIT);
         // rendern starten
@@ -111,14 +126,20 @@ extern "C" {
         trackableVisible = state.getNumActiveTrackables() > 0;
         // Prüfung, ob Trackable sichtbar ist
         if (trackableVisible) {
+            // das erste Trackable auslesen
+            const QCAR::Trackable *trackable = state.getActiveTrackable(0);
+            // das Spielfeld gehört zu dem Marker, auf dem es erstellt wird, ein gespeichertes
+            // Spielfeld eines anderen Markers wird dabei verworfen
+            if (gameState == GAME_STATE_WAITING_FOR_MARKER
+                    || gameState == GAME_STATE_CREATING_FIELD) {
+                setFieldMarker(trackable->getName());
+            }
             // Wenn der aktuelle Spiel-Zustand, der Zustand ist, in dem auf das Trackable gewartet
             // wird, Spiel-Zustand updaten und Hinweis anzeigen lassen, wie das Spielfeld erzeugt
             // werden kann.
             if (gameState == GAME_STATE_WAITING_FOR_MARKER) {
                 updateGameState(GAME_STATE_SHOW_HINT_CREATE_SPACES);
             }
-            // das erste Trackable auslesen
-            const QCAR::Trackable *trackable = state.getActiveTrackable(0);
             // Model-View-Matrix berechnen
             modelViewMatrix = QCAR::Tool::convertPose2GLMatrix(trackable->getPose());
             // Prüfung, ob im aktuellen Spiel-Zustand das Spielfeld erzeugt wird
@@ -135,6 +156,22 @@ extern "C" {
         QCAR::Renderer::getInstance().end();
         // Zeit des Aufrufs speichern
         lastFrameTime = getCurrentTimeInMs();
+        // Zeit bis zum ersten Frame und bis zum ersten Frame mit allen Texturen ausgeben
+        if (!firstFrameRendered) {
+            firstFrameRendered = true;
+            LOG("renderFrame: first frame after %lu ms", lastFrameTime - applicationStartTime);
+        }
+        if (!firstTexturedFrameRendered) {
+            bool texturesReady = true;
+            for (int i = 0; i < TEXTURE_COUNT; ++i) {
+                texturesReady = texturesReady && textures[i] != NULL;
+            }
+            if (texturesReady) {
+                firstTexturedFrameRendered = true;
+                LOG("renderFrame: first textured frame after %lu ms",
+                        lastFrameTime - applicationStartTime);
+            }
+        }
     }
 
     /*
@@ -270,15 +307,13 @@ extern "C" {
             JNIEnv* env, jobject obj) {
         LOG("Java_de_fhwedel_vr2_invisiboga_InvisibogaGlSurfaceView_initRendering");
         glClearColor(0.0f, 0.0f, 0.0f, QCAR::requiresAlpha() ? 0.0f : 1.0f);
-        // OpenGL-Texturen erzeugen und Parameter setzen
-        for (int i = 0; i < textureCount; ++i) {
-            glGenTextures(1, &(textures[i]->mTextureID));
-            glBindTexture(GL_TEXTURE_2D, textures[i]->mTextureID);
-            glTexParameterf(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, GL_LINEAR);
-            glTexParameterf(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, GL_LINEAR);
-            glTexImage2D(GL_TEXTURE_2D, 0, GL_RGBA, textures[i]->mWidth, textures[i]->mHeight, 0,
-                    GL_RGBA, GL_UNSIGNED_BYTE, (GLvoid*)textures[i]->mData);
-        }
+        // statische Geometrie in den Grafikspeicher laden und Render-Pipeline wählen
+        initRenderer();
+        // bereits hochgeladene Texturen sind mit dem alten GL-Kontext verloren gegangen und werden
+        // im Hintergrund neu geladen
+        reloadTextures();
+        // inzwischen im Hintergrund fertig geladene Texturen hochladen
+        uploadLoadedTextures();
     }
 
     /**
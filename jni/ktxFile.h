@@ -0,0 +1,122 @@
+/**
+ * @file ktxFile.h
+ *
+ * @brief Beschreibt die verwendete Teilmenge des Khronos-Texturformats KTX (Version 1.1).
+ *
+ * @details Die Dateien werden von tools/textureBuilder.cpp geschrieben und zur Laufzeit direkt aus
+ *      dem Android Package in den Speicher abgebildet. Alle Werte liegen in
+ *      Little-Endian-Byte-Reihenfolge vor. Auf den Header folgen ohne Lücken:
+ *
+ *      - bytesOfKeyValueData Byte Schlüssel-Wert-Paare (jeweils Länge als uint32_t, Schlüssel
+ *        mit abschließender Null, Wert, aufgefüllt auf 4 Byte),
+ *      - numberOfMipmapLevels Mipmap-Stufen (jeweils Größe als uint32_t und Daten), beginnend
+ *        mit der größten Stufe.
+ *
+ *      Es werden nur zweidimensionale ETC1-Texturen ohne Array-Elemente und mit einer Seite
+ *      verwendet. Da ETC1-Daten immer aus 8-Byte-Blöcken bestehen, ist zwischen den Stufen keine
+ *      Auffüllung nötig.
+ *
+ * @author Alexander Bertram
+ *
+ * @date 16.10.2026
+ */
+
+#ifndef KTX_FILE_H
+#define KTX_FILE_H
+
+#include <stdint.h>
+
+/**
+ * Länge der Kennung am Anfang jeder KTX-Datei.
+ */
+#define KTX_FILE_IDENTIFIER_LENGTH 12
+/**
+ * Kennung am Anfang jeder KTX-Datei.
+ */
+static const uint8_t KTX_FILE_IDENTIFIER[KTX_FILE_IDENTIFIER_LENGTH] = { 0xAB, 'K', 'T', 'X', ' ',
+        '1', '1', 0xBB, '\r', '\n', 0x1A, '\n' };
+/**
+ * Wert des Feldes endianness, wenn die Datei in der Byte-Reihenfolge des Lesers vorliegt.
+ */
+#define KTX_FILE_ENDIANNESS 0x04030201
+/**
+ * Internes Format von ETC1-Texturen (GL_ETC1_RGB8_OES).
+ */
+#define KTX_ETC1_RGB8 0x8D64
+/**
+ * Basisformat von ETC1-Texturen (GL_RGB).
+ */
+#define KTX_RGB 0x1907
+/**
+ * Maximale Anzahl der Mipmap-Stufen (Kantenlänge bis 2^15).
+ */
+#define KTX_MAX_MIPMAP_LEVEL_COUNT 16
+/**
+ * Schlüssel, unter dem die Bereiche der Kacheln eines Textur-Atlas abgelegt sind. Der Wert besteht
+ * aus vier float-Werten pro Kachel (offset und scale wie in TextureAtlasRegion).
+ */
+#define KTX_ATLAS_REGIONS_KEY "InvisibogaAtlasRegions"
+
+/**
+ * @brief Header einer KTX-Datei.
+ */
+typedef struct KtxFileHeader {
+    /**
+     * Kennung der Datei (KTX_FILE_IDENTIFIER).
+     */
+    uint8_t identifier[KTX_FILE_IDENTIFIER_LENGTH];
+    /**
+     * Byte-Reihenfolge (KTX_FILE_ENDIANNESS).
+     */
+    uint32_t endianness;
+    /**
+     * Datentyp der Pixel, 0 bei komprimierten Texturen.
+     */
+    uint32_t glType;
+    /**
+     * Größe des Datentyps in Byte, 1 bei komprimierten Texturen.
+     */
+    uint32_t glTypeSize;
+    /**
+     * Pixel-Format, 0 bei komprimierten Texturen.
+     */
+    uint32_t glFormat;
+    /**
+     * Internes Format (KTX_ETC1_RGB8).
+     */
+    uint32_t glInternalFormat;
+    /**
+     * Basisformat (KTX_RGB).
+     */
+    uint32_t glBaseInternalFormat;
+    /**
+     * Breite der größten Stufe in Pixeln.
+     */
+    uint32_t pixelWidth;
+    /**
+     * Höhe der größten Stufe in Pixeln.
+     */
+    uint32_t pixelHeight;
+    /**
+     * Tiefe in Pixeln, 0 bei zweidimensionalen Texturen.
+     */
+    uint32_t pixelDepth;
+    /**
+     * Anzahl der Array-Elemente, 0 ohne Array.
+     */
+    uint32_t numberOfArrayElements;
+    /**
+     * Anzahl der Seiten, 1 ohne Cube-Map.
+     */
+    uint32_t numberOfFaces;
+    /**
+     * Anzahl der Mipmap-Stufen.
+     */
+    uint32_t numberOfMipmapLevels;
+    /**
+     * Größe der Schlüssel-Wert-Paare in Byte.
+     */
+    uint32_t bytesOfKeyValueData;
+} KtxFileHeader;
+
+#endif
@@ -0,0 +1,326 @@
+/**
+ * @file ktxTexture.cpp
+ *
+ * @brief Beinhaltet Funktionen zum Laden ETC1-komprimierter Texturen aus KTX-Dateien (siehe
+ *      ktxFile.h) im Android Package.
+ *
+ * @details Da ETC1 keinen Alpha-Kanal kennt, besteht eine Textur aus zwei KTX-Dateien: einer
+ *      Farb-Ebene und einer Alpha-Ebene, deren Alpha-Werte in allen drei Farbkanälen liegen. Beide
+ *      werden von tools/textureBuilder.cpp samt Mipmap-Kette erzeugt.
+ *
+ *      Mit OpenGL ES 2.0 und der Erweiterung GL_OES_compressed_ETC1_RGB8_texture werden beide
+ *      Ebenen komprimiert in den Grafikspeicher geladen und im Fragment-Shader zusammengesetzt
+ *      (siehe shaderRenderer.cpp). Ohne Shader lässt sich der Alpha-Wert nicht aus einer zweiten
+ *      Textur lesen; dann werden die Ebenen auf der CPU dekodiert und als RGBA4444 geladen, was
+ *      immer noch halb so viel Grafikspeicher wie RGBA8888 belegt.
+ *
+ * @author Alexander Bertram
+ *
+ * @date 16.10.2026
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include <android/asset_manager.h>
+
+#include <GLES/gl.h>
+#include <GLES/glext.h>
+
+#include "etc1.h"
+#include "ktxTexture.h"
+#include "renderer.h"
+#include "timeUtilities.h"
+#include "types.h"
+#include "utils.h"
+
+/**
+ * Prüft, ob die Daten einer KTX-Datei eine gültige ETC1-Textur enthalten, und setzt die Zeiger der
+ * Textur auf die einzelnen Abschnitte.
+ *
+ * @param data Daten der KTX-Datei.
+ * @param size Größe der Daten in Byte.
+ * @param image Die Textur, deren Zeiger gesetzt werden.
+ * @return true, wenn die Daten gültig sind, sonst false.
+ */
+static bool mapKtxImage(const uint8_t *data, size_t size, KtxImage *image) {
+    const KtxFileHeader *header = (const KtxFileHeader*)data;
+    if (size < sizeof(KtxFileHeader)
+            || memcmp(header->identifier, KTX_FILE_IDENTIFIER, KTX_FILE_IDENTIFIER_LENGTH) != 0) {
+        LOGE("mapKtxImage: not a KTX file");
+        return false;
+    }
+    if (header->endianness != KTX_FILE_ENDIANNESS || header->glInternalFormat != KTX_ETC1_RGB8
+            || header->pixelWidth == 0 || header->pixelHeight == 0 || header->pixelDepth != 0
+            || header->numberOfArrayElements != 0 || header->numberOfFaces != 1
+            || header->numberOfMipmapLevels == 0
+            || header->numberOfMipmapLevels > KTX_MAX_MIPMAP_LEVEL_COUNT) {
+        LOGE("mapKtxImage: unsupported KTX file (format 0x%x, %u levels)",
+                header->glInternalFormat, header->numberOfMipmapLevels);
+        return false;
+    }
+    // Abschnitte ablaufen und dabei gegen das Dateiende prüfen (in 64 Bit, damit beschädigte
+    // Größen nicht überlaufen)
+    unsigned long long offset = sizeof(KtxFileHeader)
+            + (unsigned long long)header->bytesOfKeyValueData;
+    uint32_t width = header->pixelWidth;
+    uint32_t height = header->pixelHeight;
+    for (uint32_t level = 0; level < header->numberOfMipmapLevels; ++level) {
+        if (offset + sizeof(uint32_t) > size) {
+            LOGE("mapKtxImage: level %u missing", level);
+            return false;
+        }
+        uint32_t levelSize = *(const uint32_t*)(data + offset);
+        offset += sizeof(uint32_t);
+        if (levelSize != etc1ImageSize(width, height) || offset + levelSize > size) {
+            LOGE("mapKtxImage: level %u has an invalid size (%u bytes)", level, levelSize);
+            return false;
+        }
+        image->levels[level] = data + offset;
+        image->levelSizes[level] = levelSize;
+        offset += levelSize;
+        width = width > 1 ? width / 2 : 1;
+        height = height > 1 ? height / 2 : 1;
+    }
+    if (offset != size) {
+        LOGE("mapKtxImage: inconsistent KTX file (%u bytes)", (unsigned int)size);
+        return false;
+    }
+    image->header = header;
+    image->keyValueData = data + sizeof(KtxFileHeader);
+    return true;
+}
+
+/**
+ * Lädt eine ETC1-komprimierte Textur aus einer KTX-Datei im Android Package.
+ *
+ * Wie bei loadMesh() wird eine unkomprimiert abgelegte Datei nur in den Speicher abgebildet. Die
+ * Datei bleibt dafür geöffnet, bis die Textur mit freeKtxImage() freigegeben wird.
+ *
+ * @param assetManager Der Asset-Manager des Android Packages.
+ * @param fileName Name der KTX-Datei im Verzeichnis "assets".
+ * @param image Die zu ladende Textur.
+ * @return true, wenn die Textur geladen wurde, sonst false.
+ */
+bool loadKtxImage(AAssetManager *assetManager, const char *fileName, KtxImage *image) {
+    LOG("loadKtxImage(%s)", fileName);
+    memset(image, 0, sizeof(KtxImage));
+    image->asset = AAssetManager_open(assetManager, fileName, AASSET_MODE_BUFFER);
+    if (image->asset == NULL) {
+        LOGE("loadKtxImage: could not open %s", fileName);
+        return false;
+    }
+    size_t size = AAsset_getLength(image->asset);
+    const void *data = AAsset_getBuffer(image->asset);
+    // Header und Stufen-Größen müssen an 4-Byte-Grenzen liegen (siehe loadMesh)
+    if (data == NULL || ((size_t)data & 3) != 0) {
+        LOGI("loadKtxImage: %s is not aligned, copying it", fileName);
+        image->buffer = malloc(size);
+        AAsset_seek(image->asset, 0, SEEK_SET);
+        if (image->buffer == NULL
+                || AAsset_read(image->asset, image->buffer, size) != (int)size) {
+            LOGE("loadKtxImage: could not read %s", fileName);
+            freeKtxImage(image);
+            return false;
+        }
+        data = image->buffer;
+    }
+    if (!mapKtxImage((const uint8_t*)data, size, image)) {
+        freeKtxImage(image);
+        return false;
+    }
+    LOG("loadKtxImage: %ux%u, %u levels", image->header->pixelWidth, image->header->pixelHeight,
+            image->header->numberOfMipmapLevels);
+    return true;
+}
+
+/**
+ * Gibt eine mit loadKtxImage() geladene Textur frei.
+ *
+ * @param image Die freizugebende Textur oder NULL.
+ */
+void freeKtxImage(KtxImage *image) {
+    if (image == NULL) {
+        return;
+    }
+    if (image->asset != NULL) {
+        AAsset_close(image->asset);
+    }
+    free(image->buffer);
+    memset(image, 0, sizeof(KtxImage));
+}
+
+/**
+ * Sucht einen Wert in den Schlüssel-Wert-Paaren einer KTX-Datei.
+ *
+ * @param image Die geladene Textur.
+ * @param key Der gesuchte Schlüssel.
+ * @param valueSize Erhält die Größe des Wertes in Byte.
+ * @return Der Wert oder NULL, wenn der Schlüssel nicht vorhanden ist.
+ */
+static const uint8_t* findKtxValue(const KtxImage *image, const char *key, uint32_t *valueSize) {
+    const uint8_t *pair = image->keyValueData;
+    const uint8_t *end = pair + image->header->bytesOfKeyValueData;
+    size_t keySize = strlen(key) + 1;
+    while (pair + sizeof(uint32_t) <= end) {
+        uint32_t pairSize = *(const uint32_t*)pair;
+        const uint8_t *pairData = pair + sizeof(uint32_t);
+        if (pairSize > (size_t)(end - pairData)) {
+            break;
+        }
+        if (pairSize >= keySize && memcmp(pairData, key, keySize) == 0) {
+            *valueSize = pairSize - keySize;
+            return pairData + keySize;
+        }
+        // Paare sind auf 4 Byte aufgefüllt
+        pair = pairData + ((pairSize + 3) & ~3u);
+    }
+    return NULL;
+}
+
+/**
+ * Lädt einen mit tools/textureBuilder.cpp erzeugten, ETC1-komprimierten Textur-Atlas aus dem
+ * Android Package. Die Pixel werden erst in uploadKtxTexture() in den Grafikspeicher geladen.
+ *
+ * @param assetManager Der Asset-Manager des Android Packages.
+ * @param colorFileName Name der KTX-Datei der Farb-Ebene.
+ * @param alphaFileName Name der KTX-Datei der Alpha-Ebene.
+ * @param regions Erhält die Bereiche der Kacheln im Atlas.
+ * @param regionCount Anzahl der erwarteten Kacheln.
+ * @return Der Textur-Atlas oder NULL, wenn er nicht geladen werden konnte.
+ */
+Texture* loadCompressedTextureAtlas(AAssetManager *assetManager, const char *colorFileName,
+        const char *alphaFileName, TextureAtlasRegion *regions, int regionCount) {
+    Texture *atlas = new Texture();
+    atlas->mColorImage = new KtxImage();
+    atlas->mAlphaImage = new KtxImage();
+    bool loaded = loadKtxImage(assetManager, colorFileName, atlas->mColorImage)
+            && loadKtxImage(assetManager, alphaFileName, atlas->mAlphaImage);
+    const KtxFileHeader *color = atlas->mColorImage->header;
+    const KtxFileHeader *alpha = atlas->mAlphaImage->header;
+    if (loaded && (color->pixelWidth != alpha->pixelWidth
+            || color->pixelHeight != alpha->pixelHeight
+            || color->numberOfMipmapLevels != alpha->numberOfMipmapLevels)) {
+        LOGE("loadCompressedTextureAtlas: color and alpha planes do not match");
+        loaded = false;
+    }
+    // Bereiche der Kacheln auslesen
+    uint32_t valueSize = 0;
+    const uint8_t *value = loaded
+            ? findKtxValue(atlas->mColorImage, KTX_ATLAS_REGIONS_KEY, &valueSize) : NULL;
+    if (loaded && valueSize != regionCount * sizeof(TextureAtlasRegion)) {
+        LOGE("loadCompressedTextureAtlas: expected %d regions", regionCount);
+        loaded = false;
+    }
+    if (!loaded) {
+        // gibt auch die Ebenen frei
+        delete atlas;
+        return NULL;
+    }
+    memcpy(regions, value, valueSize);
+    atlas->mWidth = color->pixelWidth;
+    atlas->mHeight = color->pixelHeight;
+    atlas->mChannelCount = 4;
+    return atlas;
+}
+
+/**
+ * Lädt alle Mipmap-Stufen einer Ebene komprimiert in ein neues Textur-Objekt.
+ *
+ * @param image Die Ebene.
+ * @return Das Textur-Objekt.
+ */
+static GLuint uploadCompressedLevels(const KtxImage *image) {
+    GLuint texture;
+    glGenTextures(1, &texture);
+    glBindTexture(GL_TEXTURE_2D, texture);
+    GLsizei width = image->header->pixelWidth;
+    GLsizei height = image->header->pixelHeight;
+    for (uint32_t level = 0; level < image->header->numberOfMipmapLevels; ++level) {
+        glCompressedTexImage2D(GL_TEXTURE_2D, level, GL_ETC1_RGB8_OES, width, height, 0,
+                image->levelSizes[level], image->levels[level]);
+        width = width > 1 ? width / 2 : 1;
+        height = height > 1 ? height / 2 : 1;
+    }
+    return texture;
+}
+
+/**
+ * Dekodiert alle Mipmap-Stufen beider Ebenen auf der CPU und lädt sie als RGBA4444 in ein neues
+ * Textur-Objekt.
+ *
+ * @param texture Die Textur.
+ * @return Das Textur-Objekt.
+ */
+static GLuint uploadDecodedLevels(const Texture *texture) {
+    GLuint textureId;
+    glGenTextures(1, &textureId);
+    glBindTexture(GL_TEXTURE_2D, textureId);
+    uint32_t width = texture->mWidth;
+    uint32_t height = texture->mHeight;
+    uint8_t *color = new uint8_t[width * height * 4];
+    uint8_t *alpha = new uint8_t[width * height * 4];
+    uint16_t *packed = new uint16_t[width * height];
+    // Zeilen mit ungerader Breite sind nur auf 2 Byte ausgerichtet
+    glPixelStorei(GL_UNPACK_ALIGNMENT, 2);
+    uint32_t levelCount = texture->mColorImage->header->numberOfMipmapLevels;
+    for (uint32_t level = 0; level < levelCount; ++level) {
+        decodeEtc1Image(texture->mColorImage->levels[level], width, height, color);
+        decodeEtc1Image(texture->mAlphaImage->levels[level], width, height, alpha);
+        for (uint32_t i = 0; i < width * height; ++i) {
+            const uint8_t *c = color + i * 4;
+            packed[i] = (uint16_t)(((c[0] * 15 + 127) / 255) << 12
+                    | ((c[1] * 15 + 127) / 255) << 8 | ((c[2] * 15 + 127) / 255) << 4
+                    | (alpha[i * 4 + 1] * 15 + 127) / 255);
+        }
+        glTexImage2D(GL_TEXTURE_2D, level, GL_RGBA, width, height, 0, GL_RGBA,
+                GL_UNSIGNED_SHORT_4_4_4_4, packed);
+        width = width > 1 ? width / 2 : 1;
+        height = height > 1 ? height / 2 : 1;
+    }
+    glPixelStorei(GL_UNPACK_ALIGNMENT, 4);
+    delete[] color;
+    delete[] alpha;
+    delete[] packed;
+    return textureId;
+}
+
+/**
+ * Lädt eine mit loadCompressedTextureAtlas() geladene Textur samt Mipmap-Kette in den
+ * Grafikspeicher. Muss nach initRenderer() aufgerufen werden, weil dort die Render-Pipeline
+ * gewählt wird.
+ *
+ * @param texture Die Textur.
+ */
+void uploadKtxTexture(Texture *texture) {
+    unsigned long startTime = getCurrentTimeInMs();
+    uint32_t levelCount = texture->mColorImage->header->numberOfMipmapLevels;
+    unsigned int size = 0;
+    if (usesShaders() && isGlExtensionSupported("GL_OES_compressed_ETC1_RGB8_texture")) {
+        texture->mTextureID = uploadCompressedLevels(texture->mColorImage);
+        texture->mAlphaTextureID = uploadCompressedLevels(texture->mAlphaImage);
+        for (uint32_t level = 0; level < levelCount; ++level) {
+            size += texture->mColorImage->levelSizes[level]
+                    + texture->mAlphaImage->levelSizes[level];
+        }
+    } else {
+        texture->mTextureID = uploadDecodedLevels(texture);
+        texture->mAlphaTextureID = 0;
+        for (uint32_t level = 0; level < levelCount; ++level) {
+            size += texture->mColorImage->levelSizes[level] * 4;
+        }
+    }
+    // Filter für beide Textur-Objekte setzen, trilinear nur mit vollständiger Mipmap-Kette
+    GLuint textureIds[2] = { texture->mTextureID, texture->mAlphaTextureID };
+    for (int i = 0; i < 2 && textureIds[i] != 0; ++i) {
+        glBindTexture(GL_TEXTURE_2D, textureIds[i]);
+        glTexParameterf(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER,
+                levelCount > 1 ? GL_LINEAR_MIPMAP_LINEAR : GL_LINEAR);
+        glTexParameterf(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, GL_LINEAR);
+    }
+    checkGlError("uploadKtxTexture");
+    LOG("uploadKtxTexture: %s, %u bytes in %lu ms",
+            texture->mAlphaTextureID != 0 ? "ETC1" : "RGBA4444", size,
+            getCurrentTimeInMs() - startTime);
+}
@@ -0,0 +1,23 @@
+/**
+ * @file ktxTexture.h
+ *
+ * @brief Schnittstelle zu ktxTexture.cpp.
+ *
+ * @author Alexander Bertram
+ *
+ * @date 16.10.2026
+ */
+
+#ifndef KTX_TEXTURE_H
+#define KTX_TEXTURE_H
+
+#include "Texture.h"
+#include "types.h"
+
+bool loadKtxImage(AAssetManager*, const char*, KtxImage*);
+void freeKtxImage(KtxImage*);
+Texture* loadCompressedTextureAtlas(AAssetManager*, const char*, const char*, TextureAtlasRegion*,
+        int);
+void uploadKtxTexture(Texture*);
+
+#endif
@@ -0,0 +1,291 @@
+/**
+ * @file latheMesh.cpp
+ *
+ * @brief Erzeugt Rotationskörper aus einem 2D-Profil.
+ *
+ * @details Das Profil ist ein Linienzug in der r-z-Ebene, der um die z-Achse rotiert wird. Die
+ *      Anzahl der Segmente in Umfangsrichtung ist frei wählbar, dadurch kann die Feinheit des
+ *      Models beim Start an das Gerät angepasst werden. Die Normalen werden analytisch aus dem
+ *      Profil berechnet: An Profil-Punkten, an denen der Linienzug um höchstens den Knickwinkel
+ *      abknickt, werden die Normalen der angrenzenden Profil-Segmente gemittelt, sonst erhält der
+ *      Punkt zwei Ringe von Vertices mit den jeweiligen Normalen (harte Kante).
+ *
+ *      Das Ergebnis wird im Format der Model-Dateien (siehe meshFile.h) erzeugt und kann deshalb
+ *      genauso wie eine aus dem Android Package geladene Datei gerendert werden. Jede weitere
+ *      Detailstufe halbiert die Anzahl der Segmente und hat eigene Vertices im selben Buffer.
+ *
+ *      Die Datei hängt nur von meshFile.h ab, damit sie auch auf dem Entwicklungsrechner
+ *      übersetzt werden kann (siehe tools/latheBenchmark.cpp).
+ *
+ * @author Alexander Bertram
+ *
+ * @date 15.10.2026
+ */
+
+#include <math.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "latheMesh.h"
+#include "meshFile.h"
+
+/**
+ * Kleinste Anzahl der Segmente in Umfangsrichtung.
+ */
+#define MIN_LATHE_SEGMENT_COUNT 3
+
+/**
+ * Radius, unterhalb dessen ein Profil-Punkt auf der Rotationsachse liegt (Pol).
+ */
+#define LATHE_POLE_RADIUS 1e-5f
+
+/**
+ * Größter Betrag einer quantisierten Positions-Komponente.
+ */
+#define MAX_QUANTIZED_POSITION 32767
+
+/**
+ * @brief Ring von Vertices, der durch Rotation eines Profil-Punktes entsteht.
+ */
+typedef struct LatheRing {
+    /**
+     * Radius.
+     */
+    float r;
+    /**
+     * Höhe.
+     */
+    float z;
+    /**
+     * Radiale Komponente der Normalen.
+     */
+    float normalR;
+    /**
+     * z-Komponente der Normalen.
+     */
+    float normalZ;
+} LatheRing;
+
+/**
+ * Quantisiert eine Normalen-Komponente. GL bildet einen Byte-Wert c auf (2c + 1) / 255 ab.
+ *
+ * @param value Die Normalen-Komponente.
+ * @return Die quantisierte Komponente.
+ */
+static int8_t quantizeNormal(float value) {
+    long quantized = lrintf((value * 255.f - 1.f) / 2.f);
+    return (int8_t)(quantized < -128 ? -128 : (quantized > 127 ? 127 : quantized));
+}
+
+/**
+ * Gibt die Anzahl der Vertices eines Ringes zurück.
+ *
+ * @param ring Der Ring.
+ * @param segmentCount Anzahl der Segmente in Umfangsrichtung.
+ * @return Anzahl der Vertices (1 für einen Pol).
+ */
+static int ringVertexCount(const LatheRing *ring, int segmentCount) {
+    return ring->r < LATHE_POLE_RADIUS ? 1 : segmentCount;
+}
+
+/**
+ * Erzeugt einen Rotationskörper im Format der Model-Dateien (siehe meshFile.h).
+ *
+ * @param profile Profil als Linienzug von r-z-Paaren von unten nach oben. Beginnt und endet das
+ *      Profil auf der Rotationsachse, wird der Körper an diesen Stellen geschlossen.
+ * @param profilePointCount Anzahl der Profil-Punkte (mindestens 2).
+ * @param segmentCount Anzahl der Segmente in Umfangsrichtung in der vollen Detailstufe.
+ * @param levelOfDetailCount Anzahl der Detailstufen. Jede weitere Detailstufe hat halb so viele
+ *      Segmente wie die vorherige, mindestens jedoch MIN_LATHE_SEGMENT_COUNT.
+ * @param creaseAngle Knickwinkel in Grad, bis zu dem die Normalen gemittelt werden.
+ * @param size Größe des erzeugten Speicherbereichs in Byte (Ausgabe).
+ * @return Mit malloc() angelegter Speicherbereich oder NULL bei ungültigen Parametern oder wenn
+ *      das Model mehr Vertices hätte als ein 16-Bit-Index adressieren kann.
+ */
+void* generateLatheMesh(const float *profile, int profilePointCount, int segmentCount,
+        int levelOfDetailCount, float creaseAngle, size_t *size) {
+    if (profilePointCount < 2 || segmentCount < MIN_LATHE_SEGMENT_COUNT
+            || levelOfDetailCount < 1) {
+        return NULL;
+    }
+    int profileSegmentCount = profilePointCount - 1;
+    // Ringe aus dem Profil erzeugen, an harten Kanten zwei Ringe pro Profil-Punkt
+    LatheRing *rings = (LatheRing*)malloc(2 * profilePointCount * sizeof(LatheRing));
+    int *lowerRings = (int*)malloc(2 * profileSegmentCount * sizeof(int));
+    int *upperRings = lowerRings + profileSegmentCount;
+    if (rings == NULL || lowerRings == NULL) {
+        free(rings);
+        free(lowerRings);
+        return NULL;
+    }
+    float cosCreaseAngle = cosf(creaseAngle * (float)M_PI / 180.f);
+    int ringCount = 0;
+    float previousNormal[2] = { 0.f, 0.f };
+    for (int i = 0; i < profilePointCount; ++i) {
+        const float *point = &profile[i * 2];
+        // nach außen zeigende Normale des folgenden Profil-Segments
+        float normal[2] = { 0.f, 0.f };
+        if (i < profileSegmentCount) {
+            float dr = point[2] - point[0];
+            float dz = point[3] - point[1];
+            float length = sqrtf(dr * dr + dz * dz);
+            if (length > 0.f) {
+                normal[0] = dz / length;
+                normal[1] = -dr / length;
+            }
+        }
+        LatheRing ring = { point[0], point[1], normal[0], normal[1] };
+        bool hardEdge = i > 0 && i < profileSegmentCount
+                && normal[0] * previousNormal[0] + normal[1] * previousNormal[1] < cosCreaseAngle;
+        if (hardEdge) {
+            // harte Kante: ein Ring für das vorherige und einer für das folgende Profil-Segment
+            LatheRing previousRing = { point[0], point[1], previousNormal[0], previousNormal[1] };
+            upperRings[i - 1] = ringCount;
+            rings[ringCount++] = previousRing;
+        } else if (i == profileSegmentCount) {
+            ring.normalR = previousNormal[0];
+            ring.normalZ = previousNormal[1];
+        } else if (i > 0) {
+            float r = normal[0] + previousNormal[0];
+            float z = normal[1] + previousNormal[1];
+            float length = sqrtf(r * r + z * z);
+            ring.normalR = length > 0.f ? r / length : normal[0];
+            ring.normalZ = length > 0.f ? z / length : normal[1];
+        }
+        // Der Ring dient als oberer Ring des vorherigen Profil-Segments (außer an harten Kanten)
+        // und als unterer Ring des folgenden.
+        if (i > 0 && !hardEdge) {
+            upperRings[i - 1] = ringCount;
+        }
+        if (i < profileSegmentCount) {
+            lowerRings[i] = ringCount;
+        }
+        rings[ringCount++] = ring;
+        previousNormal[0] = normal[0];
+        previousNormal[1] = normal[1];
+    }
+    // Anzahl der Vertices und Indizes aller Detailstufen bestimmen
+    int vertexCount = 0;
+    int indexCount = 0;
+    float maxRadius = 0.f;
+    float minZ = profile[1];
+    float maxZ = profile[1];
+    for (int i = 0; i < profilePointCount; ++i) {
+        maxRadius = profile[i * 2] > maxRadius ? profile[i * 2] : maxRadius;
+        minZ = profile[i * 2 + 1] < minZ ? profile[i * 2 + 1] : minZ;
+        maxZ = profile[i * 2 + 1] > maxZ ? profile[i * 2 + 1] : maxZ;
+    }
+    for (int level = 0; level < levelOfDetailCount; ++level) {
+        int segments = segmentCount >> level;
+        segments = segments < MIN_LATHE_SEGMENT_COUNT ? MIN_LATHE_SEGMENT_COUNT : segments;
+        for (int i = 0; i < ringCount; ++i) {
+            vertexCount += ringVertexCount(&rings[i], segments);
+        }
+        for (int k = 0; k < profileSegmentCount; ++k) {
+            bool lowerPole = ringVertexCount(&rings[lowerRings[k]], segments) == 1;
+            bool upperPole = ringVertexCount(&rings[upperRings[k]], segments) == 1;
+            indexCount += lowerPole && upperPole ? 0 : (lowerPole || upperPole ? 3 : 6) * segments;
+        }
+    }
+    if (vertexCount > 0x10000) {
+        free(rings);
+        free(lowerRings);
+        return NULL;
+    }
+    // Speicherbereich im Format der Model-Dateien anlegen
+    *size = sizeof(MeshFileHeader) + levelOfDetailCount * sizeof(MeshLevelOfDetail)
+            + vertexCount * sizeof(MeshVertex) + indexCount * sizeof(uint16_t);
+    char *data = (char*)malloc(*size);
+    if (data == NULL) {
+        free(rings);
+        free(lowerRings);
+        return NULL;
+    }
+    MeshFileHeader *header = (MeshFileHeader*)data;
+    memcpy(header->magic, MESH_FILE_MAGIC, 4);
+    header->version = MESH_FILE_VERSION;
+    header->vertexCount = vertexCount;
+    header->indexCount = indexCount;
+    header->levelOfDetailCount = levelOfDetailCount;
+    header->positionOffset[0] = 0.f;
+    header->positionOffset[1] = 0.f;
+    header->positionOffset[2] = (minZ + maxZ) / 2.f;
+    float halfExtent = (maxZ - minZ) / 2.f > maxRadius ? (maxZ - minZ) / 2.f : maxRadius;
+    header->positionScale = halfExtent / MAX_QUANTIZED_POSITION;
+    MeshLevelOfDetail *levelsOfDetail = (MeshLevelOfDetail*)(header + 1);
+    MeshVertex *vertices = (MeshVertex*)(levelsOfDetail + levelOfDetailCount);
+    uint16_t *indices = (uint16_t*)(vertices + vertexCount);
+    // Ring-Anfänge einer Detailstufe
+    int *firstVertices = (int*)malloc(ringCount * sizeof(int));
+    if (firstVertices == NULL) {
+        free(data);
+        free(rings);
+        free(lowerRings);
+        return NULL;
+    }
+    float inverseScale = 1.f / header->positionScale;
+    int vertex = 0;
+    int index = 0;
+    for (int level = 0; level < levelOfDetailCount; ++level) {
+        int segments = segmentCount >> level;
+        segments = segments < MIN_LATHE_SEGMENT_COUNT ? MIN_LATHE_SEGMENT_COUNT : segments;
+        // Vertices ringweise von unten nach oben
+        for (int i = 0; i < ringCount; ++i) {
+            const LatheRing *ring = &rings[i];
+            firstVertices[i] = vertex;
+            int count = ringVertexCount(ring, segments);
+            for (int j = 0; j < count; ++j) {
+                float angle = 2.f * (float)M_PI * j / segments;
+                float cosAngle = count == 1 ? 0.f : cosf(angle);
+                float sinAngle = count == 1 ? 0.f : sinf(angle);
+                MeshVertex *v = &vertices[vertex++];
+                v->position[0] = (int16_t)lrintf(ring->r * cosAngle * inverseScale);
+                v->position[1] = (int16_t)lrintf(ring->r * sinAngle * inverseScale);
+                v->position[2] = (int16_t)lrintf((ring->z - header->positionOffset[2])
+                        * inverseScale);
+                v->positionPadding = 0;
+                // am Pol zeigt die Normale entlang der Rotationsachse
+                float normalZ = count == 1 ? (ring->normalZ < 0.f ? -1.f : 1.f) : ring->normalZ;
+                v->normal[0] = quantizeNormal(ring->normalR * cosAngle);
+                v->normal[1] = quantizeNormal(ring->normalR * sinAngle);
+                v->normal[2] = quantizeNormal(normalZ);
+                v->normalPadding = 0;
+            }
+        }
+        // Dreiecke streifenweise zwischen zwei Ringen (gegen den Uhrzeigersinn von außen)
+        levelsOfDetail[level].firstIndex = index;
+        for (int k = 0; k < profileSegmentCount; ++k) {
+            int lower = firstVertices[lowerRings[k]];
+            int upper = firstVertices[upperRings[k]];
+            bool lowerPole = ringVertexCount(&rings[lowerRings[k]], segments) == 1;
+            bool upperPole = ringVertexCount(&rings[upperRings[k]], segments) == 1;
+            if (lowerPole && upperPole) {
+                continue;
+            }
+            for (int j = 0; j < segments; ++j) {
+                int next = (j + 1) % segments;
+                if (lowerPole) {
+                    indices[index++] = lower;
+                    indices[index++] = upper + next;
+                    indices[index++] = upper + j;
+                } else if (upperPole) {
+                    indices[index++] = lower + j;
+                    indices[index++] = lower + next;
+                    indices[index++] = upper;
+                } else {
+                    indices[index++] = lower + j;
+                    indices[index++] = lower + next;
+                    indices[index++] = upper + next;
+                    indices[index++] = lower + j;
+                    indices[index++] = upper + next;
+                    indices[index++] = upper + j;
+                }
+            }
+        }
+        levelsOfDetail[level].indexCount = index - levelsOfDetail[level].firstIndex;
+    }
+    free(firstVertices);
+    free(rings);
+    free(lowerRings);
+    return data;
+}
@@ -0,0 +1,18 @@
+/**
+ * @file latheMesh.h
+ *
+ * @brief Schnittstelle zu latheMesh.cpp.
+ *
+ * @author Alexander Bertram
+ *
+ * @date 15.10.2026
+ */
+
+#ifndef LATHE_MESH_H
+#define LATHE_MESH_H
+
+#include <stddef.h>
+
+void* generateLatheMesh(const float*, int, int, int, float, size_t*);
+
+#endif
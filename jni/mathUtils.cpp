@@ -15,6 +15,8 @@
 #include <QCAR/Renderer.h>
 #include <QCAR/VideoBackgroundConfig.h>
 
+#include "mathUtils.h"
+
 /**
  * Berechnet die Differenz zweier 2D-Vektoren .
  *
@@ -350,6 +352,90 @@ void projectScreenPointToPlane(float screenWidth, float screenHeight, QCAR::Vec2
     linePlaneIntersection(lineStart, lineEnd, planeCenter, planeNormal, intersection);
 }
 
+/**
+ * Berechnet die Projektion von Bildschirm-Positionen auf die Ebene des Trackables (z = 0) für einen
+ * Frame vor. Die Abbildung entspricht der von projectScreenPointToPlane(), die Model-View-Matrix
+ * wird aber nur einmal pro Frame invertiert und die Konfiguration des Video-Hintergrundes nur
+ * einmal gelesen.
+ *
+ * @param screenWidth Bildschirm-Breite.
+ * @param screenHeight Bildschrim-Höhe.
+ * @param inverseProjectionMatrix Inverse Projektionsmatrix.
+ * @param modelViewMatrix Model-View-Matrix.
+ * @param projection Erhält die vorberechnete Projektion.
+ */
+void initScreenPlaneProjection(float screenWidth, float screenHeight,
+        QCAR::Matrix44F inverseProjectionMatrix, QCAR::Matrix44F modelViewMatrix,
+        ScreenPlaneProjection *projection) {
+    // Window Coordinates to Normalized Device Coordinates
+    QCAR::VideoBackgroundConfig config =
+            QCAR::Renderer::getInstance().getVideoBackgroundConfig();
+    float halfViewportWidth = config.mSize.data[0] / 2.0f;
+    float halfViewportHeight = config.mSize.data[1] / 2.0f;
+    projection->scale[0] = 1.f / halfViewportWidth;
+    projection->scale[1] = -1.f / halfViewportHeight;
+    projection->offset[0] = -screenWidth / 2.0f / halfViewportWidth;
+    projection->offset[1] = screenHeight / 2.0f / halfViewportHeight;
+    projection->inverseProjectionMatrix = inverseProjectionMatrix;
+    projection->inverseModelViewMatrix = matrix44FInverse(modelViewMatrix);
+}
+
+/**
+ * Projeziert mehrere Bildschirm-Positionen auf die Ebene des Trackables (z = 0).
+ *
+ * Pro Position wird nur der Punkt auf der nahen Ebene transformiert. Die Richtung zum Punkt auf der
+ * fernen Ebene ergibt sich aus der dritten Spalte der inversen Projektionsmatrix, so dass die
+ * Auslöschung beim Teilen durch das kleine w der fernen Ebene entfällt.
+ *
+ * @param projection Vorberechnete Projektion des aktuellen Frames.
+ * @param points Bildschirm-Positionen.
+ * @param count Anzahl der Positionen.
+ * @param intersections Erhält die Schnittpunkte mit der Ebene. Positionen, deren Sichtlinie
+ *      parallel zur Ebene verläuft, werden übersprungen.
+ * @return Anzahl der Schnittpunkte.
+ */
+int projectScreenPointsToPlane(const ScreenPlaneProjection *projection,
+        const QCAR::Vec2F *points, int count, QCAR::Vec2F *intersections) {
+    // wie in vec4FTransform() ist m[4 * i + j] das Element in Zeile i und Spalte j
+    const float *p = projection->inverseProjectionMatrix.data;
+    const float *m = projection->inverseModelViewMatrix.data;
+    int intersectionCount = 0;
+    for (int i = 0; i < count; ++i) {
+        float x = points[i].data[0] * projection->scale[0] + projection->offset[0];
+        float y = points[i].data[1] * projection->scale[1] + projection->offset[1];
+        // Normalized Device Coordinates (x, y, -1, 1) to Eye Coordinates
+        float eye[4];
+        for (int k = 0; k < 4; ++k) {
+            eye[k] = p[4 * k] * x + p[4 * k + 1] * y - p[4 * k + 2] + p[4 * k + 3];
+        }
+        // Richtung zum Punkt auf der fernen Ebene (x, y, 1, 1), bis auf einen Faktor
+        float direction[3];
+        for (int k = 0; k < 3; ++k) {
+            direction[k] = p[4 * k + 2] * eye[3] - eye[k] * p[14];
+            eye[k] /= eye[3];
+        }
+        // Eye Coordinates to Object Coordinates
+        float lineStart[3], lineDirection[3];
+        for (int k = 0; k < 3; ++k) {
+            const float *row = m + 4 * k;
+            lineStart[k] = row[0] * eye[0] + row[1] * eye[1] + row[2] * eye[2] + row[3];
+            lineDirection[k] = row[0] * direction[0] + row[1] * direction[1]
+                    + row[2] * direction[2];
+        }
+        float length = sqrtf(lineDirection[0] * lineDirection[0]
+                + lineDirection[1] * lineDirection[1] + lineDirection[2] * lineDirection[2]);
+        if (fabs(lineDirection[2]) < 0.00001f * length) {
+            // Line is parallel to plane
+            continue;
+        }
+        float t = -lineStart[2] / lineDirection[2];
+        intersections[intersectionCount].data[0] = lineStart[0] + t * lineDirection[0];
+        intersections[intersectionCount].data[1] = lineStart[1] + t * lineDirection[1];
+        ++intersectionCount;
+    }
+    return intersectionCount;
+}
+
 /**
  * Multipliziert die übergebene Matrix mit einer Verschiebungsmatrix.
  *
@@ -470,3 +556,52 @@ void rotatePoseMatrix(float angle, float x, float y, float z, float* matrix) {
     // matrix * scale_matrix
     multiplyMatrix(matrix, rotate_matrix, matrix);
 }
+
+/**
+ * Bestimmt die Ebenen des Sichtbereiches aus einer Model-View-Projektionsmatrix (Verfahren nach
+ * Gribb und Hartmann). Die Ebenen liegen im Koordinatensystem, in das die Model-View-Matrix
+ * transformiert.
+ *
+ * @param matrix Die Model-View-Projektionsmatrix (spaltenweise).
+ * @param frustum Erhält die Ebenen des Sichtbereiches.
+ */
+void extractFrustum(const float *matrix, Frustum *frustum) {
+    for (int i = 0; i < 6; ++i) {
+        // Zeile 4 der Matrix plus bzw. minus Zeile 1 (x), 2 (y) oder 3 (z)
+        int row = i / 2;
+        float sign = (i % 2 == 0) ? 1.f : -1.f;
+        float *plane = frustum->planes[i];
+        for (int j = 0; j < 4; ++j) {
+            plane[j] = matrix[j * 4 + 3] + sign * matrix[j * 4 + row];
+        }
+        // normieren, damit Abstände in Model-Koordinaten berechnet werden können
+        float length = sqrtf(plane[0] * plane[0] + plane[1] * plane[1] + plane[2] * plane[2]);
+        if (length > 0.f) {
+            for (int j = 0; j < 4; ++j) {
+                plane[j] /= length;
+            }
+        }
+    }
+}
+
+/**
+ * Prüft, ob eine Kugel zumindest teilweise im Sichtbereich liegt. Das Ergebnis ist konservativ:
+ * Kugeln in der Nähe der Ecken des Sichtbereiches können als sichtbar gelten, obwohl sie es nicht
+ * sind.
+ *
+ * @param frustum Der Sichtbereich.
+ * @param x x-Koordinate des Mittelpunktes.
+ * @param y y-Koordinate des Mittelpunktes.
+ * @param z z-Koordinate des Mittelpunktes.
+ * @param radius Radius der Kugel.
+ * @return True, wenn die Kugel nicht vollständig außerhalb einer der Ebenen liegt.
+ */
+bool isSphereInFrustum(const Frustum *frustum, float x, float y, float z, float radius) {
+    for (int i = 0; i < 6; ++i) {
+        const float *plane = frustum->planes[i];
+        if (plane[0] * x + plane[1] * y + plane[2] * z + plane[3] < -radius) {
+            return false;
+        }
+    }
+    return true;
+}
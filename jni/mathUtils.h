@@ -13,6 +13,8 @@
 
 #include <QCAR/Tool.h>
 
+#include "types.h"
+
 QCAR::Vec2F vec2FAdd(QCAR::Vec2F, QCAR::Vec2F);
 QCAR::Vec2F vec2FSub(QCAR::Vec2F v1, QCAR::Vec2F v2);
 QCAR::Vec3F vec3FAdd(QCAR::Vec3F v1, QCAR::Vec3F v2);
@@ -33,8 +35,16 @@ bool linePlaneIntersection(QCAR::Vec3F lineStart, QCAR::Vec3F lineEnd, QCAR::Vec
 void projectScreenPointToPlane(float screenWidth, float screenHeight, QCAR::Vec2F point,
         QCAR::Matrix44F inverseProjectionMatrix, QCAR::Matrix44F modelViewMatrix,
         QCAR::Vec3F planeCenter, QCAR::Vec3F planeNormal, QCAR::Vec3F &intersection);
+void initScreenPlaneProjection(float screenWidth, float screenHeight,
+        QCAR::Matrix44F inverseProjectionMatrix, QCAR::Matrix44F modelViewMatrix,
+        ScreenPlaneProjection *projection);
+int projectScreenPointsToPlane(const ScreenPlaneProjection *projection,
+        const QCAR::Vec2F *points, int count, QCAR::Vec2F *intersections);
 void translatePoseMatrix(float x, float y, float z, float* nMatrix = NULL);
 void scalePoseMatrix(float x, float y, float z, float* nMatrix = NULL);
 void rotatePoseMatrix(float angle, float x, float y, float z, float* nMatrix = NULL);
+void multiplyMatrix(float *matrixA, float *matrixB, float *matrixC);
+void extractFrustum(const float *matrix, Frustum *frustum);
+bool isSphereInFrustum(const Frustum *frustum, float x, float y, float z, float radius);
 
 #endif
@@ -0,0 +1,183 @@
+/**
+ * @file mesh.cpp
+ *
+ * @brief Beinhaltet Funktionen zum Laden von Models aus dem Android Package.
+ *
+ * @author Alexander Bertram
+ *
+ * @date 15.10.2026
+ */
+
+#include <math.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include <android/asset_manager.h>
+
+#include "mesh.h"
+#include "types.h"
+#include "utils.h"
+
+/**
+ * Prüft, ob die Daten einer Model-Datei gültig sind und setzt die Zeiger des Models auf die
+ * einzelnen Abschnitte.
+ *
+ * @param data Daten der Model-Datei.
+ * @param size Größe der Daten in Byte.
+ * @param mesh Das Model, dessen Zeiger gesetzt werden.
+ * @return true, wenn die Daten gültig sind, sonst false.
+ */
+static bool mapMesh(const void *data, size_t size, Mesh *mesh) {
+    const MeshFileHeader *header = (const MeshFileHeader*)data;
+    if (size < sizeof(MeshFileHeader) || memcmp(header->magic, MESH_FILE_MAGIC, 4) != 0) {
+        LOGE("mapMesh: not a mesh file");
+        return false;
+    }
+    if (header->version != MESH_FILE_VERSION) {
+        LOGE("mapMesh: unsupported mesh file version %u", header->version);
+        return false;
+    }
+    // Größe der Datei mit der Größe der im Header angegebenen Abschnitte vergleichen (in 64 Bit,
+    // damit beschädigte Zähler nicht überlaufen)
+    unsigned long long expectedSize = sizeof(MeshFileHeader)
+            + (unsigned long long)header->levelOfDetailCount * sizeof(MeshLevelOfDetail)
+            + (unsigned long long)header->vertexCount * sizeof(MeshVertex)
+            + (unsigned long long)header->indexCount * sizeof(GLushort);
+    if (header->levelOfDetailCount == 0 || header->vertexCount > 0x10000 || expectedSize != size) {
+        LOGE("mapMesh: inconsistent mesh file (%u bytes)", (unsigned int)size);
+        return false;
+    }
+    const char *section = (const char*)data + sizeof(MeshFileHeader);
+    const MeshLevelOfDetail *levelsOfDetail = (const MeshLevelOfDetail*)section;
+    section += header->levelOfDetailCount * sizeof(MeshLevelOfDetail);
+    const MeshVertex *vertices = (const MeshVertex*)section;
+    section += header->vertexCount * sizeof(MeshVertex);
+    const GLushort *indices = (const GLushort*)section;
+    // Detailstufen und Indizes prüfen, damit der Grafiktreiber nie außerhalb der Buffer liest
+    for (unsigned int i = 0; i < header->levelOfDetailCount; ++i) {
+        if (levelsOfDetail[i].firstIndex < 0 || levelsOfDetail[i].indexCount < 0
+                || (unsigned int)(levelsOfDetail[i].firstIndex + levelsOfDetail[i].indexCount)
+                        > header->indexCount) {
+            LOGE("mapMesh: level of detail %u out of range", i);
+            return false;
+        }
+    }
+    for (unsigned int i = 0; i < header->indexCount; ++i) {
+        if (indices[i] >= header->vertexCount) {
+            LOGE("mapMesh: index %u out of range", i);
+            return false;
+        }
+    }
+    mesh->header = header;
+    mesh->levelsOfDetail = levelsOfDetail;
+    mesh->vertices = vertices;
+    mesh->indices = indices;
+    // Umkugel um den Mittelpunkt des umgebenden Quaders berechnen (für das Frustum-Culling)
+    int minimum[3] = { 0x7fff, 0x7fff, 0x7fff };
+    int maximum[3] = { -0x8000, -0x8000, -0x8000 };
+    for (unsigned int i = 0; i < header->vertexCount; ++i) {
+        for (int j = 0; j < 3; ++j) {
+            minimum[j] = min(minimum[j], vertices[i].position[j]);
+            maximum[j] = max(maximum[j], vertices[i].position[j]);
+        }
+    }
+    float center[3];
+    for (int j = 0; j < 3; ++j) {
+        center[j] = (minimum[j] + maximum[j]) / 2.f;
+    }
+    float radiusSquared = 0.f;
+    for (unsigned int i = 0; i < header->vertexCount; ++i) {
+        float distanceSquared = 0.f;
+        for (int j = 0; j < 3; ++j) {
+            float delta = vertices[i].position[j] - center[j];
+            distanceSquared += delta * delta;
+        }
+        if (distanceSquared > radiusSquared) {
+            radiusSquared = distanceSquared;
+        }
+    }
+    for (int j = 0; j < 3; ++j) {
+        mesh->boundingSphere[j] = header->positionOffset[j] + header->positionScale * center[j];
+    }
+    mesh->boundingSphere[3] = header->positionScale * sqrtf(radiusSquared);
+    return true;
+}
+
+/**
+ * Lädt ein Model aus einer Model-Datei (siehe meshFile.h) im Android Package.
+ *
+ * Ist die Datei unkomprimiert im Android Package abgelegt, wird sie nur in den Speicher
+ * abgebildet und die Daten werden ohne Kopie verwendet. Die Datei bleibt dafür geöffnet, bis das
+ * Model mit freeMesh() freigegeben wird.
+ *
+ * @param assetManager Der Asset-Manager des Android Packages.
+ * @param fileName Name der Model-Datei im Verzeichnis "assets".
+ * @param mesh Das zu ladende Model.
+ * @return true, wenn das Model geladen wurde, sonst false.
+ */
+bool loadMesh(AAssetManager *assetManager, const char *fileName, Mesh *mesh) {
+    LOG("loadMesh(%s)", fileName);
+    memset(mesh, 0, sizeof(Mesh));
+    mesh->asset = AAssetManager_open(assetManager, fileName, AASSET_MODE_BUFFER);
+    if (mesh->asset == NULL) {
+        LOGE("loadMesh: could not open %s", fileName);
+        return false;
+    }
+    size_t size = AAsset_getLength(mesh->asset);
+    const void *data = AAsset_getBuffer(mesh->asset);
+    // Die Abschnitte müssen an 4-Byte-Grenzen liegen. Das ist bei einem mit zipalign
+    // ausgerichteten Android Package gegeben, sonst wird die Datei kopiert.
+    if (data == NULL || ((size_t)data & 3) != 0) {
+        LOGI("loadMesh: %s is not aligned, copying it", fileName);
+        mesh->buffer = malloc(size);
+        AAsset_seek(mesh->asset, 0, SEEK_SET);
+        if (mesh->buffer == NULL || AAsset_read(mesh->asset, mesh->buffer, size) != (int)size) {
+            LOGE("loadMesh: could not read %s", fileName);
+            freeMesh(mesh);
+            return false;
+        }
+        data = mesh->buffer;
+    }
+    if (!mapMesh(data, size, mesh)) {
+        freeMesh(mesh);
+        return false;
+    }
+    LOG("loadMesh: %u vertices, %u indices, %u levels of detail", mesh->header->vertexCount,
+            mesh->header->indexCount, mesh->header->levelOfDetailCount);
+    return true;
+}
+
+/**
+ * Erzeugt ein Model aus einem Speicherbereich im Format der Model-Dateien (siehe meshFile.h), z.B.
+ * einem mit generateLatheMesh() erzeugten Rotationskörper. Das Model übernimmt den Speicherbereich
+ * und gibt ihn in freeMesh() frei.
+ *
+ * @param data Mit malloc() angelegter Speicherbereich oder NULL.
+ * @param size Größe des Speicherbereichs in Byte.
+ * @param mesh Das zu erzeugende Model.
+ * @return true, wenn das Model erzeugt wurde, sonst false.
+ */
+bool createMesh(void *data, size_t size, Mesh *mesh) {
+    memset(mesh, 0, sizeof(Mesh));
+    mesh->buffer = data;
+    if (data == NULL || !mapMesh(data, size, mesh)) {
+        LOGE("createMesh: invalid mesh data");
+        freeMesh(mesh);
+        return false;
+    }
+    return true;
+}
+
+/**
+ * Gibt ein mit loadMesh() oder createMesh() erzeugtes Model frei.
+ *
+ * @param mesh Das freizugebende Model.
+ */
+void freeMesh(Mesh *mesh) {
+    if (mesh->asset != NULL) {
+        AAsset_close(mesh->asset);
+    }
+    free(mesh->buffer);
+    memset(mesh, 0, sizeof(Mesh));
+}
@@ -0,0 +1,20 @@
+/**
+ * @file mesh.h
+ *
+ * @brief Schnittstelle zu mesh.cpp.
+ *
+ * @author Alexander Bertram
+ *
+ * @date 15.10.2026
+ */
+
+#ifndef MESH_H
+#define MESH_H
+
+#include "types.h"
+
+bool loadMesh(AAssetManager*, const char*, Mesh*);
+bool createMesh(void*, size_t, Mesh*);
+void freeMesh(Mesh*);
+
+#endif
@@ -0,0 +1,113 @@
+/**
+ * @file meshFile.h
+ *
+ * @brief Beschreibt das binäre Dateiformat der Models.
+ *
+ * @details Die Datei wird von tools/meshBuilder.cpp geschrieben und zur Laufzeit direkt aus dem
+ *      Android Package in den Speicher abgebildet, ohne die Daten zu kopieren. Deshalb entspricht
+ *      das Format exakt den Strukturen, mit denen gerendert wird. Alle Werte liegen in
+ *      Little-Endian-Byte-Reihenfolge vor. Auf den Header folgen ohne Lücken:
+ *
+ *      - levelOfDetailCount Detailstufen (MeshLevelOfDetail),
+ *      - vertexCount Vertices (MeshVertex),
+ *      - indexCount Indizes (uint16_t) aller Detailstufen.
+ *
+ *      Alle Abschnitte beginnen an 4-Byte-Grenzen. Die Datei wird nicht erweitert, sondern bei
+ *      jeder Änderung des Formats die Version erhöht.
+ *
+ * @author Alexander Bertram
+ *
+ * @date 15.10.2026
+ */
+
+#ifndef MESH_FILE_H
+#define MESH_FILE_H
+
+#include <stdint.h>
+
+/**
+ * Kennung am Anfang jeder Model-Datei.
+ */
+#define MESH_FILE_MAGIC "IBGM"
+/**
+ * Aktuelle Version des Dateiformats.
+ */
+#define MESH_FILE_VERSION 1
+
+/**
+ * @brief Header einer Model-Datei.
+ */
+typedef struct MeshFileHeader {
+    /**
+     * Kennung der Datei (MESH_FILE_MAGIC ohne abschließende Null).
+     */
+    char magic[4];
+    /**
+     * Version des Dateiformats.
+     */
+    uint32_t version;
+    /**
+     * Anzahl der Vertices.
+     */
+    uint32_t vertexCount;
+    /**
+     * Anzahl der Indizes aller Detailstufen.
+     */
+    uint32_t indexCount;
+    /**
+     * Anzahl der Detailstufen.
+     */
+    uint32_t levelOfDetailCount;
+    /**
+     * Verschiebung der quantisierten Positionen. Die Model-Koordinaten eines Vertex ergeben sich
+     * aus positionOffset + positionScale * position.
+     */
+    float positionOffset[3];
+    /**
+     * Skalierungsfaktor der quantisierten Positionen.
+     */
+    float positionScale;
+} MeshFileHeader;
+
+/**
+ * @brief Quantisierter Vertex eines Models mit Position und Normale.
+ *
+ * Position und Normale liegen verschränkt in 12 Byte. Beide Teile sind auf 4 Byte aufgefüllt,
+ * damit jeder Zugriff ausgerichtet ist.
+ */
+typedef struct MeshVertex {
+    /**
+     * Quantisierte Position. Die Umrechnung in Model-Koordinaten erfolgt über die
+     * Transformationsmatrix.
+     */
+    int16_t position[3];
+    /**
+     * Füllwert für die 4-Byte-Ausrichtung.
+     */
+    int16_t positionPadding;
+    /**
+     * Quantisierte Normale.
+     */
+    int8_t normal[3];
+    /**
+     * Füllwert für die 4-Byte-Ausrichtung.
+     */
+    int8_t normalPadding;
+} MeshVertex;
+
+/**
+ * @brief Detailstufe eines Models. Alle Detailstufen eines Models verwenden dieselben Vertices und
+ * liegen hintereinander im selben Index-Buffer.
+ */
+typedef struct MeshLevelOfDetail {
+    /**
+     * Index des ersten Indexes der Detailstufe im Index-Buffer.
+     */
+    int32_t firstIndex;
+    /**
+     * Anzahl der Indizes der Detailstufe.
+     */
+    int32_t indexCount;
+} MeshLevelOfDetail;
+
+#endif
@@ -10,6 +10,8 @@
 
 #include <jni.h>
 
+#include "constants.h"
+#include "types.h"
 #include "game.h"
 #include "utils.h"
 
@@ -22,10 +24,6 @@ extern "C" {
      * Aktueller Spieler (verwaltet in game.cpp).
      */
     extern Player* currentPlayer;
-    /*
-    * Spielfeld (verwaltet in field.cpp).
-     */
-    extern Field field;
 
     /**
      * Versetzt das Spiel in den Spiel-Zustand, in dem der beginnende Spieler bestimmt wird,
@@ -37,6 +35,9 @@ extern "C" {
     JNIEXPORT void JNICALL Java_de_fhwedel_vr2_invisiboga_OverlayView_nextButtonClickNative(
             JNIEnv*, jobject) {
         LOGD("Java_de_fhwedel_vr2_invisiboga_OverlayView_nextButtonClickNative");
+        // fertiges Spielfeld für den nächsten Start sichern, im GL-Thread, da dort eventuell
+        // noch Felder erzeugt werden
+        requestGameAction(GAME_REQUEST_SAVE_FIELD);
         updateGameState(GAME_STATE_DRAWING_BEGINNING_PLAYER);
     }
 
@@ -62,10 +63,8 @@ extern "C" {
     JNIEXPORT void JNICALL Java_de_fhwedel_vr2_invisiboga_OverlayView_restartNative(JNIEnv*,
             jobject) {
         LOGD("Java_de_fhwedel_vr2_invisiboga_OverlayView_restartNative");
-        // Anzahl der Felder resetten
-        field.length = 0;
-        // Spiel neustarten
-        restartGame();
+        // Spielfeld und Gitter werden im GL-Thread gelesen, deshalb dort leeren und neustarten
+        requestGameAction(GAME_REQUEST_RESTART);
     }
 
 #ifdef __cplusplus
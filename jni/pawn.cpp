@@ -8,16 +8,44 @@
  * @date 22.08.2011
  */
 #include "constants.h"
+#include "field.h"
+#include "latheMesh.h"
 #include "mathUtils.h"
+#include "mesh.h"
 #include "pawn.h"
+#include "pawnProfile.h"
 #include "timeUtilities.h"
 #include "Types.h"
 #include "utils.h"
 
-/*
- * Spielfeld.
+/**
+ * Erzeugt das Model der Spielfigur.
+ *
+ * Ist PAWN_LATHE_SEGMENT_COUNT größer als 0, wird die Spielfigur als Rotationskörper aus ihrem
+ * Profil erzeugt. Die Feinheit lässt sich so an das Gerät anpassen, ohne eine neue Model-Datei
+ * erzeugen zu müssen. Sonst wird die Model-Datei PAWN_MESH_FILE_NAME aus dem Android Package
+ * geladen.
+ *
+ * @param assetManager Der Asset-Manager des Android Packages.
+ * @param mesh Das zu erzeugende Model.
+ * @return true, wenn das Model erzeugt wurde, sonst false.
  */
-extern Field field;
+bool initPawnMesh(AAssetManager *assetManager, Mesh *mesh) {
+    if (PAWN_LATHE_SEGMENT_COUNT <= 0) {
+        return loadMesh(assetManager, PAWN_MESH_FILE_NAME, mesh);
+    }
+    unsigned long startTime = getCurrentTimeInMs();
+    size_t size = 0;
+    void *data = generateLatheMesh(pawnProfile, PAWN_PROFILE_POINT_COUNT,
+            PAWN_LATHE_SEGMENT_COUNT, PAWN_LATHE_LEVEL_OF_DETAIL_COUNT, PAWN_LATHE_CREASE_ANGLE,
+            &size);
+    if (!createMesh(data, size, mesh)) {
+        return false;
+    }
+    LOG("initPawnMesh: %d segments, %u vertices, %u indices in %lu ms", PAWN_LATHE_SEGMENT_COUNT,
+            mesh->header->vertexCount, mesh->header->indexCount, getCurrentTimeInMs() - startTime);
+    return true;
+}
 
 /**
  * Initialisiert eine Spielfigur.
@@ -27,6 +55,8 @@ extern Field field;
 void initPawn(Pawn *pawn) {
     LOGD("initPawn");
     pawn->state = PAWN_STATE_RESTING;
+    pawn->levelOfDetail = 0;
+    pawn->visible = false;
 }
 
 /**
@@ -49,7 +79,7 @@ void initPawnSpaces(Pawn *pawn) {
  */
 void setPawnCurrentSpace(Pawn *pawn, int spaceIndex) {
     // Feld setzen
-    pawn->currentSpace = &field.spaces[spaceIndex];
+    pawn->currentSpace = getSpace(spaceIndex);
     // Position setzen
     pawn->position = pawn->currentSpace->position;
 }
@@ -62,7 +92,7 @@ void setPawnCurrentSpace(Pawn *pawn, int spaceIndex) {
  */
 void setPawnTargetSpace(Pawn *pawn, int spaceIndex) {
     // Feld setzen
-    pawn->targetSpace = &field.spaces[spaceIndex];
+    pawn->targetSpace = getSpace(spaceIndex);
 }
 
 /**
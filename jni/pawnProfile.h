@@ -0,0 +1,149 @@
+/**
+ * @file pawnProfile.h
+ *
+ * @brief Profil der Spielfigur, aus dem sie als Rotationskörper erzeugt wird.
+ *
+ * @details Diese Datei wurde von tools/meshBuilder.cpp aus media/pawnSource.h erzeugt und sollte
+ *      nicht von Hand bearbeitet werden.
+ */
+
+#ifndef PAWN_PROFILE_H
+#define PAWN_PROFILE_H
+
+/**
+ * Anzahl der Profil-Punkte.
+ */
+#define PAWN_PROFILE_POINT_COUNT 125
+
+/**
+ * Profil-Punkte (jeweils Radius und Höhe) vom unteren zum oberen Pol.
+ */
+static const float pawnProfile[] = {
+  0.00000000f, 5.26023250e-05f,
+  0.223560080f, 5.26023250e-05f,
+  0.232384682f, 0.0206436031f,
+  0.262261182f, 0.0425529219f,
+  0.265109986f, 0.0452396870f,
+  0.267143518f, 0.0484216660f,
+  0.268345922f, 0.0519337915f,
+  0.268701255f, 0.0556109808f,
+  0.268193543f, 0.0592883751f,
+  0.266806692f, 0.0628008023f,
+  0.264524817f, 0.0659832805f,
+  0.241209477f, 0.0912416056f,
+  0.270150602f, 0.137992546f,
+  0.272104144f, 0.141936526f,
+  0.273261726f, 0.146085635f,
+  0.273633718f, 0.150328636f,
+  0.273231030f, 0.154553950f,
+  0.272064239f, 0.158650264f,
+  0.270143926f, 0.162506044f,
+  0.267480761f, 0.166010112f,
+  0.254356414f, 0.179266632f,
+  0.241222262f, 0.191029534f,
+  0.228441432f, 0.201625243f,
+  0.216377333f, 0.211379915f,
+  0.205393344f, 0.220619962f,
+  0.195852816f, 0.229671568f,
+  0.188119113f, 0.238861099f,
+  0.182637826f, 0.247952491f,
+  0.179234728f, 0.256576866f,
+  0.177342758f, 0.264861792f,
+  0.176395386f, 0.272934377f,
+  0.175825745f, 0.280922115f,
+  0.175067142f, 0.288952231f,
+  0.173553094f, 0.297152191f,
+  0.147078872f, 0.297152191f,
+  0.142379597f, 0.311668128f,
+  0.143962070f, 0.314072460f,
+  0.145503670f, 0.316397935f,
+  0.146962866f, 0.318565756f,
+  0.148298785f, 0.320496887f,
+  0.149470314f, 0.322112620f,
+  0.150436357f, 0.323334008f,
+  0.151155829f, 0.324082226f,
+  0.153721273f, 0.326858312f,
+  0.155417800f, 0.330068052f,
+  0.156247601f, 0.333534569f,
+  0.156212196f, 0.337080926f,
+  0.155313388f, 0.340530157f,
+  0.153552756f, 0.343705356f,
+  0.150932252f, 0.346429616f,
+  0.135312676f, 0.358925343f,
+  0.120604672f, 0.367750078f,
+  0.0853056759f, 0.503062785f,
+  0.0764810741f, 0.632492304f,
+  0.147078872f, 0.632492304f,
+  0.145446256f, 0.638442636f,
+  0.144034639f, 0.644482434f,
+  0.142678276f, 0.650544643f,
+  0.141211405f, 0.656562090f,
+  0.139468282f, 0.662467599f,
+  0.137283310f, 0.668194115f,
+  0.134490758f, 0.673674405f,
+  0.130967528f, 0.679095566f,
+  0.126819789f, 0.684579611f,
+  0.122226089f, 0.689961851f,
+  0.117364399f, 0.695077658f,
+  0.112413220f, 0.699762404f,
+  0.107550740f, 0.703851402f,
+  0.102955274f, 0.707180023f,
+  0.0986193642f, 0.709537327f,
+  0.0943819657f, 0.710999370f,
+  0.0901911706f, 0.711831987f,
+  0.0859948695f, 0.712300897f,
+  0.0817413479f, 0.712671936f,
+  0.0773782954f, 0.713211000f,
+  0.0728538185f, 0.714183688f,
+  0.0724414811f, 0.716648877f,
+  0.0708741322f, 0.718615592f,
+  0.0686140656f, 0.720283389f,
+  0.0661227480f, 0.721851468f,
+  0.0638626665f, 0.723519266f,
+  0.0622953288f, 0.725486040f,
+  0.0618829913f, 0.727951169f,
+  0.0699568540f, 0.733122587f,
+  0.0786210075f, 0.738597095f,
+  0.0875354633f, 0.744381189f,
+  0.0963598713f, 0.750481665f,
+  0.104754247f, 0.756904960f,
+  0.112378024f, 0.763657749f,
+  0.118891232f, 0.770746589f,
+  0.124413222f, 0.778196514f,
+  0.129286528f, 0.786010087f,
+  0.133504659f, 0.794159949f,
+  0.137061715f, 0.802618921f,
+  0.139951602f, 0.811359763f,
+  0.142168418f, 0.820355296f,
+  0.143705875f, 0.829578161f,
+  0.144596219f, 0.839229047f,
+  0.144855782f, 0.849398792f,
+  0.144454241f, 0.859896123f,
+  0.143361181f, 0.870529532f,
+  0.141546667f, 0.881107509f,
+  0.138980433f, 0.891438723f,
+  0.135632008f, 0.901331604f,
+  0.131256178f, 0.911063433f,
+  0.125798091f, 0.920896769f,
+  0.119513184f, 0.930618227f,
+  0.112656847f, 0.940014422f,
+  0.105484337f, 0.948871851f,
+  0.0982512757f, 0.956977189f,
+  0.0912128612f, 0.964116871f,
+  0.0841172412f, 0.970270634f,
+  0.0766537189f, 0.975621164f,
+  0.0689888373f, 0.980260074f,
+  0.0612891577f, 0.984279096f,
+  0.0537216254f, 0.987769783f,
+  0.0464525707f, 0.990823865f,
+  0.0396491401f, 0.993532658f,
+  0.0334379524f, 0.995625317f,
+  0.0277132299f, 0.996929944f,
+  0.0222925097f, 0.997687101f,
+  0.0169933084f, 0.998137355f,
+  0.0116331419f, 0.998521268f,
+  0.00602955138f, 0.999079645f,
+  0.00000000f, 1.00005257f,
+};
+
+#endif
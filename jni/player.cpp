@@ -11,6 +11,7 @@
 #include <stdlib.h>
 
 #include "constants.h"
+#include "field.h"
 #include "invisibogaGlSurfaceView.h"
 #include "mathUtils.h"
 #include "pawn.h"
@@ -18,10 +19,6 @@
 #include "types.h"
 #include "utils.h"
 
-/*
- * Spielfeld (verwaltet in field.cpp).
- */
-extern Field field;
 
 /**
  * Initialisiert einen Spieler
@@ -84,7 +81,7 @@ void preparePawnMove(Player *player) {
 void prepareMove(Player *player) {
     LOGD("Prüfe, ob Ziel belegt ist");
     // Prüfung ob das Zielfeld belegt ist
-    if (field.spaces[player->targetSpaceIndex].occupied) {
+    if (isSpaceOccupied(player->targetSpaceIndex)) {
         // Ziel ist belegt
         LOGD("Ziel ist belegt");
         // Hinweis anzeigen
@@ -167,11 +164,11 @@ void processPlayerMove(Player *player, float timeIntervalSinceLastFrame) {
                         // Zug beendet
 
                         // Feld, auf dem der Spieler vor dem Zug stand, als frei markieren
-                        field.spaces[player->currentSpaceIndex].occupied = false;
+                        setSpaceOccupied(player->currentSpaceIndex, false);
                         // aktuellen Feld-Index aktualisieren
                         player->currentSpaceIndex = player->targetSpaceIndex;
                         // Feld, auf dem der Spieler jetzt steht, als besetzt markieren
-                        field.spaces[player->currentSpaceIndex].occupied = true;
+                        setSpaceOccupied(player->currentSpaceIndex, true);
                         // Zustand aktualisieren
                         player->state = PLAYER_STATE_POST_MOVING;
                     } else {
@@ -0,0 +1,360 @@
+/**
+ * @file pngDecoder.cpp
+ *
+ * @brief Dekodiert PNG-Dateien direkt in den Speicher, aus dem die Textur hochgeladen wird.
+ *
+ * @details Unterstützt werden nicht interlacte PNG-Dateien mit 8 Bit pro Kanal in allen
+ *      Farbtypen (Grau, RGB, Palette, Grau mit Alpha, RGBA). Die komprimierten Daten werden mit
+ *      zlib zeilenweise entpackt: Jede Zeile wird sofort entfiltert, nach RGBA umgesetzt und
+ *      dabei an der vertikal gespiegelten Position abgelegt, da OpenGL die erste Zeile unten
+ *      erwartet. Bei RGBA-Dateien wird direkt in die Ziel-Zeile entpackt und dort entfiltert, das
+ *      Bild wird also kein weiteres Mal kopiert. Die Prüfsummen der Chunks werden nicht geprüft,
+ *      die der komprimierten Daten prüft zlib.
+ *
+ *      Die Datei hängt nur von zlib ab, damit sie auch auf dem Entwicklungsrechner übersetzt
+ *      werden kann (siehe tools/pngBenchmark.cpp).
+ *
+ * @author Alexander Bertram
+ *
+ * @date 16.10.2026
+ */
+
+#include <stdlib.h>
+#include <string.h>
+
+#include <zlib.h>
+
+#include "pngDecoder.h"
+
+/**
+ * Signatur am Anfang jeder PNG-Datei.
+ */
+static const uint8_t PNG_SIGNATURE[8] = { 0x89, 'P', 'N', 'G', '\r', '\n', 0x1A, '\n' };
+/**
+ * Maximale Breite und Höhe in Pixeln. Schützt vor Überläufen bei beschädigten Dateien.
+ */
+#define PNG_MAX_DIMENSION 8192
+
+/**
+ * Farbtypen aus dem IHDR-Chunk.
+ */
+enum PngColorType {
+    PNG_GRAY = 0, PNG_RGB = 2, PNG_PALETTE = 3, PNG_GRAY_ALPHA = 4, PNG_RGBA = 6
+};
+
+/**
+ * @brief Zustand beim zeilenweisen Entpacken.
+ */
+typedef struct PngDecoder {
+    /**
+     * zlib-Strom der IDAT-Chunks.
+     */
+    z_stream stream;
+    /**
+     * Breite und Höhe in Pixeln.
+     */
+    uint32_t width, height;
+    /**
+     * Farbtyp (PngColorType).
+     */
+    int colorType;
+    /**
+     * Byte pro Pixel in der Datei.
+     */
+    uint32_t pixelSize;
+    /**
+     * Byte pro Zeile in der Datei (ohne Filter-Byte).
+     */
+    uint32_t rowSize;
+    /**
+     * Palette und Alpha-Werte der Palette (RGBA).
+     */
+    uint8_t palette[256][4];
+    /**
+     * Dekodiertes Bild (RGBA, erste Zeile unten).
+     */
+    uint8_t *pixels;
+    /**
+     * Zwei Zeilen der Datei für Farbtypen außer RGBA (aktuelle und vorherige), sonst NULL.
+     */
+    uint8_t *rows[2];
+    /**
+     * Nullzeile, die der ersten Zeile als vorherige Zeile dient.
+     */
+    uint8_t *zeroRow;
+    /**
+     * Index der Zeile, die gerade entpackt wird.
+     */
+    uint32_t row;
+    /**
+     * Bereits entpackte Byte der aktuellen Zeile einschließlich Filter-Byte.
+     */
+    uint32_t position;
+    /**
+     * Filter der aktuellen Zeile.
+     */
+    uint8_t filter;
+} PngDecoder;
+
+/**
+ * Liest eine vorzeichenlose 32-Bit-Zahl in Big-Endian-Byte-Reihenfolge.
+ *
+ * @param data Zeiger auf die Zahl.
+ * @return Die Zahl.
+ */
+static uint32_t readUint32(const uint8_t *data) {
+    return (uint32_t)data[0] << 24 | (uint32_t)data[1] << 16 | (uint32_t)data[2] << 8 | data[3];
+}
+
+/**
+ * Gibt die Ziel-Zeile im dekodierten Bild zurück (vertikal gespiegelt).
+ *
+ * @param decoder Der Zustand.
+ * @param row Index der Zeile in der Datei.
+ * @return Die Ziel-Zeile.
+ */
+static uint8_t* targetRow(PngDecoder *decoder, uint32_t row) {
+    return decoder->pixels + (size_t)(decoder->height - 1 - row) * decoder->width * 4;
+}
+
+/**
+ * Gibt die Zeile zurück, in die die Datei-Zeile entpackt wird. Bei RGBA ist das die Ziel-Zeile.
+ *
+ * @param decoder Der Zustand.
+ * @param row Index der Zeile in der Datei.
+ * @return Die Zeile.
+ */
+static uint8_t* fileRow(PngDecoder *decoder, uint32_t row) {
+    return decoder->colorType == PNG_RGBA ? targetRow(decoder, row) : decoder->rows[row & 1];
+}
+
+/**
+ * Paeth-Prädiktor der PNG-Spezifikation.
+ */
+static uint8_t paeth(int a, int b, int c) {
+    int p = a + b - c;
+    int pa = abs(p - a);
+    int pb = abs(p - b);
+    int pc = abs(p - c);
+    return (uint8_t)(pa <= pb && pa <= pc ? a : pb <= pc ? b : c);
+}
+
+/**
+ * Macht den Filter einer Zeile rückgängig.
+ *
+ * @param filter Filter der Zeile.
+ * @param row Die Zeile, wird überschrieben.
+ * @param previous Die vorherige, bereits entfilterte Zeile.
+ * @param size Größe der Zeile in Byte.
+ * @param pixelSize Byte pro Pixel.
+ * @return false bei unbekanntem Filter.
+ */
+static bool unfilterRow(uint8_t filter, uint8_t *row, const uint8_t *previous, uint32_t size,
+        uint32_t pixelSize) {
+    switch (filter) {
+    case 0:
+        return true;
+    case 1:
+        for (uint32_t i = pixelSize; i < size; ++i) {
+            row[i] += row[i - pixelSize];
+        }
+        return true;
+    case 2:
+        for (uint32_t i = 0; i < size; ++i) {
+            row[i] += previous[i];
+        }
+        return true;
+    case 3:
+        for (uint32_t i = 0; i < size; ++i) {
+            int left = i >= pixelSize ? row[i - pixelSize] : 0;
+            row[i] += (uint8_t)((left + previous[i]) >> 1);
+        }
+        return true;
+    case 4:
+        for (uint32_t i = 0; i < size; ++i) {
+            int left = i >= pixelSize ? row[i - pixelSize] : 0;
+            int upperLeft = i >= pixelSize ? previous[i - pixelSize] : 0;
+            row[i] += paeth(left, previous[i], upperLeft);
+        }
+        return true;
+    default:
+        return false;
+    }
+}
+
+/**
+ * Schließt eine vollständig entpackte Zeile ab: Filter rückgängig machen und, falls nötig, nach
+ * RGBA umsetzen.
+ *
+ * @param decoder Der Zustand.
+ * @return false bei ungültigen Daten.
+ */
+static bool finishRow(PngDecoder *decoder) {
+    uint8_t *row = fileRow(decoder, decoder->row);
+    const uint8_t *previous = decoder->row > 0 ? fileRow(decoder, decoder->row - 1)
+            : decoder->zeroRow;
+    if (!unfilterRow(decoder->filter, row, previous, decoder->rowSize, decoder->pixelSize)) {
+        return false;
+    }
+    uint8_t *target = targetRow(decoder, decoder->row);
+    for (uint32_t x = 0; x < decoder->width && decoder->colorType != PNG_RGBA; ++x) {
+        const uint8_t *source = row + x * decoder->pixelSize;
+        uint8_t *pixel = target + x * 4;
+        switch (decoder->colorType) {
+        case PNG_GRAY:
+            pixel[0] = pixel[1] = pixel[2] = source[0];
+            pixel[3] = 255;
+            break;
+        case PNG_RGB:
+            pixel[0] = source[0];
+            pixel[1] = source[1];
+            pixel[2] = source[2];
+            pixel[3] = 255;
+            break;
+        case PNG_PALETTE:
+            memcpy(pixel, decoder->palette[source[0]], 4);
+            break;
+        case PNG_GRAY_ALPHA:
+            pixel[0] = pixel[1] = pixel[2] = source[0];
+            pixel[3] = source[1];
+            break;
+        }
+    }
+    ++decoder->row;
+    return true;
+}
+
+/**
+ * Entpackt die Daten eines IDAT-Chunks zeilenweise.
+ *
+ * @param decoder Der Zustand.
+ * @param data Daten des Chunks.
+ * @param size Größe der Daten in Byte.
+ * @return false bei ungültigen Daten.
+ */
+static bool inflateRows(PngDecoder *decoder, const uint8_t *data, uint32_t size) {
+    z_stream &stream = decoder->stream;
+    stream.next_in = (Bytef*)data;
+    stream.avail_in = size;
+    // zlib kann entpackte Daten zurückhalten, deshalb wird auch ohne neue Eingabe weiter entpackt,
+    // solange dabei noch Daten entstehen
+    while (decoder->row < decoder->height) {
+        // erst das Filter-Byte, dann den Rest der Zeile entpacken
+        uInt available;
+        if (decoder->position == 0) {
+            stream.next_out = &decoder->filter;
+            available = 1;
+        } else {
+            stream.next_out = fileRow(decoder, decoder->row) + decoder->position - 1;
+            available = decoder->rowSize + 1 - decoder->position;
+        }
+        stream.avail_out = available;
+        int result = inflate(&stream, Z_NO_FLUSH);
+        if (result != Z_OK && result != Z_STREAM_END && result != Z_BUF_ERROR) {
+            return false;
+        }
+        uInt produced = available - stream.avail_out;
+        decoder->position += produced;
+        if (decoder->position == decoder->rowSize + 1) {
+            decoder->position = 0;
+            if (!finishRow(decoder)) {
+                return false;
+            }
+        }
+        if (result == Z_STREAM_END || produced == 0) {
+            break;
+        }
+    }
+    return true;
+}
+
+/**
+ * Dekodiert eine PNG-Datei nach RGBA mit 8 Bit pro Kanal. Die erste Zeile des Ergebnisses ist die
+ * unterste Zeile des Bildes.
+ *
+ * @param data Inhalt der PNG-Datei.
+ * @param size Größe der Datei in Byte.
+ * @param width Erhält die Breite in Pixeln.
+ * @param height Erhält die Höhe in Pixeln.
+ * @param pixels Erhält das mit new[] angelegte Bild oder NULL, wenn die Datei nicht dekodiert
+ *      werden konnte.
+ * @return true, wenn die Datei dekodiert wurde.
+ */
+bool decodePng(const uint8_t *data, size_t size, uint32_t *width, uint32_t *height,
+        uint8_t **pixels) {
+    *pixels = NULL;
+    if (size < sizeof(PNG_SIGNATURE) || memcmp(data, PNG_SIGNATURE, sizeof(PNG_SIGNATURE)) != 0) {
+        return false;
+    }
+    PngDecoder decoder;
+    memset(&decoder, 0, sizeof(PngDecoder));
+    if (inflateInit(&decoder.stream) != Z_OK) {
+        return false;
+    }
+    bool valid = true;
+    bool headerRead = false;
+    size_t offset = sizeof(PNG_SIGNATURE);
+    while (valid && offset + 12 <= size) {
+        uint32_t chunkSize = readUint32(data + offset);
+        const uint8_t *type = data + offset + 4;
+        const uint8_t *chunk = data + offset + 8;
+        if (chunkSize > size - offset - 12) {
+            valid = false;
+            break;
+        }
+        offset += 12 + chunkSize;
+        if (memcmp(type, "IHDR", 4) == 0 && chunkSize >= 13 && !headerRead) {
+            decoder.width = readUint32(chunk);
+            decoder.height = readUint32(chunk + 4);
+            decoder.colorType = chunk[9];
+            static const uint32_t CHANNEL_COUNTS[7] = { 1, 0, 3, 1, 2, 0, 4 };
+            // nur 8 Bit pro Kanal, Standard-Kompression und -Filter, kein Interlacing
+            if (decoder.width == 0 || decoder.height == 0 || decoder.width > PNG_MAX_DIMENSION
+                    || decoder.height > PNG_MAX_DIMENSION || chunk[8] != 8
+                    || decoder.colorType > PNG_RGBA || CHANNEL_COUNTS[decoder.colorType] == 0
+                    || chunk[10] != 0 || chunk[11] != 0 || chunk[12] != 0) {
+                valid = false;
+                break;
+            }
+            decoder.pixelSize = CHANNEL_COUNTS[decoder.colorType];
+            decoder.rowSize = decoder.width * decoder.pixelSize;
+            decoder.pixels = new uint8_t[(size_t)decoder.width * decoder.height * 4];
+            decoder.zeroRow = (uint8_t*)calloc(decoder.rowSize, 1);
+            if (decoder.colorType != PNG_RGBA) {
+                decoder.rows[0] = (uint8_t*)malloc(decoder.rowSize);
+                decoder.rows[1] = (uint8_t*)malloc(decoder.rowSize);
+            }
+            // fehlende Palette-Einträge sind schwarz, fehlende Alpha-Werte deckend
+            for (int i = 0; i < 256; ++i) {
+                decoder.palette[i][3] = 255;
+            }
+            headerRead = true;
+        } else if (!headerRead) {
+            valid = false;
+        } else if (memcmp(type, "PLTE", 4) == 0) {
+            for (uint32_t i = 0; i < chunkSize / 3 && i < 256; ++i) {
+                memcpy(decoder.palette[i], chunk + i * 3, 3);
+            }
+        } else if (memcmp(type, "tRNS", 4) == 0 && decoder.colorType == PNG_PALETTE) {
+            for (uint32_t i = 0; i < chunkSize && i < 256; ++i) {
+                decoder.palette[i][3] = chunk[i];
+            }
+        } else if (memcmp(type, "IDAT", 4) == 0) {
+            valid = inflateRows(&decoder, chunk, chunkSize);
+        } else if (memcmp(type, "IEND", 4) == 0) {
+            break;
+        }
+    }
+    inflateEnd(&decoder.stream);
+    free(decoder.zeroRow);
+    free(decoder.rows[0]);
+    free(decoder.rows[1]);
+    if (!valid || !headerRead || decoder.row != decoder.height) {
+        delete[] decoder.pixels;
+        return false;
+    }
+    *width = decoder.width;
+    *height = decoder.height;
+    *pixels = decoder.pixels;
+    return true;
+}
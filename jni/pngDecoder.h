@@ -0,0 +1,19 @@
+/**
+ * @file pngDecoder.h
+ *
+ * @brief Schnittstelle zu pngDecoder.cpp.
+ *
+ * @author Alexander Bertram
+ *
+ * @date 16.10.2026
+ */
+
+#ifndef PNG_DECODER_H
+#define PNG_DECODER_H
+
+#include <stddef.h>
+#include <stdint.h>
+
+bool decodePng(const uint8_t*, size_t, uint32_t*, uint32_t*, uint8_t**);
+
+#endif
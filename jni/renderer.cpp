@@ -8,12 +8,22 @@
  * @date 17.09.2011
  */
 
+#include <math.h>
+#include <stddef.h>
+#include <stdlib.h>
+#include <string.h>
+
 #include <GLES/gl.h>
 #include <GLES/glext.h>
 
+#include <QCAR/Renderer.h>
+#include <QCAR/VideoBackgroundConfig.h>
+
 #include "constants.h"
+#include "field.h"
+#include "glState.h"
 #include "mathUtils.h"
-#include "pawn.h"
+#include "shaderRenderer.h"
 #include "Texture.h"
 #include "types.h"
 #include "utils.h"
@@ -35,146 +45,661 @@ extern Player players[];
  */
 extern QCAR::Matrix44F projectionMatrix;
 /*
- * Spielfeld (verwaltet in game.cpp).
+ * Texturen (verwaltet in invisiboga.cpp).
+ */
+extern Texture *textures[];
+/*
+ * Bereiche der Feld-Texturen im Textur-Atlas (verwaltet in invisiboga.cpp).
  */
-extern Field field;
+extern TextureAtlasRegion spaceTextureRegions[];
 /*
- * Texturen (verwaltet in invisiboga.cpp).
+ * Model der Spielfigur (verwaltet in invisiboga.cpp).
+ */
+extern Mesh pawnMesh;
+/*
+ * Touch-Ereignis (verwaltet in invisiboga.cpp).
+ */
+extern TouchEvent touchEvent;
+/**
+ * Namen der Vertex-Buffer-Objekte, in denen die statische Geometrie abgelegt ist.
+ */
+static GLuint vertexBufferObjects[VERTEX_BUFFER_OBJECT_COUNT];
+/**
+ * Speicher für fieldVertices, solange das Spielfeld höchstens SPACE_CHUNK_SIZE Felder hat.
+ */
+static FieldVertex inlineFieldVertices[SPACE_CHUNK_SIZE * SPACE_VERTEX_COUNT];
+/**
+ * Speicher für fieldIndices, solange das Spielfeld höchstens SPACE_CHUNK_SIZE Felder hat.
+ */
+static GLushort inlineFieldIndices[SPACE_CHUNK_SIZE * SPACE_INDEX_COUNT];
+/**
+ * Speicher für spaceVisible, solange das Spielfeld höchstens SPACE_CHUNK_SIZE Felder hat.
+ */
+static bool inlineSpaceVisible[SPACE_CHUNK_SIZE];
+/**
+ * Vertices des Spielfeldes, jeweils SPACE_VERTEX_COUNT pro Feld in der Reihenfolge der Felder.
+ */
+static FieldVertex *fieldVertices = inlineFieldVertices;
+/**
+ * Indizes der Dreiecke der sichtbaren Felder.
+ */
+static GLushort *fieldIndices = inlineFieldIndices;
+/**
+ * Anzahl der Indizes der sichtbaren Felder.
+ */
+static GLsizei fieldIndexCount = 0;
+/**
+ * Flags, die anzeigen, ob ein Feld im letzten Frame im Sichtbereich lag.
+ */
+static bool *spaceVisible = inlineSpaceVisible;
+/**
+ * Anzahl der Felder, für die in fieldVertices, fieldIndices und spaceVisible Platz ist.
+ */
+static int fieldCapacity = SPACE_CHUNK_SIZE;
+/**
+ * Anzahl der Felder, deren Vertices zuletzt aufgebaut wurden.
+ */
+static int fieldSpaceCount = 0;
+/**
+ * Flag, das anzeigt, ob die Indizes der sichtbaren Felder neu aufgebaut werden müssen.
+ */
+static bool fieldIndicesDirty = true;
+/**
+ * Model-View-Projektionsmatrix des aktuellen Frames.
+ */
+static QCAR::Matrix44F modelViewProjectionMatrix;
+/**
+ * Sichtbereich des aktuellen Frames in Koordinaten des Trackables.
+ */
+static Frustum frustum;
+/**
+ * Model-View-Matrix des letzten vorbereiteten Frames.
+ */
+static QCAR::Matrix44F lastModelViewMatrix;
+/**
+ * Positionen der Spielfiguren im letzten vorbereiteten Frame.
+ */
+static QCAR::Vec2F lastPawnPositions[PLAYER_COUNT];
+/**
+ * Spiel-Zustand im letzten vorbereiteten Frame.
+ */
+static int lastGameState;
+/**
+ * Flag, das anzeigt, ob es einen vorbereiteten Frame gibt, dessen Sichtbarkeiten, Detailstufen
+ * und Matrizen wiederverwendet werden können.
+ */
+static bool lastFrameValid = false;
+/**
+ * Flag, das anzeigt, ob mit Shadern (OpenGL ES 2.0) statt mit der festen Funktions-Pipeline
+ * (OpenGL ES 1.1) gerendert wird.
  */
-extern Texture **textures;
+static bool useShaders = false;
+/**
+ * Render-Statistik seit der letzten Ausgabe.
+ */
+RenderStatistics renderStatistics;
 
 /**
- * Rendert ein Feld.
+ * Gibt an, ob mit Shadern gerendert wird. Gültig nach initRenderer().
  *
- * @param space Das zu rendernde Feld.
+ * @return true bei OpenGL ES 2.0, false bei OpenGL ES 1.1.
  */
-void renderSpace(Space space) {
-    // Textur-ID anhand des Feld-Typen bestimmen und an das Ziel binden
-    glBindTexture(GL_TEXTURE_2D, textures[space.type]->mTextureID);
-    // Transformationsmatrix mit der Identitätsmatrix initialisieren und Translation, Skalierung und
-    // Rotation reinrechnen
-    QCAR::Matrix44F transform = matrix44FIdentity();
-    translatePoseMatrix(space.position.data[0], space.position.data[1], 0.0f, &transform.data[0]);
-    scalePoseMatrix(SPACE_RADIUS, SPACE_RADIUS, SPACE_RADIUS, &transform.data[0]);
-    rotatePoseMatrix(space.angle, 0, 0, 1, &transform.data[0]);
-    // aktuelle Matrix sichern
-    glPushMatrix();
-    // Transformationsmatrix anwenden
-    glMultMatrixf(&transform.data[0]);
-    // Feld rendern
-    glDrawArrays(GL_TRIANGLE_STRIP, 0, 4);
-    // gesicherte Matrix wiederherstellen
-    glPopMatrix();
+bool usesShaders() {
+    return useShaders;
 }
 
 /**
- * Rendert das Spielfeld.
+ * Lädt Daten in ein Vertex-Buffer-Objekt.
  *
- * Jedes Feld wird mit Hilfe eines transparenten Quadrates mit einer überlagerten Textur gerendert.
+ * @param target Ziel, an das der Buffer gebunden wird (GL_ARRAY_BUFFER oder
+ *      GL_ELEMENT_ARRAY_BUFFER).
+ * @param vertexBufferObject Vertex-Buffer-Objekt, in das die Daten geladen werden sollen.
+ * @param size Größe der Daten in Bytes.
+ * @param data Die zu ladenden Daten.
+ */
+static void uploadVertexBufferObject(GLenum target, VertexBufferObject vertexBufferObject,
+        GLsizeiptr size, const GLvoid *data) {
+    bindGlBuffer(target, vertexBufferObjects[vertexBufferObject]);
+    glBufferData(target, size, data, GL_STATIC_DRAW);
+}
+
+/**
+ * Initialisiert den Renderer. Die statische Geometrie wird einmalig in Vertex-Buffer-Objekte im
+ * Grafikspeicher geladen, damit sie nicht bei jedem Zeichenaufruf aus dem Hauptspeicher kopiert
+ * werden muss.
+ *
+ * Die Render-Pipeline wird anhand der Version des GL-Kontextes gewählt: Mit OpenGL ES 2.0 wird mit
+ * Shadern gerendert (shaderRenderer.cpp), mit OpenGL ES 1.1 mit der festen Funktions-Pipeline.
+ *
+ * Muss nach jedem (Neu-)Erzeugen des GL-Kontextes aufgerufen werden, weil die Vertex-Buffer-Objekte
+ * mit dem alten Kontext verloren gehen. Die alten Namen werden deshalb nicht freigegeben, sondern
+ * einfach neu erzeugt.
+ */
+void initRenderer() {
+    // OpenGL ES 1.x meldet sich als "OpenGL ES-CM 1.x", OpenGL ES 2.0 als "OpenGL ES 2.0"
+    const char *version = (const char*)glGetString(GL_VERSION);
+    useShaders = version != NULL && strncmp(version, "OpenGL ES-", 10) != 0;
+    LOGD("initRenderer: %s", version);
+    // der GL-Zustand des neuen Kontextes ist unbekannt
+    resetGlState();
+    // Shader-Programme erzeugen
+    if (useShaders && !initShaderRenderer()) {
+        LOGE("initRenderer: shader programs could not be created");
+    }
+    glGenBuffers(VERTEX_BUFFER_OBJECT_COUNT, vertexBufferObjects);
+    // Spielfigur (direkt aus der in den Speicher abgebildeten Model-Datei)
+    if (pawnMesh.header != NULL) {
+        uploadVertexBufferObject(GL_ARRAY_BUFFER, PAWN_VERTEX_BUFFER,
+                pawnMesh.header->vertexCount * sizeof(MeshVertex), pawnMesh.vertices);
+        uploadVertexBufferObject(GL_ELEMENT_ARRAY_BUFFER, PAWN_INDEX_BUFFER,
+                pawnMesh.header->indexCount * sizeof(GLushort), pawnMesh.indices);
+    }
+    // Spielfeld beim nächsten Rendern neu in den Grafikspeicher laden
+    field.dirty = true;
+    // Buffer lösen, damit QCAR beim Rendern des Video-Hintergrundes nicht darauf zugreift
+    bindGlBuffer(GL_ARRAY_BUFFER, 0);
+    bindGlBuffer(GL_ELEMENT_ARRAY_BUFFER, 0);
+    // Prüfung, ob ein GL-Fehler aufgetreten ist
+    checkGlError("initRenderer");
+}
+
+/**
+ * Gibt den angeforderten Speicher für die Render-Daten des Spielfeldes frei.
+ */
+void releaseFieldRenderData() {
+    if (fieldVertices != inlineFieldVertices) {
+        free(fieldVertices);
+        free(fieldIndices);
+        free(spaceVisible);
+    }
+    fieldVertices = inlineFieldVertices;
+    fieldIndices = inlineFieldIndices;
+    spaceVisible = inlineSpaceVisible;
+    fieldCapacity = SPACE_CHUNK_SIZE;
+    fieldSpaceCount = 0;
+    memset(spaceVisible, 0, sizeof(inlineSpaceVisible));
+}
+
+/**
+ * Stellt sicher, dass die Render-Daten des Spielfeldes Platz für eine Anzahl von Feldern haben.
+ * Die Kapazität wird dabei verdoppelt, bis sie ausreicht.
+ *
+ * @param spaceCount Anzahl der Felder.
+ * @return false, wenn kein Speicher angefordert werden konnte. Die Render-Daten bleiben dann
+ *      unverändert.
+ */
+static bool reserveFieldRenderData(int spaceCount) {
+    if (spaceCount <= fieldCapacity) {
+        return true;
+    }
+    int capacity = fieldCapacity;
+    while (capacity < spaceCount) {
+        capacity *= 2;
+    }
+    FieldVertex *vertices = (FieldVertex*)malloc(
+            capacity * SPACE_VERTEX_COUNT * sizeof(FieldVertex));
+    GLushort *indices = (GLushort*)malloc(capacity * SPACE_INDEX_COUNT * sizeof(GLushort));
+    bool *visible = (bool*)malloc(capacity * sizeof(bool));
+    if (vertices == NULL || indices == NULL || visible == NULL) {
+        LOGE("reserveFieldRenderData: could not allocate render data for %d spaces", capacity);
+        free(vertices);
+        free(indices);
+        free(visible);
+        return false;
+    }
+    // die Vertices und Indizes werden ohnehin neu aufgebaut, nur die Sichtbarkeit wird übernommen
+    memcpy(visible, spaceVisible, fieldCapacity * sizeof(bool));
+    memset(visible + fieldCapacity, 0, (capacity - fieldCapacity) * sizeof(bool));
+    int spaceCountBefore = fieldSpaceCount;
+    releaseFieldRenderData();
+    fieldVertices = vertices;
+    fieldIndices = indices;
+    spaceVisible = visible;
+    fieldCapacity = capacity;
+    fieldSpaceCount = spaceCountBefore;
+    return true;
+}
+
+/**
+ * Baut die Vertices des gesamten Spielfeldes auf und lädt sie in den Grafikspeicher.
+ *
+ * Die Ecken jedes Feldes werden dabei bereits um das Feld gedreht, skaliert und verschoben, und die
+ * Textur-Koordinaten auf den Bereich des Feld-Typen im Textur-Atlas abgebildet, so dass das ganze
+ * Spielfeld ohne Matrix- und Textur-Wechsel mit einem Zeichenaufruf gerendert werden kann.
+ */
+static void buildField() {
+    LOGD("buildField: %d spaces", field.length);
+    // reicht der Speicher nicht, werden nur die Felder gerendert, für die Platz ist
+    fieldSpaceCount = reserveFieldRenderData(field.length) ? field.length : fieldCapacity;
+    int vertexCount = 0;
+    for (int i = 0; i < fieldSpaceCount; ++i) {
+        const Space &space = *getSpace(i);
+        const TextureAtlasRegion &region = spaceTextureRegions[space.type];
+        // zwischengespeicherte Rotation und Skalierung des Feldes
+        const float *m = space.rotationScale;
+        // Ecken des Feldes
+        for (int corner = 0; corner < SPACE_VERTEX_COUNT; ++corner) {
+            float x = UNIT_SQUARE_VERTICES[corner * 3];
+            float y = UNIT_SQUARE_VERTICES[corner * 3 + 1];
+            FieldVertex &vertex = fieldVertices[vertexCount++];
+            vertex.position[0] = space.position.data[0] + m[0] * x + m[2] * y;
+            vertex.position[1] = space.position.data[1] + m[1] * x + m[3] * y;
+            for (int k = 0; k < 2; ++k) {
+                vertex.textureCoordinate[k] = region.offset[k]
+                        + region.scale[k] * UNIT_SQUARE_TEXTURE_COORDINATES[corner * 2 + k];
+            }
+        }
+    }
+    bindGlBuffer(GL_ARRAY_BUFFER, vertexBufferObjects[FIELD_VERTEX_BUFFER]);
+    glBufferData(GL_ARRAY_BUFFER, vertexCount * sizeof(FieldVertex), fieldVertices,
+            GL_DYNAMIC_DRAW);
+    field.dirty = false;
+    fieldIndicesDirty = true;
+}
+
+/**
+ * Bestimmt die Felder im Sichtbereich und baut die Indizes ihrer Dreiecke auf.
+ *
+ * Jedes Feld wird durch einen Kreis mit dem Radius SPACE_RADIUS begrenzt, die Ecken der Quadrate
+ * sind transparent. Die Indizes werden nur neu in den Grafikspeicher geladen, wenn sich die Menge
+ * der sichtbaren Felder geändert hat.
  */
-void renderField() {
-    // Textur-Koordinaten werden verwendet
-    glEnableClientState(GL_TEXTURE_COORD_ARRAY);
+static void cullField() {
+    for (int i = 0; i < fieldSpaceCount; ++i) {
+        const Space &space = *getSpace(i);
+        bool visible = isSphereInFrustum(&frustum, space.position.data[0],
+                space.position.data[1], 0.f, SPACE_RADIUS);
+        if (visible != spaceVisible[i]) {
+            spaceVisible[i] = visible;
+            fieldIndicesDirty = true;
+        }
+    }
+    if (!fieldIndicesDirty) {
+        return;
+    }
+    fieldIndexCount = 0;
+    for (int i = 0; i < fieldSpaceCount; ++i) {
+        if (!spaceVisible[i]) {
+            continue;
+        }
+        // zwei Dreiecke pro Feld
+        for (int j = 0; j < SPACE_INDEX_COUNT; ++j) {
+            fieldIndices[fieldIndexCount++] = i * SPACE_VERTEX_COUNT
+                    + UNIT_SQUARE_TRIANGLE_CORNERS[j];
+        }
+    }
+    bindGlBuffer(GL_ELEMENT_ARRAY_BUFFER, vertexBufferObjects[FIELD_INDEX_BUFFER]);
+    glBufferData(GL_ELEMENT_ARRAY_BUFFER, fieldIndexCount * sizeof(GLushort), fieldIndices,
+            GL_DYNAMIC_DRAW);
+    fieldIndicesDirty = false;
+}
+
+/**
+ * Rendert das Spielfeld mit der festen Funktions-Pipeline.
+ *
+ * @param texture Textur-Atlas der Felder.
+ */
+static void renderFieldWithFixedFunctions(GLuint texture) {
+    // Normale werden nicht verwendet, dafür Textur-Koordinaten
+    setGlClientState(GL_NORMAL_ARRAY, false);
+    setGlClientState(GL_TEXTURE_COORD_ARRAY, true);
     // Blending für Transparenz notwendig
-    glEnable(GL_BLEND);
+    setGlCapability(GL_BLEND, true);
     // 2D-Texturen werden verwendet
-    glEnable(GL_TEXTURE_2D);
+    setGlCapability(GL_TEXTURE_2D, true);
     // Tiefentest aus, damit die Ecken der Qudrate Teile der benachbarten Felder nicht verdecken
-    glDisable(GL_DEPTH_TEST);
+    setGlCapability(GL_DEPTH_TEST, false);
     // Licht nicht nötig, es werden Texturen verwendet
-    glDisable(GL_LIGHTING);
+    setGlCapability(GL_LIGHTING, false);
     // Transparenz aktivieren
-    glBlendFunc(GL_SRC_ALPHA, GL_ONE_MINUS_SRC_ALPHA);
-    // Vertices setzen
-    glVertexPointer(3, GL_FLOAT, 0, &UNIT_SQUARE_VERTICES[0]);
-    // Normale setzen
-    glNormalPointer(GL_FLOAT, 0, &UNIT_SQUARE_NORMALS[0]);
-    // Textur-Koordinaten setzen
-    glTexCoordPointer(2, GL_FLOAT, 0, &UNIT_SQUARE_TEXTURE_COORDINATES[0]);
-    // Spielfeld rendern
-    for (int i = 0; i < field.length; i++) {
-        renderSpace(field.spaces[i]);
+    setGlBlendFunction(GL_SRC_ALPHA, GL_ONE_MINUS_SRC_ALPHA);
+    // Vertices und Textur-Koordinaten setzen, beide liegen verschränkt im selben Buffer
+    bindGlBuffer(GL_ARRAY_BUFFER, vertexBufferObjects[FIELD_VERTEX_BUFFER]);
+    setGlVertexPointer(2, GL_FLOAT, sizeof(FieldVertex),
+            (GLvoid*)offsetof(FieldVertex, position));
+    setGlTexCoordPointer(2, GL_FLOAT, sizeof(FieldVertex),
+            (GLvoid*)offsetof(FieldVertex, textureCoordinate));
+    // Indizes der sichtbaren Felder setzen
+    bindGlBuffer(GL_ELEMENT_ARRAY_BUFFER, vertexBufferObjects[FIELD_INDEX_BUFFER]);
+    // Textur-Atlas der Felder binden
+    bindGlTexture(texture);
+    // Spielfeld mit einem Zeichenaufruf rendern
+    glDrawElements(GL_TRIANGLES, fieldIndexCount, GL_UNSIGNED_SHORT, 0);
+}
+
+/**
+ * Rendert das Spielfeld.
+ *
+ * Jedes Feld wird mit Hilfe eines transparenten Quadrates mit einer überlagerten Textur gerendert.
+ * Die Vertices werden nur neu aufgebaut, wenn sich das Spielfeld geändert hat. Felder außerhalb des
+ * Sichtbereiches werden nicht gerendert.
+ *
+ * @param prepare Flag, das anzeigt, ob die Sichtbarkeit der Felder neu bestimmt werden muss, oder
+ *      die des letzten vorbereiteten Frames wiederverwendet werden kann.
+ */
+void renderField(bool prepare) {
+    // der Textur-Atlas wird im Hintergrund geladen, bis dahin gibt es auch keine Bereiche der
+    // Kacheln für die Textur-Koordinaten
+    if (textures[SPACE_TEXTURE_ATLAS] == NULL) {
+        return;
+    }
+    // Spielfeld bei Änderungen neu aufbauen
+    if (field.dirty) {
+        buildField();
+    }
+    // Felder außerhalb des Sichtbereiches aussortieren
+    if (prepare) {
+        cullField();
+    }
+    int visibleSpaceCount = fieldIndexCount / SPACE_INDEX_COUNT;
+    renderStatistics.visibleSpaceCount += visibleSpaceCount;
+    renderStatistics.culledSpaceCount += field.length - visibleSpaceCount;
+    if (fieldIndexCount == 0) {
+        return;
+    }
+    GLuint texture = textures[SPACE_TEXTURE_ATLAS]->mTextureID;
+    if (useShaders) {
+        renderFieldWithShaders(modelViewProjectionMatrix, texture,
+                textures[SPACE_TEXTURE_ATLAS]->mAlphaTextureID,
+                vertexBufferObjects[FIELD_VERTEX_BUFFER], vertexBufferObjects[FIELD_INDEX_BUFFER],
+                fieldIndexCount);
+    } else {
+        renderFieldWithFixedFunctions(texture);
     }
+    ++renderStatistics.drawCallCount;
+}
+
+/**
+ * Berechnet die Größe einer Spielfigur auf dem Bildschirm in Pixeln, also den projizierten
+ * Durchmesser ihrer Umkugel.
+ *
+ * @param pawn Die Spielfigur.
+ * @param viewportHeight Höhe des Viewports in Pixeln.
+ * @return Größe der Spielfigur auf dem Bildschirm in Pixeln.
+ */
+float projectedPawnSize(Pawn *pawn, float viewportHeight) {
+    // Mittelpunkt der Umkugel wie in preparePawn() in Augen-Koordinaten transformieren
+    const float *boundingSphere = pawnMesh.boundingSphere;
+    const float center[4] = { pawn->position.data[0] + PAWN_SCALE_FACTOR * boundingSphere[0],
+        pawn->position.data[1] + PAWN_SCALE_FACTOR * boundingSphere[1],
+        PAWN_SCALE_FACTOR * boundingSphere[2], 1.f };
+    float eye[4];
+    for (int i = 0; i < 4; ++i) {
+        eye[i] = 0.f;
+        for (int j = 0; j < 4; ++j) {
+            eye[i] += modelViewMatrix.data[j * 4 + i] * center[j];
+        }
+    }
+    // w-Komponente in Clip-Koordinaten entspricht der Entfernung zum Betrachter
+    float w = 0.f;
+    for (int j = 0; j < 4; ++j) {
+        w += projectionMatrix.data[j * 4 + 3] * eye[j];
+    }
+    if (fabs(w) < 1e-6f) {
+        return viewportHeight;
+    }
+    float diameter = 2.f * PAWN_SCALE_FACTOR * boundingSphere[3];
+    return diameter * fabs(projectionMatrix.data[5] / w) * viewportHeight / 2.f;
+}
+
+/**
+ * Wählt die Detailstufe einer Spielfigur anhand ihrer Größe auf dem Bildschirm.
+ *
+ * Die Detailstufe wird erst gewechselt, wenn die Größe den Schwellwert um mehr als
+ * PAWN_LEVEL_OF_DETAIL_HYSTERESIS über- bzw. unterschreitet, damit die Detailstufe nicht bei jedem
+ * Frame hin und her springt.
+ *
+ * @param pawn Die Spielfigur, deren Detailstufe aktualisiert wird.
+ * @param size Größe der Spielfigur auf dem Bildschirm in Pixeln (siehe projectedPawnSize()).
+ */
+void selectPawnLevelOfDetail(Pawn *pawn, float size) {
+    int levelOfDetail = pawn->levelOfDetail;
+    // Schwellwert zwischen Detailstufe i und i + 1: PAWN_LEVEL_OF_DETAIL_SCREEN_SIZE / 2^i
+    while (levelOfDetail > 0 && size > PAWN_LEVEL_OF_DETAIL_SCREEN_SIZE
+            / (1 << (levelOfDetail - 1)) * (1.f + PAWN_LEVEL_OF_DETAIL_HYSTERESIS)) {
+        --levelOfDetail;
+    }
+    while (levelOfDetail < (int)pawnMesh.header->levelOfDetailCount - 1 && size
+            < PAWN_LEVEL_OF_DETAIL_SCREEN_SIZE / (1 << levelOfDetail)
+                    * (1.f - PAWN_LEVEL_OF_DETAIL_HYSTERESIS)) {
+        ++levelOfDetail;
+    }
+    pawn->levelOfDetail = levelOfDetail;
 }
 
 /**
  * Rendert eine Spielfigur.
  *
- * @param pawn Die zu rendernde Spielfigur.
+ * Bestimmt Sichtbarkeit, Detailstufe und Model-View-Matrix einer Spielfigur.
+ *
+ * @param pawn Die Spielfigur.
+ * @param viewportHeight Höhe des Viewports in Pixeln (für die Wahl der Detailstufe).
  */
-void renderPawn(Pawn *pawn) {
-    // Lichtkomponenten setzen
-    glLightfv(GL_LIGHT0, GL_AMBIENT, pawn->light.ambient);
-    glLightfv(GL_LIGHT0, GL_DIFFUSE, pawn->light.diffuse);
-    glLightfv(GL_LIGHT0, GL_SPECULAR, pawn->light.specular);
+static void preparePawn(Pawn *pawn, float viewportHeight) {
+    // Spielfiguren außerhalb des Sichtbereiches aussortieren
+    const float *boundingSphere = pawnMesh.boundingSphere;
+    float x = pawn->position.data[0] + PAWN_SCALE_FACTOR * boundingSphere[0];
+    float y = pawn->position.data[1] + PAWN_SCALE_FACTOR * boundingSphere[1];
+    float z = PAWN_SCALE_FACTOR * boundingSphere[2];
+    pawn->visible = isSphereInFrustum(&frustum, x, y, z, PAWN_SCALE_FACTOR * boundingSphere[3]);
+    if (!pawn->visible) {
+        return;
+    }
+    // Detailstufe anhand der Höhe auf dem Bildschirm wählen
+    selectPawnLevelOfDetail(pawn, projectedPawnSize(pawn, viewportHeight));
     // Transformationsmatrix mit der Identitätsmatrix initialisieren und Translation und Skalierung
     // reinrechnen
     QCAR::Matrix44F transform = matrix44FIdentity();
     translatePoseMatrix(pawn->position.data[0], pawn->position.data[1], 0.f, &transform.data[0]);
     scalePoseMatrix(PAWN_SCALE_FACTOR, PAWN_SCALE_FACTOR, PAWN_SCALE_FACTOR, &transform.data[0]);
-    // gesicherte Matrix wiederherstellen
-    glPushMatrix();
-    // Transformationsmatrix anwenden
-    glMultMatrixf(&transform.data[0]);
-    // Spielfigur rendern
-    glDrawArrays(GL_TRIANGLES, 0, PAWN_VERTICES_COUNT);
-    // gesicherte Matrix wiederherstellen
-    glPopMatrix();
+    // quantisierte Positionen in Model-Koordinaten umrechnen
+    const MeshFileHeader *header = pawnMesh.header;
+    translatePoseMatrix(header->positionOffset[0], header->positionOffset[1],
+            header->positionOffset[2], &transform.data[0]);
+    scalePoseMatrix(header->positionScale, header->positionScale, header->positionScale,
+            &transform.data[0]);
+    // Model-View-Matrix der Spielfigur berechnen
+    multiplyMatrix(modelViewMatrix.data, transform.data, pawn->modelViewMatrix.data);
 }
 
 /**
- * Rendert die Spielfiguren.
+ * Rendert eine Spielfigur mit Sichtbarkeit, Detailstufe und Model-View-Matrix aus dem letzten
+ * vorbereiteten Frame.
  *
- * Die Spielfiguren werden gerendert, indem sie durch eine Lichtquelle beleuchtet werden, die an die
- * Position des Beobachters gebunden ist.
+ * @param pawn Die zu rendernde Spielfigur.
  */
-void renderPawns() {
-    // keine Textur-Koordinaten nötig
-    glDisableClientState(GL_TEXTURE_COORD_ARRAY);
+static void renderPawn(Pawn *pawn) {
+    if (!pawn->visible) {
+        ++renderStatistics.culledPawnCount;
+        return;
+    }
+    ++renderStatistics.visiblePawnCount;
+    const MeshLevelOfDetail &levelOfDetail = pawnMesh.levelsOfDetail[pawn->levelOfDetail];
+    if (useShaders) {
+        // die Lichtfarben werden als Uniforms gesetzt
+        renderPawnWithShaders(pawn->modelViewMatrix, pawn->light, levelOfDetail);
+    } else {
+        // Lichtkomponenten setzen
+        setGlLight(GL_LIGHT0, GL_AMBIENT, pawn->light.ambient);
+        setGlLight(GL_LIGHT0, GL_DIFFUSE, pawn->light.diffuse);
+        setGlLight(GL_LIGHT0, GL_SPECULAR, pawn->light.specular);
+        // aktuelle Matrix sichern
+        glPushMatrix();
+        // Model-View-Matrix der Spielfigur laden
+        glLoadMatrixf(pawn->modelViewMatrix.data);
+        // Spielfigur in der gewählten Detailstufe rendern
+        glDrawElements(GL_TRIANGLES, levelOfDetail.indexCount, GL_UNSIGNED_SHORT,
+                (GLvoid*)(levelOfDetail.firstIndex * sizeof(GLushort)));
+        // gesicherte Matrix wiederherstellen
+        glPopMatrix();
+    }
+    ++renderStatistics.drawCallCount;
+}
+
+/**
+ * Bereitet das Rendern der Spielfiguren mit der festen Funktions-Pipeline vor.
+ */
+static void beginPawnsWithFixedFunctions() {
+    // Normale werden für die Beleuchtung benötigt, Textur-Koordinaten nicht
+    setGlClientState(GL_NORMAL_ARRAY, true);
+    setGlClientState(GL_TEXTURE_COORD_ARRAY, false);
     // Tiefen-Test für die richtige Beleuchtung ein
-    glEnable(GL_DEPTH_TEST);
+    setGlCapability(GL_DEPTH_TEST, true);
     // Licht allgemein und erste Lichtquelle einschalten
-    glEnable(GL_LIGHTING);
-    glEnable(GL_LIGHT0);
+    setGlCapability(GL_LIGHTING, true);
+    setGlCapability(GL_LIGHT0, true);
     // Normale sollen skaliert werden
-    glEnable(GL_RESCALE_NORMAL);
+    setGlCapability(GL_RESCALE_NORMAL, true);
     // Blending ausschalten
-    glDisable(GL_BLEND);
+    setGlCapability(GL_BLEND, false);
     // 2D-Textur ausschalten
-    glDisable(GL_TEXTURE_2D);
-    // Vertices setzen
-    glVertexPointer(3, GL_FLOAT, 0, &pawnVertices[0]);
-    // Normale setzen
-    glNormalPointer(GL_FLOAT, 0, &pawnNormals[0]);
+    setGlCapability(GL_TEXTURE_2D, false);
+    // Vertices und Normale setzen, beide liegen verschränkt im selben Buffer
+    bindGlBuffer(GL_ARRAY_BUFFER, vertexBufferObjects[PAWN_VERTEX_BUFFER]);
+    setGlVertexPointer(3, GL_SHORT, sizeof(MeshVertex), (GLvoid*)offsetof(MeshVertex, position));
+    setGlNormalPointer(GL_BYTE, sizeof(MeshVertex), (GLvoid*)offsetof(MeshVertex, normal));
+    // Indizes setzen
+    bindGlBuffer(GL_ELEMENT_ARRAY_BUFFER, vertexBufferObjects[PAWN_INDEX_BUFFER]);
+}
+
+/**
+ * Rendert die Spielfiguren.
+ *
+ * Die Spielfiguren werden gerendert, indem sie durch eine Lichtquelle beleuchtet werden, die an die
+ * Position des Beobachters gebunden ist.
+ *
+ * @param prepare Flag, das anzeigt, ob Sichtbarkeit, Detailstufe und Model-View-Matrix der
+ *      Spielfiguren neu bestimmt werden müssen, oder die des letzten vorbereiteten Frames
+ *      wiederverwendet werden können.
+ */
+void renderPawns(bool prepare) {
+    // ohne geladenes Model gibt es nichts zu rendern
+    if (pawnMesh.header == NULL) {
+        return;
+    }
+    if (useShaders) {
+        beginPawnsWithShaders(projectionMatrix, vertexBufferObjects[PAWN_VERTEX_BUFFER],
+                vertexBufferObjects[PAWN_INDEX_BUFFER]);
+    } else {
+        beginPawnsWithFixedFunctions();
+    }
+    if (prepare) {
+        // Viewport-Höhe für die Wahl der Detailstufen bestimmen
+        float viewportHeight =
+                QCAR::Renderer::getInstance().getVideoBackgroundConfig().mSize.data[1];
+        for (int i = 0; i < PLAYER_COUNT; ++i) {
+            preparePawn(&players[i].pawn, viewportHeight);
+        }
+    }
     // Spielfiguren rendern
     for (int i = 0; i < PLAYER_COUNT; ++i) {
         renderPawn(&players[i].pawn);
     }
 }
 
+/**
+ * Prüft, ob sich seit dem letzten vorbereiteten Frame nichts verändert hat, was Sichtbarkeiten,
+ * Detailstufen oder Matrizen beeinflusst: Die Pose des Trackables weicht höchstens um
+ * IDLE_FRAME_ROTATION_EPSILON bzw. IDLE_FRAME_TRANSLATION_EPSILON ab, das Spielfeld ist
+ * unverändert, keine Spielfigur bewegt sich und es ist keine Druck-Geste aktiv.
+ *
+ * @return true, wenn der letzte vorbereitete Frame wiederverwendet werden kann.
+ */
+static bool isIdleFrame() {
+    if (!lastFrameValid || field.dirty || touchEvent.isActive || gameState != lastGameState) {
+        return false;
+    }
+    for (int i = 0; i < 16; ++i) {
+        // Elemente 12 bis 14 enthalten die Translation
+        float epsilon = i >= 12 ? IDLE_FRAME_TRANSLATION_EPSILON : IDLE_FRAME_ROTATION_EPSILON;
+        if (fabsf(modelViewMatrix.data[i] - lastModelViewMatrix.data[i]) > epsilon) {
+            return false;
+        }
+    }
+    for (int i = 0; i < PLAYER_COUNT; ++i) {
+        const QCAR::Vec2F &position = players[i].pawn.position;
+        if (position.data[0] != lastPawnPositions[i].data[0]
+                || position.data[1] != lastPawnPositions[i].data[1]) {
+            return false;
+        }
+    }
+    return true;
+}
+
+/**
+ * Merkt sich die Eingaben des gerade vorbereiteten Frames für isIdleFrame().
+ */
+static void rememberPreparedFrame() {
+    lastModelViewMatrix = modelViewMatrix;
+    for (int i = 0; i < PLAYER_COUNT; ++i) {
+        lastPawnPositions[i] = players[i].pawn.position;
+    }
+    lastGameState = gameState;
+    lastFrameValid = true;
+}
+
 /**
  * Rendert die Realitätserweiterung.
+ *
+ * Hat sich seit dem letzten vorbereiteten Frame nichts verändert (siehe isIdleFrame()), werden
+ * Sichtbereich, Sichtbarkeiten, Detailstufen und Matrizen nicht neu bestimmt, sondern nur die
+ * Zeichenaufrufe wiederholt. Diese lassen sich nicht einsparen, weil QCAR den Video-Hintergrund in
+ * jedem Frame neu zeichnet und dabei die Realitätserweiterung des letzten Frames überschreibt.
  */
 void renderAugmentation() {
-    // Vertices und Normale werden immer benötigt
-    glEnableClientState(GL_VERTEX_ARRAY);
-    glEnableClientState(GL_NORMAL_ARRAY);
-    // Projektionsmatrix laden
-    glMatrixMode(GL_PROJECTION);
-    glLoadMatrixf(projectionMatrix.data);
-    // Positon der Lichtquelle setzen
-    // Lichtquelle wird an die Position des Beobachters gebunden und bewegt sich mit dieser
-    const GLfloat light0Position[] = { 0.0, 0.0, 0.0, 1.0 };
-    glLightfv(GL_LIGHT0, GL_POSITION, &light0Position[0]);
-    // Model-View-Matrix laden
-    glMatrixMode(GL_MODELVIEW);
-    glLoadMatrixf(modelViewMatrix.data);
+    // QCAR hat beim Rendern des Video-Hintergrundes den GL-Zustand verändert
+    invalidateGlState();
+    bool prepare = !isIdleFrame();
+    if (prepare) {
+        // Sichtbereich für das Frustum-Culling bestimmen
+        multiplyMatrix(projectionMatrix.data, modelViewMatrix.data,
+                modelViewProjectionMatrix.data);
+        extractFrustum(modelViewProjectionMatrix.data, &frustum);
+    } else {
+        ++renderStatistics.idleFrameCount;
+    }
+    // die Shader setzen Matrizen und Lichtquelle selbst
+    if (!useShaders) {
+        // Vertices werden immer benötigt
+        setGlClientState(GL_VERTEX_ARRAY, true);
+        // Projektionsmatrix laden
+        glMatrixMode(GL_PROJECTION);
+        glLoadMatrixf(projectionMatrix.data);
+        // Positon der Lichtquelle setzen
+        // Lichtquelle wird an die Position des Beobachters gebunden und bewegt sich mit dieser
+        const GLfloat light0Position[] = { 0.0, 0.0, 0.0, 1.0 };
+        setGlLight(GL_LIGHT0, GL_POSITION, &light0Position[0]);
+        // Model-View-Matrix laden
+        glMatrixMode(GL_MODELVIEW);
+        glLoadMatrixf(modelViewMatrix.data);
+    }
     // Spielfeld rendern
-    renderField();
+    renderField(prepare);
     // Spielfiguren rendern, wenn das Spiel läuft
     if (gameState >= GAME_STATE_RUNNING) {
-        renderPawns();
+        renderPawns(prepare);
     }
+    if (prepare) {
+        rememberPreparedFrame();
+    }
+    // Buffer lösen, damit QCAR beim Rendern des Video-Hintergrundes nicht darauf zugreift
+    bindGlBuffer(GL_ARRAY_BUFFER, 0);
+    bindGlBuffer(GL_ELEMENT_ARRAY_BUFFER, 0);
     // Prüfung, ob ein GL-Fehler aufgetreten ist
     checkGlError("renderAugmentation");
+    // Render-Statistik regelmäßig ausgeben
+    if (++renderStatistics.frameCount == RENDER_STATISTICS_INTERVAL) {
+        float frameCount = renderStatistics.frameCount;
+        LOGI("renderAugmentation: per frame %.1f draw calls, %.1f state changes issued, "
+                "%.1f suppressed, %.1f/%.1f spaces and %.1f/%.1f pawns visible/culled, "
+                "%.0f%% idle frames", renderStatistics.drawCallCount / frameCount,
+                renderStatistics.stateChangeCount / frameCount,
+                renderStatistics.suppressedStateChangeCount / frameCount,
+                renderStatistics.visibleSpaceCount / frameCount,
+                renderStatistics.culledSpaceCount / frameCount,
+                renderStatistics.visiblePawnCount / frameCount,
+                renderStatistics.culledPawnCount / frameCount,
+                100.f * renderStatistics.idleFrameCount / frameCount);
+        memset(&renderStatistics, 0, sizeof(renderStatistics));
+    }
 }
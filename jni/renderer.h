@@ -11,6 +11,9 @@
 #ifndef RENDERER_H
 #define RENDERER_H
 
+void initRenderer();
+bool usesShaders();
+void releaseFieldRenderData();
 void renderAugmentation();
 
 #endif
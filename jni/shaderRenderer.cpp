@@ -0,0 +1,336 @@
+/**
+ * @file shaderRenderer.cpp
+ *
+ * @brief Beinhaltet Funktionen zum Rendern mit Shadern unter OpenGL ES 2.0.
+ *
+ * @details Die Shader bilden die feste Funktions-Pipeline von OpenGL ES 1.1 nach, die in
+ *      renderer.cpp verwendet wird: Die Felder werden texturiert, die Spielfiguren pro Vertex mit
+ *      einer Punktlichtquelle an der Position des Beobachters und dem Standard-Material
+ *      beleuchtet. Die Lichtfarben der Spielfiguren werden als Uniforms übergeben.
+ *
+ *      Liegt der Textur-Atlas ETC1-komprimiert vor, steckt der Alpha-Kanal in einer zweiten
+ *      Textur (siehe ktxTexture.cpp), die ein eigenes Fragment-Shader-Programm dazuliest.
+ *
+ *      Die Geometrie liegt ausschließlich in Vertex-Buffer-Objekten. Die Matrizen werden auf der
+ *      CPU zusammengesetzt, es gibt keinen Matrix-Stack.
+ *
+ * @author Alexander Bertram
+ *
+ * @date 16.10.2026
+ */
+
+#include <stddef.h>
+
+#include <GLES2/gl2.h>
+
+#include "glState.h"
+#include "shaderRenderer.h"
+#include "utils.h"
+
+/**
+ * Index des Vertex-Attributes für die Position.
+ */
+#define POSITION_ATTRIBUTE 0
+/**
+ * Index des Vertex-Attributes für die Normale.
+ */
+#define NORMAL_ATTRIBUTE 1
+/**
+ * Index des Vertex-Attributes für die Textur-Koordinate.
+ */
+#define TEXTURE_COORDINATE_ATTRIBUTE 2
+
+/**
+ * Vertex-Shader der Felder.
+ */
+static const char FIELD_VERTEX_SHADER[] =
+    "uniform mat4 modelViewProjectionMatrix;\n"
+    "attribute vec4 position;\n"
+    "attribute vec2 textureCoordinate;\n"
+    "varying vec2 vTextureCoordinate;\n"
+    "void main() {\n"
+    "    vTextureCoordinate = textureCoordinate;\n"
+    "    gl_Position = modelViewProjectionMatrix * position;\n"
+    "}\n";
+/**
+ * Fragment-Shader der Felder.
+ */
+static const char FIELD_FRAGMENT_SHADER[] =
+    "precision mediump float;\n"
+    "uniform sampler2D atlas;\n"
+    "varying vec2 vTextureCoordinate;\n"
+    "void main() {\n"
+    "    gl_FragColor = texture2D(atlas, vTextureCoordinate);\n"
+    "}\n";
+/**
+ * Fragment-Shader der Felder mit getrennter Alpha-Ebene. Die Alpha-Ebene enthält den Alpha-Wert in
+ * allen Farbkanälen, gelesen wird der grüne, der bei ETC1 am genauesten ist.
+ */
+static const char FIELD_ALPHA_PLANE_FRAGMENT_SHADER[] =
+    "precision mediump float;\n"
+    "uniform sampler2D atlas;\n"
+    "uniform sampler2D atlasAlpha;\n"
+    "varying vec2 vTextureCoordinate;\n"
+    "void main() {\n"
+    "    gl_FragColor = vec4(texture2D(atlas, vTextureCoordinate).rgb,\n"
+    "            texture2D(atlasAlpha, vTextureCoordinate).g);\n"
+    "}\n";
+/**
+ * Vertex-Shader der Spielfiguren. Entspricht der Beleuchtung von OpenGL ES 1.1 mit dem
+ * Standard-Material (ambient 0.2, diffus 0.8, nicht spekular) und dem Standard-Umgebungslicht
+ * (0.2). Die Normalen werden wie mit GL_RESCALE_NORMAL nach der Transformation normalisiert.
+ */
+static const char PAWN_VERTEX_SHADER[] =
+    "uniform mat4 modelViewMatrix;\n"
+    "uniform mat4 projectionMatrix;\n"
+    "uniform vec4 lightAmbient;\n"
+    "uniform vec4 lightDiffuse;\n"
+    "attribute vec4 position;\n"
+    "attribute vec3 normal;\n"
+    "varying vec4 vColor;\n"
+    "void main() {\n"
+    "    vec4 eyePosition = modelViewMatrix * position;\n"
+    "    vec3 eyeNormal = normalize((modelViewMatrix * vec4(normal, 0.0)).xyz);\n"
+    "    float diffuse = max(dot(eyeNormal, normalize(-eyePosition.xyz)), 0.0);\n"
+    "    vColor = vec4(0.2 * (vec3(0.2) + lightAmbient.rgb)\n"
+    "            + 0.8 * diffuse * lightDiffuse.rgb, 0.8);\n"
+    "    gl_Position = projectionMatrix * eyePosition;\n"
+    "}\n";
+/**
+ * Fragment-Shader der Spielfiguren.
+ */
+static const char PAWN_FRAGMENT_SHADER[] =
+    "precision mediump float;\n"
+    "varying vec4 vColor;\n"
+    "void main() {\n"
+    "    gl_FragColor = vColor;\n"
+    "}\n";
+
+/**
+ * Shader-Programm der Felder.
+ */
+static GLuint fieldProgram = 0;
+/**
+ * Uniform der Model-View-Projektionsmatrix der Felder.
+ */
+static GLint fieldModelViewProjectionMatrix;
+/**
+ * Uniform des Textur-Atlas der Felder.
+ */
+static GLint fieldAtlas;
+/**
+ * Shader-Programm der Felder mit getrennter Alpha-Ebene.
+ */
+static GLuint fieldAlphaPlaneProgram = 0;
+/**
+ * Uniform der Model-View-Projektionsmatrix der Felder mit getrennter Alpha-Ebene.
+ */
+static GLint fieldAlphaPlaneModelViewProjectionMatrix;
+/**
+ * Uniform des Textur-Atlas der Felder mit getrennter Alpha-Ebene.
+ */
+static GLint fieldAlphaPlaneAtlas;
+/**
+ * Uniform der Alpha-Ebene des Textur-Atlas.
+ */
+static GLint fieldAlphaPlaneAtlasAlpha;
+/**
+ * Shader-Programm der Spielfiguren.
+ */
+static GLuint pawnProgram = 0;
+/**
+ * Uniform der Model-View-Matrix der Spielfiguren.
+ */
+static GLint pawnModelViewMatrix;
+/**
+ * Uniform der Projektionsmatrix der Spielfiguren.
+ */
+static GLint pawnProjectionMatrix;
+/**
+ * Uniform des ambienten Lichtanteils der Spielfiguren.
+ */
+static GLint pawnLightAmbient;
+/**
+ * Uniform des diffusen Lichtanteils der Spielfiguren.
+ */
+static GLint pawnLightDiffuse;
+
+/**
+ * Kompiliert einen Shader.
+ *
+ * @param type GL_VERTEX_SHADER oder GL_FRAGMENT_SHADER.
+ * @param source Quelltext des Shaders.
+ * @return Der Shader oder 0, wenn er nicht kompiliert werden konnte.
+ */
+static GLuint compileShader(GLenum type, const char *source) {
+    GLuint shader = glCreateShader(type);
+    glShaderSource(shader, 1, &source, NULL);
+    glCompileShader(shader);
+    GLint compiled = GL_FALSE;
+    glGetShaderiv(shader, GL_COMPILE_STATUS, &compiled);
+    if (!compiled) {
+        char log[512];
+        glGetShaderInfoLog(shader, sizeof(log), NULL, log);
+        LOGE("compileShader: %s", log);
+        glDeleteShader(shader);
+        return 0;
+    }
+    return shader;
+}
+
+/**
+ * Kompiliert und bindet ein Shader-Programm. Die Vertex-Attribute position, normal und
+ * textureCoordinate erhalten feste Indizes.
+ *
+ * @param vertexShaderSource Quelltext des Vertex-Shaders.
+ * @param fragmentShaderSource Quelltext des Fragment-Shaders.
+ * @return Das Shader-Programm oder 0, wenn es nicht erzeugt werden konnte.
+ */
+static GLuint createProgram(const char *vertexShaderSource, const char *fragmentShaderSource) {
+    GLuint vertexShader = compileShader(GL_VERTEX_SHADER, vertexShaderSource);
+    GLuint fragmentShader = compileShader(GL_FRAGMENT_SHADER, fragmentShaderSource);
+    if (vertexShader == 0 || fragmentShader == 0) {
+        glDeleteShader(vertexShader);
+        glDeleteShader(fragmentShader);
+        return 0;
+    }
+    GLuint program = glCreateProgram();
+    glAttachShader(program, vertexShader);
+    glAttachShader(program, fragmentShader);
+    glBindAttribLocation(program, POSITION_ATTRIBUTE, "position");
+    glBindAttribLocation(program, NORMAL_ATTRIBUTE, "normal");
+    glBindAttribLocation(program, TEXTURE_COORDINATE_ATTRIBUTE, "textureCoordinate");
+    glLinkProgram(program);
+    // die Shader werden mit dem Programm gelöscht
+    glDeleteShader(vertexShader);
+    glDeleteShader(fragmentShader);
+    GLint linked = GL_FALSE;
+    glGetProgramiv(program, GL_LINK_STATUS, &linked);
+    if (!linked) {
+        char log[512];
+        glGetProgramInfoLog(program, sizeof(log), NULL, log);
+        LOGE("createProgram: %s", log);
+        glDeleteProgram(program);
+        return 0;
+    }
+    return program;
+}
+
+/**
+ * Initialisiert das Rendern mit Shadern. Muss nach jedem (Neu-)Erzeugen des GL-Kontextes
+ * aufgerufen werden, weil die Shader-Programme mit dem alten Kontext verloren gehen.
+ *
+ * @return True, wenn alle Shader-Programme erzeugt werden konnten.
+ */
+bool initShaderRenderer() {
+    LOGD("initShaderRenderer");
+    fieldProgram = createProgram(FIELD_VERTEX_SHADER, FIELD_FRAGMENT_SHADER);
+    fieldAlphaPlaneProgram = createProgram(FIELD_VERTEX_SHADER, FIELD_ALPHA_PLANE_FRAGMENT_SHADER);
+    pawnProgram = createProgram(PAWN_VERTEX_SHADER, PAWN_FRAGMENT_SHADER);
+    if (fieldProgram == 0 || fieldAlphaPlaneProgram == 0 || pawnProgram == 0) {
+        return false;
+    }
+    // Uniforms der Felder
+    fieldModelViewProjectionMatrix = glGetUniformLocation(fieldProgram,
+            "modelViewProjectionMatrix");
+    fieldAtlas = glGetUniformLocation(fieldProgram, "atlas");
+    fieldAlphaPlaneModelViewProjectionMatrix = glGetUniformLocation(fieldAlphaPlaneProgram,
+            "modelViewProjectionMatrix");
+    fieldAlphaPlaneAtlas = glGetUniformLocation(fieldAlphaPlaneProgram, "atlas");
+    fieldAlphaPlaneAtlasAlpha = glGetUniformLocation(fieldAlphaPlaneProgram, "atlasAlpha");
+    // Uniforms der Spielfiguren
+    pawnModelViewMatrix = glGetUniformLocation(pawnProgram, "modelViewMatrix");
+    pawnProjectionMatrix = glGetUniformLocation(pawnProgram, "projectionMatrix");
+    pawnLightAmbient = glGetUniformLocation(pawnProgram, "lightAmbient");
+    pawnLightDiffuse = glGetUniformLocation(pawnProgram, "lightDiffuse");
+    return true;
+}
+
+/**
+ * Rendert das Spielfeld mit einem Zeichenaufruf.
+ *
+ * @param modelViewProjectionMatrix Model-View-Projektionsmatrix des Trackables.
+ * @param texture Textur-Atlas der Felder.
+ * @param alphaTexture Alpha-Ebene des Textur-Atlas oder 0, wenn der Atlas einen Alpha-Kanal hat.
+ * @param vertexBuffer Vertex-Buffer-Objekt mit den Vertices des Spielfeldes (FieldVertex).
+ * @param indexBuffer Vertex-Buffer-Objekt mit den Indizes der sichtbaren Felder.
+ * @param indexCount Anzahl der Indizes.
+ */
+void renderFieldWithShaders(QCAR::Matrix44F &modelViewProjectionMatrix, GLuint texture,
+        GLuint alphaTexture, GLuint vertexBuffer, GLuint indexBuffer, GLsizei indexCount) {
+    useGlProgram(alphaTexture != 0 ? fieldAlphaPlaneProgram : fieldProgram);
+    // Blending für Transparenz, kein Tiefentest (siehe renderField)
+    setGlCapability(GL_BLEND, true);
+    setGlCapability(GL_DEPTH_TEST, false);
+    setGlBlendFunction(GL_SRC_ALPHA, GL_ONE_MINUS_SRC_ALPHA);
+    // Uniforms setzen
+    if (alphaTexture != 0) {
+        glUniformMatrix4fv(fieldAlphaPlaneModelViewProjectionMatrix, 1, GL_FALSE,
+                modelViewProjectionMatrix.data);
+        glUniform1i(fieldAlphaPlaneAtlas, 0);
+        glUniform1i(fieldAlphaPlaneAtlasAlpha, 1);
+        // die Alpha-Ebene liegt auf Textur-Einheit 1, die glState.cpp nicht verfolgt
+        glActiveTexture(GL_TEXTURE1);
+        glBindTexture(GL_TEXTURE_2D, alphaTexture);
+        glActiveTexture(GL_TEXTURE0);
+    } else {
+        glUniformMatrix4fv(fieldModelViewProjectionMatrix, 1, GL_FALSE,
+                modelViewProjectionMatrix.data);
+        glUniform1i(fieldAtlas, 0);
+    }
+    bindGlTexture(texture);
+    // Vertex-Attribute setzen, Positionen und Textur-Koordinaten liegen verschränkt im Buffer
+    bindGlBuffer(GL_ARRAY_BUFFER, vertexBuffer);
+    setGlVertexAttribArray(POSITION_ATTRIBUTE, true);
+    setGlVertexAttribArray(NORMAL_ATTRIBUTE, false);
+    setGlVertexAttribArray(TEXTURE_COORDINATE_ATTRIBUTE, true);
+    setGlVertexAttribPointer(POSITION_ATTRIBUTE, 2, GL_FLOAT, GL_FALSE, sizeof(FieldVertex),
+            (GLvoid*)offsetof(FieldVertex, position));
+    setGlVertexAttribPointer(TEXTURE_COORDINATE_ATTRIBUTE, 2, GL_FLOAT, GL_FALSE,
+            sizeof(FieldVertex), (GLvoid*)offsetof(FieldVertex, textureCoordinate));
+    bindGlBuffer(GL_ELEMENT_ARRAY_BUFFER, indexBuffer);
+    glDrawElements(GL_TRIANGLES, indexCount, GL_UNSIGNED_SHORT, 0);
+}
+
+/**
+ * Bereitet das Rendern der Spielfiguren vor.
+ *
+ * @param projectionMatrix Projektionsmatrix.
+ * @param vertexBuffer Vertex-Buffer-Objekt mit den Vertices der Spielfigur (MeshVertex).
+ * @param indexBuffer Vertex-Buffer-Objekt mit den Indizes der Spielfigur.
+ */
+void beginPawnsWithShaders(QCAR::Matrix44F &projectionMatrix, GLuint vertexBuffer,
+        GLuint indexBuffer) {
+    useGlProgram(pawnProgram);
+    // Tiefentest für die richtige Verdeckung, kein Blending
+    setGlCapability(GL_DEPTH_TEST, true);
+    setGlCapability(GL_BLEND, false);
+    glUniformMatrix4fv(pawnProjectionMatrix, 1, GL_FALSE, projectionMatrix.data);
+    // Vertex-Attribute setzen, Positionen und Normalen liegen verschränkt im Buffer
+    bindGlBuffer(GL_ARRAY_BUFFER, vertexBuffer);
+    setGlVertexAttribArray(POSITION_ATTRIBUTE, true);
+    setGlVertexAttribArray(NORMAL_ATTRIBUTE, true);
+    setGlVertexAttribArray(TEXTURE_COORDINATE_ATTRIBUTE, false);
+    setGlVertexAttribPointer(POSITION_ATTRIBUTE, 3, GL_SHORT, GL_FALSE, sizeof(MeshVertex),
+            (GLvoid*)offsetof(MeshVertex, position));
+    setGlVertexAttribPointer(NORMAL_ATTRIBUTE, 3, GL_BYTE, GL_TRUE, sizeof(MeshVertex),
+            (GLvoid*)offsetof(MeshVertex, normal));
+    bindGlBuffer(GL_ELEMENT_ARRAY_BUFFER, indexBuffer);
+}
+
+/**
+ * Rendert eine Spielfigur. beginPawnsWithShaders muss vorher aufgerufen worden sein.
+ *
+ * @param modelViewMatrix Model-View-Matrix der Spielfigur (inklusive der Umrechnung der
+ *      quantisierten Positionen).
+ * @param light Lichtfarben der Spielfigur.
+ * @param levelOfDetail Die zu rendernde Detailstufe.
+ */
+void renderPawnWithShaders(QCAR::Matrix44F &modelViewMatrix, const Light &light,
+        const MeshLevelOfDetail &levelOfDetail) {
+    glUniformMatrix4fv(pawnModelViewMatrix, 1, GL_FALSE, modelViewMatrix.data);
+    glUniform4fv(pawnLightAmbient, 1, light.ambient);
+    glUniform4fv(pawnLightDiffuse, 1, light.diffuse);
+    glDrawElements(GL_TRIANGLES, levelOfDetail.indexCount, GL_UNSIGNED_SHORT,
+            (GLvoid*)(levelOfDetail.firstIndex * sizeof(GLushort)));
+}
@@ -0,0 +1,21 @@
+/**
+ * @file shaderRenderer.h
+ *
+ * @brief Schnittstelle zu shaderRenderer.cpp.
+ *
+ * @author Alexander Bertram
+ *
+ * @date 16.10.2026
+ */
+
+#ifndef SHADER_RENDERER_H
+#define SHADER_RENDERER_H
+
+#include "types.h"
+
+bool initShaderRenderer();
+void renderFieldWithShaders(QCAR::Matrix44F&, GLuint, GLuint, GLuint, GLuint, GLsizei);
+void beginPawnsWithShaders(QCAR::Matrix44F&, GLuint, GLuint);
+void renderPawnWithShaders(QCAR::Matrix44F&, const Light&, const MeshLevelOfDetail&);
+
+#endif
@@ -0,0 +1,216 @@
+/**
+ * @file spaceGrid.cpp
+ *
+ * @brief Räumliches Hash-Gitter für Abstandsabfragen zwischen den Feldern.
+ *
+ * @details Die Kantenlänge einer Zelle entspricht dem größten abgefragten Abstand (doppelter
+ *      Feldradius). Alle Punkte, die näher als dieser Abstand an einer Position liegen, befinden
+ *      sich deshalb in der Zelle der Position oder in einer der acht Nachbarzellen. Eine Abfrage
+ *      prüft nur diese neun Zellen und vergleicht quadrierte Abstände, ihr Aufwand hängt also
+ *      nicht von der Anzahl der Felder ab. Dieselben neun Zellen genügen auch für die Suche nach
+ *      dem nächsten Feld innerhalb des Feldradius beim Tippen.
+ *
+ *      Wird die Kapazität überschritten, werden Punkte und Buckets verdoppelt und die Listen neu
+ *      aufgebaut, so bleibt im Mittel höchstens ein Punkt pro Bucket. Bis
+ *      SPACE_GRID_INLINE_CAPACITY Punkte liegt alles im Gitter selbst.
+ *
+ *      Die Datei hängt nur von der Standard-Bibliothek ab, damit sie auch auf dem
+ *      Entwicklungsrechner übersetzt werden kann (siehe tools/fieldBenchmark.cpp).
+ *
+ * @author Alexander Bertram
+ *
+ * @date 16.10.2026
+ */
+
+#include <math.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "spaceGrid.h"
+
+/**
+ * Gibt den Speicher eines Gitters frei, falls er nicht im Gitter selbst liegt.
+ *
+ * @param grid Das Gitter.
+ */
+static void releaseSpaceGridStorage(SpaceGrid *grid) {
+    if (grid->heads != NULL && grid->heads != grid->inlineHeads) {
+        free(grid->heads);
+        free(grid->next);
+        free(grid->points);
+    }
+    grid->heads = grid->inlineHeads;
+    grid->next = grid->inlineNext;
+    grid->points = grid->inlinePoints;
+}
+
+/**
+ * Berechnet die Zelle, in der eine Koordinate liegt.
+ *
+ * @param grid Das Gitter.
+ * @param coordinate Die Koordinate.
+ * @return Index der Zelle.
+ */
+static int32_t cellOf(const SpaceGrid *grid, float coordinate) {
+    return (int32_t)floorf(coordinate / grid->cellSize);
+}
+
+/**
+ * Berechnet den Bucket einer Zelle.
+ *
+ * @param grid Das Gitter.
+ * @param cellX Spalte der Zelle.
+ * @param cellY Zeile der Zelle.
+ * @return Index des Buckets.
+ */
+static uint32_t bucketOf(const SpaceGrid *grid, int32_t cellX, int32_t cellY) {
+    return ((uint32_t)cellX * 73856093u ^ (uint32_t)cellY * 19349663u) & grid->bucketMask;
+}
+
+/**
+ * Hängt einen Punkt in die Liste seines Buckets ein.
+ *
+ * @param grid Das Gitter.
+ * @param index Index des Punktes.
+ */
+static void linkPoint(SpaceGrid *grid, int32_t index) {
+    const SpaceGridPoint &point = grid->points[index];
+    uint32_t bucket = bucketOf(grid, cellOf(grid, point.x), cellOf(grid, point.y));
+    grid->next[index] = grid->heads[bucket];
+    grid->heads[bucket] = index;
+}
+
+/**
+ * Entfernt alle Punkte aus einem Gitter und gibt angeforderten Speicher frei. Muss vor der ersten
+ * Verwendung aufgerufen werden.
+ *
+ * @param grid Das Gitter.
+ * @param cellSize Kantenlänge einer Zelle, mindestens der größte abgefragte Abstand.
+ */
+void clearSpaceGrid(SpaceGrid *grid, float cellSize) {
+    releaseSpaceGridStorage(grid);
+    grid->cellSize = cellSize;
+    grid->bucketMask = SPACE_GRID_INLINE_CAPACITY - 1;
+    grid->count = 0;
+    grid->capacity = SPACE_GRID_INLINE_CAPACITY;
+    memset(grid->heads, 0xff, SPACE_GRID_INLINE_CAPACITY * sizeof(int32_t));
+}
+
+/**
+ * Verdoppelt Kapazität und Anzahl der Buckets eines Gitters.
+ *
+ * @param grid Das Gitter.
+ * @return false, wenn kein Speicher angefordert werden konnte. Das Gitter bleibt dann unverändert.
+ */
+static bool growSpaceGrid(SpaceGrid *grid) {
+    int32_t capacity = grid->capacity * 2;
+    int32_t *heads = (int32_t*)malloc(capacity * sizeof(int32_t));
+    int32_t *next = (int32_t*)malloc(capacity * sizeof(int32_t));
+    SpaceGridPoint *points = (SpaceGridPoint*)malloc(capacity * sizeof(SpaceGridPoint));
+    if (heads == NULL || next == NULL || points == NULL) {
+        free(heads);
+        free(next);
+        free(points);
+        return false;
+    }
+    memcpy(points, grid->points, grid->count * sizeof(SpaceGridPoint));
+    int32_t count = grid->count;
+    float cellSize = grid->cellSize;
+    releaseSpaceGridStorage(grid);
+    grid->heads = heads;
+    grid->next = next;
+    grid->points = points;
+    grid->cellSize = cellSize;
+    grid->count = count;
+    grid->capacity = capacity;
+    grid->bucketMask = capacity - 1;
+    memset(grid->heads, 0xff, capacity * sizeof(int32_t));
+    for (int32_t i = 0; i < count; ++i) {
+        linkPoint(grid, i);
+    }
+    return true;
+}
+
+/**
+ * Fügt einen Punkt in ein Gitter ein. Er erhält den Index grid->count vor dem Aufruf.
+ *
+ * @param grid Das Gitter.
+ * @param x X-Koordinate des Punktes.
+ * @param y Y-Koordinate des Punktes.
+ * @return false, wenn kein Speicher angefordert werden konnte.
+ */
+bool insertIntoSpaceGrid(SpaceGrid *grid, float x, float y) {
+    if (grid->count == grid->capacity && !growSpaceGrid(grid)) {
+        return false;
+    }
+    int32_t index = grid->count++;
+    grid->points[index].x = x;
+    grid->points[index].y = y;
+    linkPoint(grid, index);
+    return true;
+}
+
+/**
+ * Prüft, ob alle Punkte eines Gitters weiter als ein Mindestabstand von einer Position entfernt
+ * sind.
+ *
+ * @param grid Das Gitter.
+ * @param x X-Koordinate der Position.
+ * @param y Y-Koordinate der Position.
+ * @param minDistance Mindestabstand, höchstens die Kantenlänge einer Zelle.
+ * @return true, wenn kein Punkt höchstens minDistance von der Position entfernt ist.
+ */
+bool isSpaceGridAreaFree(const SpaceGrid *grid, float x, float y, float minDistance) {
+    float minDistanceSquared = minDistance * minDistance;
+    int32_t cellX = cellOf(grid, x);
+    int32_t cellY = cellOf(grid, y);
+    for (int32_t dy = -1; dy <= 1; ++dy) {
+        for (int32_t dx = -1; dx <= 1; ++dx) {
+            // Buckets können Punkte anderer Zellen enthalten, deshalb wird jeder Abstand geprüft
+            uint32_t bucket = bucketOf(grid, cellX + dx, cellY + dy);
+            for (int32_t i = grid->heads[bucket]; i >= 0; i = grid->next[i]) {
+                float deltaX = grid->points[i].x - x;
+                float deltaY = grid->points[i].y - y;
+                if (deltaX * deltaX + deltaY * deltaY <= minDistanceSquared) {
+                    return false;
+                }
+            }
+        }
+    }
+    return true;
+}
+
+/**
+ * Sucht den Punkt eines Gitters, der einer Position am nächsten liegt und höchstens einen
+ * Höchstabstand entfernt ist. Bei gleichem Abstand gewinnt der Punkt mit dem kleineren Index, das
+ * Ergebnis hängt also nicht von der Reihenfolge in den Buckets ab.
+ *
+ * @param grid Das Gitter.
+ * @param x X-Koordinate der Position.
+ * @param y Y-Koordinate der Position.
+ * @param maxDistance Höchstabstand, höchstens die Kantenlänge einer Zelle.
+ * @return Index des Punktes oder -1, wenn kein Punkt nah genug ist.
+ */
+int32_t findNearestInSpaceGrid(const SpaceGrid *grid, float x, float y, float maxDistance) {
+    int32_t nearest = -1;
+    float nearestDistanceSquared = maxDistance * maxDistance;
+    int32_t cellX = cellOf(grid, x);
+    int32_t cellY = cellOf(grid, y);
+    for (int32_t dy = -1; dy <= 1; ++dy) {
+        for (int32_t dx = -1; dx <= 1; ++dx) {
+            uint32_t bucket = bucketOf(grid, cellX + dx, cellY + dy);
+            for (int32_t i = grid->heads[bucket]; i >= 0; i = grid->next[i]) {
+                float deltaX = grid->points[i].x - x;
+                float deltaY = grid->points[i].y - y;
+                float distanceSquared = deltaX * deltaX + deltaY * deltaY;
+                if (distanceSquared < nearestDistanceSquared
+                        || (distanceSquared == nearestDistanceSquared
+                                && (nearest < 0 || i < nearest))) {
+                    nearest = i;
+                    nearestDistanceSquared = distanceSquared;
+                }
+            }
+        }
+    }
+    return nearest;
+}
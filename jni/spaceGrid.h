@@ -0,0 +1,85 @@
+/**
+ * @file spaceGrid.h
+ *
+ * @brief Schnittstelle zu spaceGrid.cpp.
+ *
+ * @author Alexander Bertram
+ *
+ * @date 16.10.2026
+ */
+
+#ifndef SPACE_GRID_H
+#define SPACE_GRID_H
+
+#include <stdint.h>
+
+/**
+ * Anzahl der Punkte, die ohne Speicheranforderung im Gitter selbst Platz finden.
+ */
+#define SPACE_GRID_INLINE_CAPACITY 128
+
+/**
+ * @brief Punkt im Gitter.
+ */
+typedef struct SpaceGridPoint {
+    /**
+     * Position in der Ebene des Trackables.
+     */
+    float x, y;
+} SpaceGridPoint;
+
+/**
+ * @brief Gleichmäßiges Gitter über der Ebene des Trackables, dessen Zellen über einen Hash auf
+ * eine feste Anzahl von Buckets abgebildet werden. Jeder Bucket ist eine einfach verkettete Liste
+ * von Punkt-Indizes. Die Punkte werden in der Reihenfolge des Einfügens nummeriert, der Index
+ * entspricht also dem Index des Feldes im Spielfeld.
+ */
+typedef struct SpaceGrid {
+    /**
+     * Kantenlänge einer Zelle.
+     */
+    float cellSize;
+    /**
+     * Anzahl der Buckets minus 1 (die Anzahl ist eine Zweierpotenz).
+     */
+    uint32_t bucketMask;
+    /**
+     * Anzahl der Punkte.
+     */
+    int32_t count;
+    /**
+     * Anzahl der Punkte, für die Speicher vorhanden ist.
+     */
+    int32_t capacity;
+    /**
+     * Erster Punkt jedes Buckets oder -1.
+     */
+    int32_t *heads;
+    /**
+     * Nächster Punkt im selben Bucket oder -1, pro Punkt.
+     */
+    int32_t *next;
+    /**
+     * Positionen der Punkte.
+     */
+    SpaceGridPoint *points;
+    /**
+     * Speicher für heads, solange das Gitter klein ist.
+     */
+    int32_t inlineHeads[SPACE_GRID_INLINE_CAPACITY];
+    /**
+     * Speicher für next, solange das Gitter klein ist.
+     */
+    int32_t inlineNext[SPACE_GRID_INLINE_CAPACITY];
+    /**
+     * Speicher für points, solange das Gitter klein ist.
+     */
+    SpaceGridPoint inlinePoints[SPACE_GRID_INLINE_CAPACITY];
+} SpaceGrid;
+
+void clearSpaceGrid(SpaceGrid*, float);
+bool insertIntoSpaceGrid(SpaceGrid*, float, float);
+bool isSpaceGridAreaFree(const SpaceGrid*, float, float, float);
+int32_t findNearestInSpaceGrid(const SpaceGrid*, float, float, float);
+
+#endif
@@ -0,0 +1,289 @@
+/**
+ * @file spaceKernels.cpp
+ *
+ * @brief Abstandsabfragen über zusammenhängende Arrays von Feld-Positionen.
+ *
+ * @details Die Koordinaten liegen getrennt in einem x- und einem y-Array (siehe SpaceChunk), so
+ *      dass pro Feld nur die 8 Byte der Position gelesen werden und vier Felder mit einer
+ *      SIMD-Instruktion geprüft werden können. Es werden nur quadrierte Abstände verglichen.
+ *
+ *      Jede Abfrage gibt es in einer skalaren Umsetzung, einer SSE2-Umsetzung
+ *      (Entwicklungsrechner) und einer NEON-Umsetzung (armeabi-v7a, spaceKernelsNeon.cpp). Alle
+ *      liefern bitgenau dieselben Ergebnisse, was countSpaceKernelMismatches() prüft: auf dem
+ *      Entwicklungsrechner in tools/fieldBenchmark.cpp, auf dem Gerät in Debug-Builds (ohne
+ *      NDEBUG) bei initSpaceKernels(). Über isSpaceArrayAreaFree und findNearestInSpaceArray wird
+ *      die schnellste verfügbare Umsetzung aufgerufen. NEON wird erst nach initSpaceKernels()
+ *      verwendet, wenn der Prozessor es unterstützt.
+ *
+ *      Die Datei hängt nur von der Standard-Bibliothek ab, damit sie auch auf dem
+ *      Entwicklungsrechner übersetzt werden kann.
+ *
+ * @author Alexander Bertram
+ *
+ * @date 16.10.2026
+ */
+
+#ifdef __SSE2__
+#include <emmintrin.h>
+#endif
+
+#ifdef HAVE_NEON_KERNELS
+#include <cpu-features.h>
+#endif
+
+#include "spaceKernels.h"
+
+/**
+ * Prüft skalar, ob alle Punkte eines Arrays weiter als ein Mindestabstand von einer Position
+ * entfernt sind.
+ *
+ * @param x X-Koordinaten der Punkte.
+ * @param y Y-Koordinaten der Punkte.
+ * @param count Anzahl der Punkte.
+ * @param positionX X-Koordinate der Position.
+ * @param positionY Y-Koordinate der Position.
+ * @param minDistanceSquared Quadrat des Mindestabstandes.
+ * @return true, wenn kein Punkt höchstens den Mindestabstand entfernt ist.
+ */
+bool isSpaceArrayAreaFreeScalar(const float *x, const float *y, int32_t count, float positionX,
+        float positionY, float minDistanceSquared) {
+    for (int32_t i = 0; i < count; ++i) {
+        float deltaX = x[i] - positionX;
+        float deltaY = y[i] - positionY;
+        if (deltaX * deltaX + deltaY * deltaY <= minDistanceSquared) {
+            return false;
+        }
+    }
+    return true;
+}
+
+/**
+ * Sucht skalar den Punkt eines Arrays, der einer Position am nächsten liegt und dessen quadrierter
+ * Abstand kleiner als eine Grenze ist. Bei gleichem Abstand gewinnt der Punkt mit dem kleineren
+ * Index.
+ *
+ * @param x X-Koordinaten der Punkte.
+ * @param y Y-Koordinaten der Punkte.
+ * @param count Anzahl der Punkte.
+ * @param positionX X-Koordinate der Position.
+ * @param positionY Y-Koordinate der Position.
+ * @param distanceSquared Grenze für den quadrierten Abstand, erhält den quadrierten Abstand des
+ *      gefundenen Punktes. Bleibt unverändert, wenn kein Punkt gefunden wird.
+ * @return Index des Punktes oder -1.
+ */
+int32_t findNearestInSpaceArrayScalar(const float *x, const float *y, int32_t count,
+        float positionX, float positionY, float *distanceSquared) {
+    int32_t nearest = -1;
+    float nearestDistanceSquared = *distanceSquared;
+    for (int32_t i = 0; i < count; ++i) {
+        float deltaX = x[i] - positionX;
+        float deltaY = y[i] - positionY;
+        float d = deltaX * deltaX + deltaY * deltaY;
+        if (d < nearestDistanceSquared) {
+            nearest = i;
+            nearestDistanceSquared = d;
+        }
+    }
+    *distanceSquared = nearestDistanceSquared;
+    return nearest;
+}
+
+#ifdef __SSE2__
+
+/**
+ * SSE2-Umsetzung von isSpaceArrayAreaFreeScalar(), prüft vier Punkte pro Instruktion.
+ */
+bool isSpaceArrayAreaFreeSse(const float *x, const float *y, int32_t count, float positionX,
+        float positionY, float minDistanceSquared) {
+    __m128 px = _mm_set1_ps(positionX);
+    __m128 py = _mm_set1_ps(positionY);
+    __m128 limit = _mm_set1_ps(minDistanceSquared);
+    int32_t i = 0;
+    for (; i + 4 <= count; i += 4) {
+        __m128 deltaX = _mm_sub_ps(_mm_loadu_ps(x + i), px);
+        __m128 deltaY = _mm_sub_ps(_mm_loadu_ps(y + i), py);
+        __m128 d = _mm_add_ps(_mm_mul_ps(deltaX, deltaX), _mm_mul_ps(deltaY, deltaY));
+        if (_mm_movemask_ps(_mm_cmple_ps(d, limit)) != 0) {
+            return false;
+        }
+    }
+    // verbleibende Punkte einzeln prüfen
+    return isSpaceArrayAreaFreeScalar(x + i, y + i, count - i, positionX, positionY,
+            minDistanceSquared);
+}
+
+/**
+ * SSE2-Umsetzung von findNearestInSpaceArrayScalar(), prüft vier Punkte pro Instruktion. Jede
+ * Spur merkt sich ihren nächsten Punkt, am Ende wird über die vier Spuren reduziert.
+ */
+int32_t findNearestInSpaceArraySse(const float *x, const float *y, int32_t count,
+        float positionX, float positionY, float *distanceSquared) {
+    __m128 px = _mm_set1_ps(positionX);
+    __m128 py = _mm_set1_ps(positionY);
+    __m128 best = _mm_set1_ps(*distanceSquared);
+    __m128i bestIndex = _mm_set1_epi32(-1);
+    __m128i index = _mm_set_epi32(3, 2, 1, 0);
+    __m128i four = _mm_set1_epi32(4);
+    int32_t i = 0;
+    for (; i + 4 <= count; i += 4) {
+        __m128 deltaX = _mm_sub_ps(_mm_loadu_ps(x + i), px);
+        __m128 deltaY = _mm_sub_ps(_mm_loadu_ps(y + i), py);
+        __m128 d = _mm_add_ps(_mm_mul_ps(deltaX, deltaX), _mm_mul_ps(deltaY, deltaY));
+        // nur echt kleinere Abstände übernehmen, so behält jede Spur den kleinsten Index
+        __m128 closer = _mm_cmplt_ps(d, best);
+        __m128i closerMask = _mm_castps_si128(closer);
+        best = _mm_or_ps(_mm_and_ps(closer, d), _mm_andnot_ps(closer, best));
+        bestIndex = _mm_or_si128(_mm_and_si128(closerMask, index),
+                _mm_andnot_si128(closerMask, bestIndex));
+        index = _mm_add_epi32(index, four);
+    }
+    float lanes[4];
+    int32_t laneIndices[4];
+    _mm_storeu_ps(lanes, best);
+    _mm_storeu_si128((__m128i*)laneIndices, bestIndex);
+    int32_t nearest = -1;
+    float nearestDistanceSquared = *distanceSquared;
+    for (int lane = 0; lane < 4; ++lane) {
+        if (laneIndices[lane] >= 0 && (lanes[lane] < nearestDistanceSquared
+                || (lanes[lane] == nearestDistanceSquared && laneIndices[lane] < nearest))) {
+            nearest = laneIndices[lane];
+            nearestDistanceSquared = lanes[lane];
+        }
+    }
+    // verbleibende Punkte einzeln prüfen, sie haben die größten Indizes
+    int32_t rest = findNearestInSpaceArrayScalar(x + i, y + i, count - i, positionX, positionY,
+            &nearestDistanceSquared);
+    if (rest >= 0) {
+        nearest = i + rest;
+    }
+    *distanceSquared = nearestDistanceSquared;
+    return nearest;
+}
+
+/*
+ * Schnellste verfügbare Umsetzung von isSpaceArrayAreaFreeScalar().
+ */
+IsSpaceArrayAreaFreeFunction isSpaceArrayAreaFree = isSpaceArrayAreaFreeSse;
+/*
+ * Schnellste verfügbare Umsetzung von findNearestInSpaceArrayScalar().
+ */
+FindNearestInSpaceArrayFunction findNearestInSpaceArray = findNearestInSpaceArraySse;
+
+#else
+
+/*
+ * Schnellste verfügbare Umsetzung von isSpaceArrayAreaFreeScalar().
+ */
+IsSpaceArrayAreaFreeFunction isSpaceArrayAreaFree = isSpaceArrayAreaFreeScalar;
+/*
+ * Schnellste verfügbare Umsetzung von findNearestInSpaceArrayScalar().
+ */
+FindNearestInSpaceArrayFunction findNearestInSpaceArray = findNearestInSpaceArrayScalar;
+
+#endif
+
+/**
+ * Erzeugt eine Pseudo-Zufallszahl von 0 bis range - 1. Anders als rand() hängt die Folge nur vom
+ * übergebenen Zustand ab, so dass jede Umsetzung mit denselben Daten geprüft wird.
+ *
+ * @param state Zustand des Generators.
+ * @param range Anzahl der möglichen Werte.
+ * @return Die Zahl.
+ */
+static int32_t nextTestValue(uint32_t *state, int32_t range) {
+    *state = *state * 1103515245u + 12345u;
+    return (int32_t)((*state >> 16) % (uint32_t)range);
+}
+
+/**
+ * Vergleicht eine Umsetzung der Abfragen mit der skalaren. Die Koordinaten liegen auf einem
+ * groben Raster, so dass viele Punkte denselben Abstand zur Position haben und die Reihenfolge bei
+ * gleichem Abstand mitgeprüft wird. Pro Durchgang kommen alle Längen von 0 bis 300 und alle
+ * Startpunkte modulo 4 vor.
+ *
+ * @param isAreaFree Umsetzung von isSpaceArrayAreaFreeScalar().
+ * @param findNearest Umsetzung von findNearestInSpaceArrayScalar().
+ * @param roundCount Anzahl der Durchgänge mit je 301 Abfragen.
+ * @return Anzahl der Abfragen, bei denen die Umsetzung von der skalaren abweicht.
+ */
+int32_t countSpaceKernelMismatches(IsSpaceArrayAreaFreeFunction isAreaFree,
+        FindNearestInSpaceArrayFunction findNearest, int32_t roundCount) {
+    static const int32_t MAX_COUNT = 300;
+    float x[MAX_COUNT + 4];
+    float y[MAX_COUNT + 4];
+    uint32_t state = 1;
+    int32_t mismatchCount = 0;
+    for (int32_t round = 0; round < roundCount; ++round) {
+        for (int32_t i = 0; i < MAX_COUNT + 4; ++i) {
+            x[i] = (nextTestValue(&state, 21) - 10) * 5.f;
+            y[i] = (nextTestValue(&state, 21) - 10) * 5.f;
+        }
+        for (int32_t count = 0; count <= MAX_COUNT; ++count) {
+            int32_t offset = nextTestValue(&state, 4);
+            float positionX = (nextTestValue(&state, 21) - 10) * 5.f;
+            float positionY = (nextTestValue(&state, 21) - 10) * 5.f;
+            float limit = nextTestValue(&state, 8) * 25.f;
+            float expectedDistance = limit;
+            int32_t expectedNearest = findNearestInSpaceArrayScalar(x + offset, y + offset, count,
+                    positionX, positionY, &expectedDistance);
+            float distance = limit;
+            int32_t nearest = findNearest(x + offset, y + offset, count, positionX, positionY,
+                    &distance);
+            if (isAreaFree(x + offset, y + offset, count, positionX, positionY, limit)
+                    != isSpaceArrayAreaFreeScalar(x + offset, y + offset, count, positionX,
+                            positionY, limit)
+                    || nearest != expectedNearest || distance != expectedDistance) {
+                ++mismatchCount;
+            }
+        }
+    }
+    return mismatchCount;
+}
+
+/**
+ * Wählt die NEON-Umsetzungen, wenn die Bibliothek für armeabi-v7a übersetzt wurde und der
+ * Prozessor NEON unterstützt (nicht alle ARMv7-Prozessoren tun das, z.B. Tegra 2).
+ *
+ * In Debug-Builds wird die gewählte Umsetzung mit countSpaceKernelMismatches() gegen die skalare
+ * geprüft, weil NEON nur auf dem Gerät läuft. Weicht sie ab, werden die skalaren Umsetzungen
+ * verwendet.
+ *
+ * @return false, wenn die gewählte Umsetzung von der skalaren abweicht.
+ */
+bool initSpaceKernels() {
+#ifdef HAVE_NEON_KERNELS
+    if (android_getCpuFamily() == ANDROID_CPU_FAMILY_ARM
+            && (android_getCpuFeatures() & ANDROID_CPU_ARM_FEATURE_NEON) != 0) {
+        isSpaceArrayAreaFree = isSpaceArrayAreaFreeNeon;
+        findNearestInSpaceArray = findNearestInSpaceArrayNeon;
+    }
+#endif
+#ifndef NDEBUG
+    if (countSpaceKernelMismatches(isSpaceArrayAreaFree, findNearestInSpaceArray,
+            SPACE_KERNEL_CHECK_ROUND_COUNT) != 0) {
+        isSpaceArrayAreaFree = isSpaceArrayAreaFreeScalar;
+        findNearestInSpaceArray = findNearestInSpaceArrayScalar;
+        return false;
+    }
+#endif
+    return true;
+}
+
+/**
+ * Gibt den Namen der verwendeten Umsetzung zurück.
+ *
+ * @return "NEON", "SSE2" oder "scalar".
+ */
+const char* getSpaceKernelName() {
+#ifdef HAVE_NEON_KERNELS
+    if (isSpaceArrayAreaFree == isSpaceArrayAreaFreeNeon) {
+        return "NEON";
+    }
+#endif
+#ifdef __SSE2__
+    if (isSpaceArrayAreaFree == isSpaceArrayAreaFreeSse) {
+        return "SSE2";
+    }
+#endif
+    return "scalar";
+}
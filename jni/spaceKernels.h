@@ -0,0 +1,60 @@
+/**
+ * @file spaceKernels.h
+ *
+ * @brief Schnittstelle zu spaceKernels.cpp und spaceKernelsNeon.cpp.
+ *
+ * @author Alexander Bertram
+ *
+ * @date 16.10.2026
+ */
+
+#ifndef SPACE_KERNELS_H
+#define SPACE_KERNELS_H
+
+#include <stdint.h>
+
+/**
+ * Prüft, ob alle Punkte eines Arrays weiter als ein Mindestabstand von einer Position entfernt
+ * sind (siehe isSpaceArrayAreaFreeScalar()).
+ */
+typedef bool (*IsSpaceArrayAreaFreeFunction)(const float*, const float*, int32_t, float, float,
+        float);
+/**
+ * Sucht den Punkt eines Arrays, der einer Position am nächsten liegt (siehe
+ * findNearestInSpaceArrayScalar()).
+ */
+typedef int32_t (*FindNearestInSpaceArrayFunction)(const float*, const float*, int32_t, float,
+        float, float*);
+
+/*
+ * Schnellste verfügbare Umsetzung von isSpaceArrayAreaFreeScalar() (verwaltet in
+ * spaceKernels.cpp).
+ */
+extern IsSpaceArrayAreaFreeFunction isSpaceArrayAreaFree;
+/*
+ * Schnellste verfügbare Umsetzung von findNearestInSpaceArrayScalar() (verwaltet in
+ * spaceKernels.cpp).
+ */
+extern FindNearestInSpaceArrayFunction findNearestInSpaceArray;
+
+/**
+ * Anzahl der Durchgänge von countSpaceKernelMismatches() beim Start eines Debug-Builds.
+ */
+#define SPACE_KERNEL_CHECK_ROUND_COUNT 20
+
+bool initSpaceKernels();
+const char* getSpaceKernelName();
+int32_t countSpaceKernelMismatches(IsSpaceArrayAreaFreeFunction, FindNearestInSpaceArrayFunction,
+        int32_t);
+bool isSpaceArrayAreaFreeScalar(const float*, const float*, int32_t, float, float, float);
+int32_t findNearestInSpaceArrayScalar(const float*, const float*, int32_t, float, float, float*);
+#ifdef __SSE2__
+bool isSpaceArrayAreaFreeSse(const float*, const float*, int32_t, float, float, float);
+int32_t findNearestInSpaceArraySse(const float*, const float*, int32_t, float, float, float*);
+#endif
+#ifdef HAVE_NEON_KERNELS
+bool isSpaceArrayAreaFreeNeon(const float*, const float*, int32_t, float, float, float);
+int32_t findNearestInSpaceArrayNeon(const float*, const float*, int32_t, float, float, float*);
+#endif
+
+#endif
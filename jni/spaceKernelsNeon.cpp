@@ -0,0 +1,93 @@
+/**
+ * @file spaceKernelsNeon.cpp
+ *
+ * @brief NEON-Umsetzungen der Abstandsabfragen aus spaceKernels.cpp.
+ *
+ * @details Die Datei wird nur für armeabi-v7a und mit NEON-Instruktionen übersetzt (Endung .neon
+ *      in Android.mk). Aufgerufen wird sie erst, wenn initSpaceKernels() NEON auf dem Prozessor
+ *      festgestellt hat. Multiplikation und Addition werden wie in der skalaren Umsetzung getrennt
+ *      gerundet, die Ergebnisse sind also bitgenau dieselben.
+ *
+ * @author Alexander Bertram
+ *
+ * @date 16.10.2026
+ */
+
+#ifdef HAVE_NEON_KERNELS
+
+#include <arm_neon.h>
+
+#include "spaceKernels.h"
+
+/**
+ * NEON-Umsetzung von isSpaceArrayAreaFreeScalar(), prüft vier Punkte pro Instruktion.
+ */
+bool isSpaceArrayAreaFreeNeon(const float *x, const float *y, int32_t count, float positionX,
+        float positionY, float minDistanceSquared) {
+    float32x4_t px = vdupq_n_f32(positionX);
+    float32x4_t py = vdupq_n_f32(positionY);
+    float32x4_t limit = vdupq_n_f32(minDistanceSquared);
+    int32_t i = 0;
+    for (; i + 4 <= count; i += 4) {
+        float32x4_t deltaX = vsubq_f32(vld1q_f32(x + i), px);
+        float32x4_t deltaY = vsubq_f32(vld1q_f32(y + i), py);
+        float32x4_t d = vaddq_f32(vmulq_f32(deltaX, deltaX), vmulq_f32(deltaY, deltaY));
+        uint32x4_t inside = vcleq_f32(d, limit);
+        uint32x2_t any = vorr_u32(vget_low_u32(inside), vget_high_u32(inside));
+        if ((vget_lane_u32(any, 0) | vget_lane_u32(any, 1)) != 0) {
+            return false;
+        }
+    }
+    // verbleibende Punkte einzeln prüfen
+    return isSpaceArrayAreaFreeScalar(x + i, y + i, count - i, positionX, positionY,
+            minDistanceSquared);
+}
+
+/**
+ * NEON-Umsetzung von findNearestInSpaceArrayScalar(), prüft vier Punkte pro Instruktion. Jede
+ * Spur merkt sich ihren nächsten Punkt, am Ende wird über die vier Spuren reduziert.
+ */
+int32_t findNearestInSpaceArrayNeon(const float *x, const float *y, int32_t count,
+        float positionX, float positionY, float *distanceSquared) {
+    static const int32_t FIRST_INDICES[4] = { 0, 1, 2, 3 };
+    float32x4_t px = vdupq_n_f32(positionX);
+    float32x4_t py = vdupq_n_f32(positionY);
+    float32x4_t best = vdupq_n_f32(*distanceSquared);
+    int32x4_t bestIndex = vdupq_n_s32(-1);
+    int32x4_t index = vld1q_s32(FIRST_INDICES);
+    int32x4_t four = vdupq_n_s32(4);
+    int32_t i = 0;
+    for (; i + 4 <= count; i += 4) {
+        float32x4_t deltaX = vsubq_f32(vld1q_f32(x + i), px);
+        float32x4_t deltaY = vsubq_f32(vld1q_f32(y + i), py);
+        float32x4_t d = vaddq_f32(vmulq_f32(deltaX, deltaX), vmulq_f32(deltaY, deltaY));
+        // nur echt kleinere Abstände übernehmen, so behält jede Spur den kleinsten Index
+        uint32x4_t closer = vcltq_f32(d, best);
+        best = vbslq_f32(closer, d, best);
+        bestIndex = vbslq_s32(closer, index, bestIndex);
+        index = vaddq_s32(index, four);
+    }
+    float lanes[4];
+    int32_t laneIndices[4];
+    vst1q_f32(lanes, best);
+    vst1q_s32(laneIndices, bestIndex);
+    int32_t nearest = -1;
+    float nearestDistanceSquared = *distanceSquared;
+    for (int lane = 0; lane < 4; ++lane) {
+        if (laneIndices[lane] >= 0 && (lanes[lane] < nearestDistanceSquared
+                || (lanes[lane] == nearestDistanceSquared && laneIndices[lane] < nearest))) {
+            nearest = laneIndices[lane];
+            nearestDistanceSquared = lanes[lane];
+        }
+    }
+    // verbleibende Punkte einzeln prüfen, sie haben die größten Indizes
+    int32_t rest = findNearestInSpaceArrayScalar(x + i, y + i, count - i, positionX, positionY,
+            &nearestDistanceSquared);
+    if (rest >= 0) {
+        nearest = i + rest;
+    }
+    *distanceSquared = nearestDistanceSquared;
+    return nearest;
+}
+
+#endif
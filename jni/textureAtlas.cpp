@@ -0,0 +1,205 @@
+/**
+ * @file textureAtlas.cpp
+ *
+ * @brief Beinhaltet Funktionen zum Zusammenfassen mehrerer Texturen zu einem Textur-Atlas.
+ *
+ * @details Die Texturen werden als Kacheln in einem Raster angeordnet. Um jede Kachel liegt ein
+ *      Rand, in dem die Randtexel der Kachel wiederholt werden. Dadurch greifen lineare Filterung
+ *      und die Mipmap-Stufen an den Kanten einer Kachel nicht auf die benachbarten Kacheln zu. Wie
+ *      viele Mipmap-Stufen davon profitieren, hängt von der Breite des Randes ab (siehe
+ *      TEXTURE_ATLAS_PADDING); in den kleinsten Stufen mischen sich benachbarte Kacheln.
+ *
+ *      Der Rand liegt innerhalb der Zelle, die Kacheln werden dafür verkleinert (z.B. von 256 auf
+ *      240 Texel). Kachel und Rand belegen so genau die Zweierpotenz der ursprünglichen Kachel,
+ *      und vier Kacheln mit 256 Texeln passen weiterhin in einen Atlas mit 512x512 Texeln statt
+ *      1024x1024.
+ *
+ * @author Alexander Bertram
+ *
+ * @date 16.10.2026
+ */
+
+#include <string.h>
+
+#include "textureAtlas.h"
+#include "utils.h"
+
+/**
+ * Bestimmt die kleinste Zweierpotenz, die mindestens so groß wie der übergebene Wert ist.
+ *
+ * @param value Der Wert.
+ * @return Die kleinste Zweierpotenz größer oder gleich value.
+ */
+static unsigned int nextPowerOfTwo(unsigned int value) {
+    unsigned int result = 1;
+    while (result < value) {
+        result <<= 1;
+    }
+    return result;
+}
+
+/**
+ * Verkleinert eine Kachel mit einem Box-Filter. Jeder Ziel-Texel ist der Mittelwert der von ihm
+ * überdeckten Quell-Texel, gewichtet mit ihrem überdeckten Anteil; die Farben werden zusätzlich
+ * wie in den Mipmap-Stufen mit dem Alpha-Wert gewichtet, damit transparente Texel nicht
+ * abfärben.
+ *
+ * @param tile Die Kachel (vier Kanäle).
+ * @param width Breite der verkleinerten Kachel in Texeln.
+ * @param height Höhe der verkleinerten Kachel in Texeln.
+ * @param pixels Erhält die Pixel der verkleinerten Kachel (width * height * 4 Byte).
+ */
+static void scaleTile(const Texture *tile, unsigned int width, unsigned int height,
+        unsigned char *pixels) {
+    const float scaleX = (float)tile->mWidth / width;
+    const float scaleY = (float)tile->mHeight / height;
+    for (unsigned int y = 0; y < height; ++y) {
+        // überdeckter Bereich der Quellzeilen
+        float top = y * scaleY;
+        float bottom = (y + 1) * scaleY;
+        for (unsigned int x = 0; x < width; ++x) {
+            float left = x * scaleX;
+            float right = (x + 1) * scaleX;
+            float color[3] = { 0.f, 0.f, 0.f };
+            float alpha = 0.f;
+            float weightSum = 0.f;
+            for (int row = (int)top; row < bottom && row < (int)tile->mHeight; ++row) {
+                float weightY = (row + 1 < bottom ? row + 1 : bottom) - (row > top ? row : top);
+                for (int column = (int)left; column < right && column < (int)tile->mWidth;
+                        ++column) {
+                    float weight = weightY * ((column + 1 < right ? column + 1 : right)
+                            - (column > left ? column : left));
+                    const unsigned char *texel =
+                            tile->mData + (row * tile->mWidth + column) * 4;
+                    for (int c = 0; c < 3; ++c) {
+                        color[c] += weight * texel[3] * texel[c];
+                    }
+                    alpha += weight * texel[3];
+                    weightSum += weight;
+                }
+            }
+            unsigned char *result = pixels + (y * width + x) * 4;
+            for (int c = 0; c < 3; ++c) {
+                result[c] = alpha == 0.f ? 0 : (unsigned char)(color[c] / alpha + 0.5f);
+            }
+            result[3] = (unsigned char)(alpha / weightSum + 0.5f);
+        }
+    }
+}
+
+/**
+ * Kopiert eine Kachel inklusive Rand in den Atlas. Im Rand werden die Randtexel der Kachel
+ * wiederholt.
+ *
+ * @param atlas Der Atlas.
+ * @param pixels Pixel der Kachel (vier Kanäle).
+ * @param width Breite der Kachel in Texeln.
+ * @param height Höhe der Kachel in Texeln.
+ * @param x Linke Kante der Kachel im Atlas (ohne Rand) in Texeln.
+ * @param y Untere Kante der Kachel im Atlas (ohne Rand) in Texeln.
+ * @param padding Breite des Randes in Texeln.
+ */
+static void copyTile(Texture *atlas, const unsigned char *pixels, int width, int height, int x,
+        int y, int padding) {
+    const int channelCount = atlas->mChannelCount;
+    const int tileRowSize = width * channelCount;
+    const int atlasRowSize = atlas->mWidth * channelCount;
+    for (int row = -padding; row < height + padding; ++row) {
+        // Zeile der Kachel, bei Zeilen im Rand die nächstgelegene Randzeile
+        int tileRow = row < 0 ? 0 : (row >= height ? height - 1 : row);
+        const unsigned char *source = pixels + tileRow * tileRowSize;
+        unsigned char *destination = atlas->mData + (y + row) * atlasRowSize + x * channelCount;
+        memcpy(destination, source, tileRowSize);
+        // linken und rechten Rand mit den Randtexeln auffüllen
+        for (int i = 1; i <= padding; ++i) {
+            memcpy(destination - i * channelCount, source, channelCount);
+            memcpy(destination + tileRowSize + (i - 1) * channelCount,
+                    source + tileRowSize - channelCount, channelCount);
+        }
+    }
+}
+
+/**
+ * Fasst Texturen zu einem Textur-Atlas zusammen.
+ *
+ * Alle Kacheln erhalten eine Zelle derselben Größe (größte Kachel). Der Rand liegt innerhalb der
+ * Zelle, die Kacheln werden dafür auf die Zellengröße abzüglich des Randes verkleinert (siehe
+ * scaleTile()). Die Anzahl der Spalten wird so gewählt, dass der Atlas, dessen Seitenlängen
+ * Zweierpotenzen sein müssen, möglichst wenig Fläche belegt.
+ *
+ * Die Texturen müssen vier Kanäle haben. Sie werden nicht verändert und nicht freigegeben.
+ *
+ * @param tiles Die zusammenzufassenden Texturen.
+ * @param tileCount Anzahl der Texturen.
+ * @param padding Breite des Randes um jede Kachel in Texeln.
+ * @param regions Erhält für jede Textur ihren Bereich im Atlas.
+ * @return Der erzeugte Atlas oder NULL, wenn eine der Texturen ungültig ist oder der Rand keinen
+ *      Platz für die Kacheln lässt.
+ */
+Texture* createTextureAtlas(Texture **tiles, int tileCount, int padding,
+        TextureAtlasRegion *regions) {
+    LOGD("createTextureAtlas: %d tiles", tileCount);
+    // Zellengröße bestimmen
+    unsigned int cellWidth = 0;
+    unsigned int cellHeight = 0;
+    for (int i = 0; i < tileCount; ++i) {
+        if (tiles[i] == NULL || tiles[i]->mData == NULL || tiles[i]->mChannelCount != 4) {
+            LOGE("createTextureAtlas: invalid tile %d", i);
+            return NULL;
+        }
+        if (tiles[i]->mWidth > cellWidth) {
+            cellWidth = tiles[i]->mWidth;
+        }
+        if (tiles[i]->mHeight > cellHeight) {
+            cellHeight = tiles[i]->mHeight;
+        }
+    }
+    // der Rand wird von der Zelle abgezogen, nicht hinzugefügt
+    if (cellWidth <= 2u * padding || cellHeight <= 2u * padding) {
+        LOGE("createTextureAtlas: padding %d too large for %ux%u cells", padding, cellWidth,
+                cellHeight);
+        return NULL;
+    }
+    unsigned int tileWidth = cellWidth - 2 * padding;
+    unsigned int tileHeight = cellHeight - 2 * padding;
+    // Anzahl der Spalten mit der kleinsten Atlas-Fläche wählen, bei gleicher Fläche die
+    // quadratischere Anordnung
+    int columnCount = 0;
+    unsigned int width = 0;
+    unsigned int height = 0;
+    for (int columns = 1; columns <= tileCount; ++columns) {
+        int rows = (tileCount + columns - 1) / columns;
+        unsigned int w = nextPowerOfTwo(columns * cellWidth);
+        unsigned int h = nextPowerOfTwo(rows * cellHeight);
+        bool smaller = w * h < width * height;
+        bool squarer = w * h == width * height && (w > h ? w - h : h - w)
+                < (width > height ? width - height : height - width);
+        if (columnCount == 0 || smaller || squarer) {
+            columnCount = columns;
+            width = w;
+            height = h;
+        }
+    }
+    // Atlas anlegen, ungenutzte Bereiche bleiben transparent
+    Texture *atlas = new Texture();
+    atlas->mWidth = width;
+    atlas->mHeight = height;
+    atlas->mChannelCount = 4;
+    atlas->mData = new unsigned char[width * height * atlas->mChannelCount];
+    memset(atlas->mData, 0, width * height * atlas->mChannelCount);
+    // Kacheln verkleinern, kopieren und ihre Bereiche in Textur-Koordinaten berechnen
+    unsigned char *pixels = new unsigned char[tileWidth * tileHeight * 4];
+    for (int i = 0; i < tileCount; ++i) {
+        int x = (i % columnCount) * cellWidth + padding;
+        int y = (i / columnCount) * cellHeight + padding;
+        scaleTile(tiles[i], tileWidth, tileHeight, pixels);
+        copyTile(atlas, pixels, tileWidth, tileHeight, x, y, padding);
+        regions[i].offset[0] = (float)x / width;
+        regions[i].offset[1] = (float)y / height;
+        regions[i].scale[0] = (float)tileWidth / width;
+        regions[i].scale[1] = (float)tileHeight / height;
+    }
+    delete[] pixels;
+    LOGI("createTextureAtlas: %ux%u texels, %d columns", width, height, columnCount);
+    return atlas;
+}
@@ -0,0 +1,19 @@
+/**
+ * @file textureAtlas.h
+ *
+ * @brief Schnittstelle zu textureAtlas.cpp.
+ *
+ * @author Alexander Bertram
+ *
+ * @date 16.10.2026
+ */
+
+#ifndef TEXTURE_ATLAS_H
+#define TEXTURE_ATLAS_H
+
+#include "Texture.h"
+#include "types.h"
+
+Texture* createTextureAtlas(Texture**, int, int, TextureAtlasRegion*);
+
+#endif
@@ -0,0 +1,280 @@
+/**
+ * @file textureLoader.cpp
+ *
+ * @brief Verwaltet die Texturen: Laden in einem eigenen Thread, Hochladen in den Grafikspeicher und
+ *      erneutes Laden nach dem Verlust des GL-Kontextes.
+ *
+ * @details Der Lade-Thread liest und dekodiert die Texturen aus dem Android Package und legt jede
+ *      fertige Textur in eine Warteschlange. Der GL-Thread lädt sie in initRendering und vor jedem
+ *      Frame mit uploadLoadedTextures() in den Grafikspeicher und trägt sie erst dann in textures
+ *      ein. Bis dahin bleibt der Eintrag NULL und der Renderer lässt das Spielfeld aus. Der
+ *      Lade-Thread ruft keine GL-Funktionen auf.
+ *
+ *      Nach dem Hochladen werden die Pixel-Daten im Hauptspeicher freigegeben. Statt ihrer merkt
+ *      sich die Verwaltung, woher jede Textur stammt (TEXTURE_SOURCES). Geht der GL-Kontext
+ *      verloren, lädt reloadTextures() die Texturen auf dieselbe Weise erneut im Hintergrund.
+ *
+ * @author Alexander Bertram
+ *
+ * @date 16.10.2026
+ */
+
+#include <pthread.h>
+#include <stddef.h>
+
+#include "constants.h"
+#include "ktxTexture.h"
+#include "Texture.h"
+#include "textureAtlas.h"
+#include "textureLoader.h"
+#include "timeUtilities.h"
+#include "types.h"
+#include "utils.h"
+
+/**
+ * @brief Fertig geladene Textur in der Warteschlange.
+ */
+typedef struct LoadedTexture {
+    /**
+     * Index in textures.
+     */
+    int index;
+    /**
+     * Die Textur, noch nicht im Grafikspeicher.
+     */
+    Texture *texture;
+} LoadedTexture;
+
+/**
+ * Texturen (verwaltet in invisiboga.cpp).
+ */
+extern Texture *textures[];
+/**
+ * Bereiche der Feld-Texturen im Textur-Atlas (verwaltet in invisiboga.cpp).
+ */
+extern TextureAtlasRegion spaceTextureRegions[];
+/**
+ * Spielfeld (verwaltet in field.cpp).
+ */
+extern Field field;
+/**
+ * Namen der PNG-Dateien der Feld-Texturen im Verzeichnis "assets". Die Reihenfolge entspricht
+ * SpaceType.
+ */
+static const char *SPACE_TEXTURE_FILE_NAMES[SPACE_TYPE_COUNT] = { "startSpace.png", "space.png",
+        "specialSpace.png", "targetSpace.png" };
+/**
+ * Asset-Manager, aus dem der Lade-Thread liest.
+ */
+static AAssetManager *loaderAssetManager = NULL;
+/**
+ * Der Lade-Thread.
+ */
+static pthread_t loaderThread;
+/**
+ * Flag, das anzeigt, ob der Lade-Thread gestartet wurde und noch nicht beendet ist.
+ */
+static bool loaderRunning = false;
+/**
+ * Zeitpunkt, zu dem der Lade-Thread gestartet wurde.
+ */
+static unsigned long loaderStartTime;
+/**
+ * Schützt die Warteschlange.
+ */
+static pthread_mutex_t queueMutex = PTHREAD_MUTEX_INITIALIZER;
+/**
+ * Warteschlange der fertig geladenen Texturen.
+ */
+static LoadedTexture loadedTextures[TEXTURE_COUNT];
+/**
+ * Anzahl der Texturen in der Warteschlange.
+ */
+static int loadedTextureCount = 0;
+
+/**
+ * Lädt den Textur-Atlas der Felder. Bevorzugt wird der vorberechnete, komprimierte Atlas; nur wenn
+ * er fehlt, werden die PNG-Dateien dekodiert und zur Laufzeit zusammengesetzt.
+ *
+ * @return Der Textur-Atlas oder NULL.
+ */
+static Texture* loadSpaceTextureAtlas() {
+    Texture *atlas = loadCompressedTextureAtlas(loaderAssetManager, SPACE_TEXTURE_ATLAS_FILE_NAME,
+            SPACE_TEXTURE_ATLAS_ALPHA_FILE_NAME, spaceTextureRegions, SPACE_TYPE_COUNT);
+    if (atlas != NULL) {
+        return atlas;
+    }
+    Texture *tiles[SPACE_TYPE_COUNT];
+    for (int i = 0; i < SPACE_TYPE_COUNT; ++i) {
+        tiles[i] = Texture::load(loaderAssetManager, SPACE_TEXTURE_FILE_NAMES[i]);
+    }
+    // Feld-Texturen zu einem Atlas zusammenfassen, damit das Spielfeld ohne Textur-Wechsel
+    // gerendert werden kann
+    atlas = createTextureAtlas(tiles, SPACE_TYPE_COUNT, TEXTURE_ATLAS_PADDING, spaceTextureRegions);
+    for (int i = 0; i < SPACE_TYPE_COUNT; ++i) {
+        delete tiles[i];
+    }
+    return atlas;
+}
+
+/**
+ * Funktion, die eine Textur aus dem Android Package lädt.
+ */
+typedef Texture* (*TextureSource)();
+/**
+ * Herkunft der Texturen, Index wie in textures.
+ */
+static const TextureSource TEXTURE_SOURCES[TEXTURE_COUNT] = { loadSpaceTextureAtlas };
+/**
+ * Flags, die anzeigen, welche Texturen der Lade-Thread laden soll. Werden nur vor dem Start des
+ * Lade-Threads geschrieben.
+ */
+static bool texturesRequested[TEXTURE_COUNT];
+
+/**
+ * Legt eine fertig geladene Textur in die Warteschlange.
+ *
+ * @param index Index in textures.
+ * @param texture Die Textur oder NULL, wenn sie nicht geladen werden konnte.
+ */
+static void queueLoadedTexture(int index, Texture *texture) {
+    if (texture == NULL) {
+        LOGE("queueLoadedTexture: texture %d could not be loaded", index);
+        return;
+    }
+    pthread_mutex_lock(&queueMutex);
+    loadedTextures[loadedTextureCount].index = index;
+    loadedTextures[loadedTextureCount].texture = texture;
+    ++loadedTextureCount;
+    pthread_mutex_unlock(&queueMutex);
+}
+
+/**
+ * Einstiegspunkt des Lade-Threads.
+ *
+ * @param argument Nicht verwendet.
+ * @return NULL.
+ */
+static void* loadTextures(void*) {
+    for (int i = 0; i < TEXTURE_COUNT; ++i) {
+        if (texturesRequested[i]) {
+            queueLoadedTexture(i, TEXTURE_SOURCES[i]());
+        }
+    }
+    LOG("loadTextures: done after %lu ms", getCurrentTimeInMs() - loaderStartTime);
+    return NULL;
+}
+
+/**
+ * Startet den Lade-Thread für die angeforderten Texturen. Kehrt sofort zurück.
+ */
+static void startLoaderThread() {
+    loaderStartTime = getCurrentTimeInMs();
+    loaderRunning = pthread_create(&loaderThread, NULL, loadTextures, NULL) == 0;
+    if (!loaderRunning) {
+        // ohne Thread wird synchron geladen
+        LOGE("startTextureLoader: could not create thread, loading synchronously");
+        loadTextures(NULL);
+    }
+}
+
+/**
+ * Startet das Laden aller Texturen im Hintergrund. Kehrt sofort zurück.
+ *
+ * @param assetManager Der Asset-Manager des Android Packages. Muss gültig bleiben, bis
+ *      stopTextureLoader() aufgerufen wurde.
+ */
+void startTextureLoader(AAssetManager *assetManager) {
+    loaderAssetManager = assetManager;
+    for (int i = 0; i < TEXTURE_COUNT; ++i) {
+        texturesRequested[i] = true;
+    }
+    startLoaderThread();
+}
+
+/**
+ * Wartet auf das Ende des Lade-Threads und gibt alle noch nicht hochgeladenen Texturen frei.
+ */
+void stopTextureLoader() {
+    if (loaderRunning) {
+        pthread_join(loaderThread, NULL);
+        loaderRunning = false;
+    }
+    pthread_mutex_lock(&queueMutex);
+    for (int i = 0; i < loadedTextureCount; ++i) {
+        delete loadedTextures[i].texture;
+    }
+    loadedTextureCount = 0;
+    pthread_mutex_unlock(&queueMutex);
+    loaderAssetManager = NULL;
+}
+
+/**
+ * Lädt alle Texturen aus der Warteschlange in den Grafikspeicher, gibt ihre Pixel-Daten frei und
+ * trägt sie in textures ein. Muss im GL-Thread nach initRenderer() aufgerufen werden.
+ *
+ * @return Anzahl der hochgeladenen Texturen.
+ */
+int uploadLoadedTextures() {
+    LoadedTexture pending[TEXTURE_COUNT];
+    pthread_mutex_lock(&queueMutex);
+    int pendingCount = loadedTextureCount;
+    for (int i = 0; i < pendingCount; ++i) {
+        pending[i] = loadedTextures[i];
+    }
+    loadedTextureCount = 0;
+    pthread_mutex_unlock(&queueMutex);
+    if (pendingCount == 0) {
+        return 0;
+    }
+    unsigned int residentSizeBefore = 0;
+    for (int i = 0; i < pendingCount; ++i) {
+        Texture *texture = pending[i].texture;
+        residentSizeBefore += texture->getPixelDataSize();
+        texture->upload();
+        // die Pixel-Daten werden erst nach einem Verlust des GL-Kontextes wieder gebraucht und
+        // dann neu geladen
+        texture->releasePixelData();
+        delete textures[pending[i].index];
+        textures[pending[i].index] = texture;
+        LOG("uploadLoadedTextures: texture %d ready after %lu ms", pending[i].index,
+                getCurrentTimeInMs() - loaderStartTime);
+    }
+    unsigned int residentSize = 0;
+    for (int i = 0; i < TEXTURE_COUNT; ++i) {
+        residentSize += textures[i] != NULL ? textures[i]->getPixelDataSize() : 0;
+    }
+    LOG("uploadLoadedTextures: resident texture memory %u bytes before upload, %u bytes after",
+            residentSizeBefore, residentSize);
+    // die Textur-Koordinaten des Spielfeldes hängen von den Bereichen im Atlas ab
+    field.dirty = true;
+    return pendingCount;
+}
+
+/**
+ * Lädt nach dem Verlust des GL-Kontextes alle bereits hochgeladenen Texturen im Hintergrund neu,
+ * da ihre Pixel-Daten freigegeben wurden und die Textur-Objekte mit dem alten Kontext verloren
+ * gegangen sind. Bis sie fertig sind, bleiben ihre Einträge in textures NULL. Muss im GL-Thread
+ * aufgerufen werden.
+ */
+void reloadTextures() {
+    // einen früheren Lade-Thread zuerst beenden, er liest texturesRequested noch
+    if (loaderRunning) {
+        pthread_join(loaderThread, NULL);
+        loaderRunning = false;
+    }
+    int reloadCount = 0;
+    for (int i = 0; i < TEXTURE_COUNT; ++i) {
+        texturesRequested[i] = textures[i] != NULL;
+        if (textures[i] != NULL) {
+            delete textures[i];
+            textures[i] = NULL;
+            ++reloadCount;
+        }
+    }
+    if (reloadCount == 0 || loaderAssetManager == NULL) {
+        return;
+    }
+    LOG("reloadTextures: reloading %d textures", reloadCount);
+    startLoaderThread();
+}
@@ -0,0 +1,21 @@
+/**
+ * @file textureLoader.h
+ *
+ * @brief Schnittstelle zu textureLoader.cpp.
+ *
+ * @author Alexander Bertram
+ *
+ * @date 16.10.2026
+ */
+
+#ifndef TEXTURE_LOADER_H
+#define TEXTURE_LOADER_H
+
+#include <android/asset_manager.h>
+
+void startTextureLoader(AAssetManager*);
+void stopTextureLoader();
+int uploadLoadedTextures();
+void reloadTextures();
+
+#endif
@@ -8,6 +8,7 @@
  * @date 05.06.2011
  */
 
+#include <stddef.h>
 #include <sys/time.h>
 
 /**
@@ -11,10 +11,17 @@
 #ifndef TYPES_H
 #define TYPES_H
 
+#include <android/asset_manager.h>
+
 #include <GLES/gl.h>
 
 #include <QCAR/Renderer.h>
 
+#include "boardFile.h"
+#include "ktxFile.h"
+#include "meshFile.h"
+#include "spaceGrid.h"
+
 /**
  * Aktion, die der Benutzer auf dem Touchscreen ausführt.
  */
@@ -37,6 +44,12 @@ enum ActionType {
     ACTION_CANCEL
 };
 
+/**
+ * Maximale Anzahl der Bildschirm-Positionen einer Druck-Geste, die zwischen zwei Frames
+ * zwischengespeichert werden.
+ */
+#define MAX_TOUCH_POINT_COUNT 64
+
 /**
  * @brief Touch-Ereignis.
  */
@@ -85,8 +98,36 @@ typedef struct TouchEvent {
      * Flag, das anzeigt, ob die Geste aktiv ist.
      */
     bool isActive;
+    /**
+     * Bildschirm-Positionen der Druck-Geste seit dem letzten Frame in der Reihenfolge ihres
+     * Auftretens. Ist der Puffer voll, wird die letzte Position überschrieben.
+     */
+    QCAR::Vec2F points[MAX_TOUCH_POINT_COUNT];
+    /**
+     * Anzahl der Positionen in points.
+     */
+    int pointCount;
 } TouchEvent;
 
+/**
+ * @brief Zieh-Pfad des Fingers in Koordinaten des Trackables, der in gleichen Abständen abgetastet
+ * wird.
+ */
+typedef struct DragPath {
+    /**
+     * Flag, das anzeigt, ob der Pfad bereits einen Punkt hat.
+     */
+    bool started;
+    /**
+     * Letzter Punkt des Pfades.
+     */
+    QCAR::Vec2F lastPoint;
+    /**
+     * Länge des Pfades seit der letzten Abtastung.
+     */
+    float distanceSinceSample;
+} DragPath;
+
 /**
  * Feld-Art. Die Reihenfolge muss der Reihenfolge der Texturen aus dem Java-Code entsprechen.
  */
@@ -106,7 +147,11 @@ enum SpaceType {
     /**
      * Ziel-Feld.
      */
-    TARGET_SPACE
+    TARGET_SPACE,
+    /**
+     * Anzahl der Feld-Typen.
+     */
+    SPACE_TYPE_COUNT
 };
 
 /**
@@ -129,6 +174,11 @@ typedef struct Space {
      * Winkel, um den das Feld bzw. die Feld-Textur beim Rendern gedrehen werden soll.
      */
     float angle;
+    /**
+     * Zwischengespeicherte 2x2-Matrix (spaltenweise) aus Drehung um angle und Skalierung auf
+     * SPACE_RADIUS. Wird nur bei einer Änderung des Winkels über setSpaceAngle() neu berechnet.
+     */
+    float rotationScale[4];
     /**
      * Flag, das anzeigt, ob ein Feld durch eine Spielfigur besetzt ist.
      */
@@ -136,15 +186,64 @@ typedef struct Space {
 } Space;
 
 /**
- * Maximale Anzahl der Felder.
+ * Maximale Anzahl der Felder. Bei SPACE_VERTEX_COUNT (4) Vertices pro Feld passen die Indizes der
+ * Vertices des Spielfeldes damit gerade noch in einen GLushort.
  *
  * Diese Konstante musste hier definiert werden, um Probleme aufgrund von zyklischen Abhängigkeiten
  * zwischen constants.h und types.h zu umgehen.
  */
-#define MAX_SPACE_COUNT 100
+#define MAX_SPACE_COUNT 16384
+/**
+ * Zweierlogarithmus der Anzahl der Felder in einem Block.
+ */
+#define SPACE_CHUNK_SHIFT 7
+/**
+ * Anzahl der Felder in einem Block. Der erste Block liegt im Spielfeld selbst, kleine Spielfelder
+ * kommen also ohne Speicheranforderung aus.
+ */
+#define SPACE_CHUNK_SIZE (1 << SPACE_CHUNK_SHIFT)
+/**
+ * Maximale Anzahl der Blöcke.
+ */
+#define MAX_SPACE_CHUNK_COUNT (MAX_SPACE_COUNT / SPACE_CHUNK_SIZE)
+
+/**
+ * @brief Block von Feldern.
+ *
+ * Neben den Feldern enthält jeder Block Position, Typ und Besetzt-Flag der Felder noch einmal als
+ * getrennte Arrays (Structure of Arrays). Abstandsabfragen lesen so nur die x- und y-Koordinaten
+ * und können mehrere Felder pro SIMD-Instruktion prüfen (siehe spaceKernels.cpp). Die Arrays
+ * werden in field.cpp zusammen mit den Feldern aktualisiert.
+ */
+typedef struct SpaceChunk {
+    /**
+     * X-Koordinaten der Felder.
+     */
+    float x[SPACE_CHUNK_SIZE];
+    /**
+     * Y-Koordinaten der Felder.
+     */
+    float y[SPACE_CHUNK_SIZE];
+    /**
+     * Typen der Felder (SpaceType).
+     */
+    uint8_t types[SPACE_CHUNK_SIZE];
+    /**
+     * Besetzt-Flags der Felder, ein Bit pro Feld.
+     */
+    uint32_t occupied[SPACE_CHUNK_SIZE / 32];
+    /**
+     * Felder.
+     */
+    Space spaces[SPACE_CHUNK_SIZE];
+} SpaceChunk;
 
 /**
  * @brief Spielfeld.
+ *
+ * Die Felder liegen in Blöcken von SPACE_CHUNK_SIZE Feldern. Ein Block wird nie verschoben, Zeiger
+ * auf Felder (z.B. Pawn::currentSpace) bleiben also gültig, während das Spielfeld wächst. Auf ein
+ * Feld wird über getSpace() zugegriffen.
  */
 typedef struct Field {
     /**
@@ -152,9 +251,33 @@ typedef struct Field {
      */
     int length;
     /**
-     * Felder.
+     * Anzahl der Blöcke, für die Speicher vorhanden ist. Beim Leeren des Spielfeldes bleiben die
+     * Blöcke erhalten und werden für die nächsten Felder wiederverwendet.
+     */
+    int chunkCount;
+    /**
+     * Blöcke der Felder, der erste zeigt auf firstChunk.
+     */
+    SpaceChunk *chunks[MAX_SPACE_CHUNK_COUNT];
+    /**
+     * Speicher für den ersten Block.
+     */
+    SpaceChunk firstChunk;
+    /**
+     * Räumliches Gitter über den Positionen der Felder für Abstandsabfragen. Die Indizes im Gitter
+     * entsprechen den Indizes der Felder.
+     */
+    SpaceGrid grid;
+    /**
+     * Name des Markers, auf dem das Spielfeld erstellt wurde, oder eine leere Zeichenkette, solange
+     * noch kein Marker erkannt wurde. Wird mit dem Spielfeld gespeichert.
+     */
+    char markerName[BOARD_FILE_MARKER_NAME_LENGTH];
+    /**
+     * Flag, das anzeigt, ob sich das Spielfeld seit dem letzten Aufbau der Render-Daten geändert
+     * hat.
      */
-    Space spaces[MAX_SPACE_COUNT];
+    bool dirty;
 } Field;
 
 /**
@@ -237,6 +360,18 @@ typedef struct Pawn {
      * Licht, von dem die Spielfigur beleuchtet wird.
      */
     Light light;
+    /**
+     * Detailstufe, mit der die Spielfigur zuletzt gerendert wurde.
+     */
+    int levelOfDetail;
+    /**
+     * Flag, das anzeigt, ob die Spielfigur beim letzten vorbereiteten Frame im Sichtbereich lag.
+     */
+    bool visible;
+    /**
+     * Model-View-Matrix der Spielfigur aus dem letzten vorbereiteten Frame.
+     */
+    QCAR::Matrix44F modelViewMatrix;
 } Pawn;
 
 /**
@@ -359,4 +494,242 @@ typedef struct Player {
     unsigned int continueTime;
 } Player;
 
+/**
+ * @brief Model, dessen Daten direkt aus einer Model-Datei (siehe meshFile.h) im Android Package
+ * gelesen werden.
+ */
+typedef struct Mesh {
+    /**
+     * Asset der Model-Datei. Bleibt geöffnet, solange die Daten verwendet werden.
+     */
+    AAsset *asset;
+    /**
+     * Kopie der Model-Datei, falls das Asset nicht ausgerichtet in den Speicher abgebildet werden
+     * konnte, sonst NULL.
+     */
+    void *buffer;
+    /**
+     * Header der Model-Datei.
+     */
+    const MeshFileHeader *header;
+    /**
+     * Detailstufen, beginnend mit der vollen Detailstufe.
+     */
+    const MeshLevelOfDetail *levelsOfDetail;
+    /**
+     * Vertices (Position und Normale).
+     */
+    const MeshVertex *vertices;
+    /**
+     * Indizes (jeweils drei pro Dreieck) aller Detailstufen.
+     */
+    const GLushort *indices;
+    /**
+     * Umkugel in Model-Koordinaten (Mittelpunkt x, y, z und Radius), beim Laden berechnet.
+     */
+    float boundingSphere[4];
+} Mesh;
+
+/**
+ * @brief Komprimierte Textur, deren Daten direkt aus einer KTX-Datei (siehe ktxFile.h) im Android
+ * Package gelesen werden.
+ */
+typedef struct KtxImage {
+    /**
+     * Asset der KTX-Datei. Bleibt geöffnet, solange die Daten verwendet werden.
+     */
+    AAsset *asset;
+    /**
+     * Kopie der KTX-Datei, falls das Asset nicht ausgerichtet in den Speicher abgebildet werden
+     * konnte, sonst NULL.
+     */
+    void *buffer;
+    /**
+     * Header der KTX-Datei.
+     */
+    const KtxFileHeader *header;
+    /**
+     * Schlüssel-Wert-Paare.
+     */
+    const uint8_t *keyValueData;
+    /**
+     * Daten der Mipmap-Stufen, beginnend mit der größten.
+     */
+    const uint8_t *levels[KTX_MAX_MIPMAP_LEVEL_COUNT];
+    /**
+     * Größen der Mipmap-Stufen in Byte.
+     */
+    uint32_t levelSizes[KTX_MAX_MIPMAP_LEVEL_COUNT];
+} KtxImage;
+
+/**
+ * @brief Bereich einer Textur in einem Textur-Atlas. Eine Textur-Koordinate (u, v) der Textur
+ * entspricht der Textur-Koordinate offset + scale * (u, v) im Atlas.
+ */
+typedef struct TextureAtlasRegion {
+    /**
+     * Linke untere Ecke des Bereiches in Textur-Koordinaten des Atlas.
+     */
+    GLfloat offset[2];
+    /**
+     * Größe des Bereiches in Textur-Koordinaten des Atlas.
+     */
+    GLfloat scale[2];
+} TextureAtlasRegion;
+
+/**
+ * @brief Vertex des Spielfeldes. Die Position ist bereits in Koordinaten des Trackables
+ * transformiert, damit das ganze Spielfeld ohne Matrix-Wechsel gerendert werden kann.
+ */
+typedef struct FieldVertex {
+    /**
+     * Position in der Ebene des Trackables.
+     */
+    GLfloat position[2];
+    /**
+     * Textur-Koordinate.
+     */
+    GLfloat textureCoordinate[2];
+} FieldVertex;
+
+/**
+ * @brief Statistik über das Rendern, die in regelmäßigen Abständen ausgegeben wird.
+ */
+typedef struct RenderStatistics {
+    /**
+     * Anzahl der gerenderten Frames.
+     */
+    unsigned int frameCount;
+    /**
+     * Anzahl der Frames, in denen sich nichts verändert hat und die Vorbereitung übersprungen
+     * wurde.
+     */
+    unsigned int idleFrameCount;
+    /**
+     * Anzahl der Zeichenaufrufe (glDrawArrays und glDrawElements).
+     */
+    unsigned int drawCallCount;
+    /**
+     * Anzahl der ausgeführten Zustandsänderungen.
+     */
+    unsigned int stateChangeCount;
+    /**
+     * Anzahl der verworfenen, redundanten Zustandsänderungen.
+     */
+    unsigned int suppressedStateChangeCount;
+    /**
+     * Anzahl der Felder im Sichtbereich.
+     */
+    unsigned int visibleSpaceCount;
+    /**
+     * Anzahl der Felder außerhalb des Sichtbereiches.
+     */
+    unsigned int culledSpaceCount;
+    /**
+     * Anzahl der Spielfiguren im Sichtbereich.
+     */
+    unsigned int visiblePawnCount;
+    /**
+     * Anzahl der Spielfiguren außerhalb des Sichtbereiches.
+     */
+    unsigned int culledPawnCount;
+} RenderStatistics;
+
+/**
+ * @brief Sichtbereich (View-Frustum) als sechs Ebenen (links, rechts, unten, oben, nah, fern).
+ * Jede Ebene ist durch ihre normierte, nach innen zeigende Normale und ihren Abstand zum Ursprung
+ * gegeben (a, b, c, d mit a * x + b * y + c * z + d >= 0 für Punkte im Sichtbereich).
+ */
+typedef struct Frustum {
+    /**
+     * Ebenen des Sichtbereiches.
+     */
+    float planes[6][4];
+} Frustum;
+
+/**
+ * @brief Für einen Frame vorberechnete Projektion von Bildschirm-Positionen auf die Ebene des
+ * Trackables (z = 0), siehe projectScreenPointsToPlane().
+ */
+typedef struct ScreenPlaneProjection {
+    /**
+     * Skalierung von Bildschirm- in normalisierte Geräte-Koordinaten.
+     */
+    float scale[2];
+    /**
+     * Verschiebung von Bildschirm- in normalisierte Geräte-Koordinaten.
+     */
+    float offset[2];
+    /**
+     * Inverse Projektionsmatrix.
+     */
+    QCAR::Matrix44F inverseProjectionMatrix;
+    /**
+     * Inverse Model-View-Matrix.
+     */
+    QCAR::Matrix44F inverseModelViewMatrix;
+} ScreenPlaneProjection;
+
+/**
+ * @brief Zwischengespeicherter Array-Pointer (glVertexPointer, glNormalPointer, glTexCoordPointer
+ * oder glVertexAttribPointer).
+ */
+typedef struct GlArrayPointer {
+    /**
+     * Flag, das anzeigt, ob der Array-Pointer bekannt ist.
+     */
+    bool valid;
+    /**
+     * Beim Setzen gebundener GL_ARRAY_BUFFER.
+     */
+    GLuint buffer;
+    /**
+     * Anzahl der Komponenten pro Vertex.
+     */
+    GLint size;
+    /**
+     * Datentyp der Komponenten.
+     */
+    GLenum type;
+    /**
+     * Flag, das anzeigt, ob Ganzzahl-Komponenten auf [-1, 1] bzw. [0, 1] abgebildet werden (nur
+     * bei Vertex-Attributen von OpenGL ES 2.0).
+     */
+    GLboolean normalized;
+    /**
+     * Abstand zwischen zwei Vertices in Bytes.
+     */
+    GLsizei stride;
+    /**
+     * Offset im gebundenen Buffer.
+     */
+    const GLvoid *pointer;
+} GlArrayPointer;
+
+/**
+ * Vertex-Buffer-Objekte, in denen die statische Geometrie im Grafikspeicher abgelegt wird.
+ */
+enum VertexBufferObject {
+    /**
+     * Vertices der Spielfigur (Positionen und Normale verschränkt).
+     */
+    PAWN_VERTEX_BUFFER,
+    /**
+     * Indizes der Spielfigur.
+     */
+    PAWN_INDEX_BUFFER,
+    /**
+     * Vertices des gesamten Spielfeldes (Positionen und Textur-Koordinaten verschränkt).
+     */
+    FIELD_VERTEX_BUFFER,
+    /**
+     * Indizes der sichtbaren Felder.
+     */
+    FIELD_INDEX_BUFFER,
+    /**
+     * Anzahl der Vertex-Buffer-Objekte.
+     */
+    VERTEX_BUFFER_OBJECT_COUNT
+};
+
 #endif
@@ -12,6 +12,7 @@
 
 #include <math.h>
 #include <stdlib.h>
+#include <string.h>
 
 #include <GLES/gl.h>
 #include <GLES/glext.h>
@@ -38,6 +39,25 @@ void checkGlError(const char* operation) {
     }
 }
 
+/**
+ * Prüft, ob der aktuelle GL-Kontext eine Erweiterung unterstützt.
+ *
+ * @param extension Name der Erweiterung.
+ * @return true, wenn die Erweiterung in GL_EXTENSIONS als ganzes Wort vorkommt.
+ */
+bool isGlExtensionSupported(const char* extension) {
+    const char* extensions = (const char*)glGetString(GL_EXTENSIONS);
+    size_t length = strlen(extension);
+    for (const char* found = extensions != NULL ? strstr(extensions, extension) : NULL;
+            found != NULL; found = strstr(found + length, extension)) {
+        if ((found == extensions || found[-1] == ' ')
+                && (found[length] == ' ' || found[length] == '\0')) {
+            return true;
+        }
+    }
+    return false;
+}
+
 /**
  * Gibt die kleinere Zahl zurück.
  *
@@ -37,6 +37,7 @@
 
 void printMatrix(const float* matrix);
 void checkGlError(const char* operation);
+bool isGlExtensionSupported(const char* extension);
 int min(int a, int b);
 int max(int a, int b);
 
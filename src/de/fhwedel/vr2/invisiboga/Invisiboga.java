@@ -1,12 +1,14 @@
 package de.fhwedel.vr2.invisiboga;
 
-import java.util.Vector;
-
 import android.app.Activity;
+import android.app.ActivityManager;
 import android.app.AlertDialog;
 import android.app.ProgressDialog;
+import android.content.Context;
 import android.content.DialogInterface;
+import android.content.res.AssetManager;
 import android.content.pm.ActivityInfo;
+import android.content.pm.ConfigurationInfo;
 import android.os.AsyncTask;
 import android.os.Bundle;
 import android.util.DisplayMetrics;
@@ -90,9 +92,10 @@ public class Invisiboga extends Activity {
      */
     private int mAppStatus = APP_STATUS_UNINITED;
     /**
-     * Texturen.
+     * QCAR-Initialisierungs-Flags, die die OpenGL-ES-Version festlegen
+     * (QCAR.GL_20 oder QCAR.GL_11).
      */
-    private Vector<Texture> mTextures;
+    private int mQcarFlags = QCAR.GL_11;
     /**
      * Instanz des asynchronen Tasks zur Initialisierung des QCAR-Frameworks.
      */
@@ -139,9 +142,9 @@ public class Invisiboga extends Activity {
          */
         @Override
         protected Boolean doInBackground(Void... params) {
-            // Das QCAR-Framework soll mit der Invisiboga-Activity und OpenGL
-            // 1.1 initialisiert werden.
-            QCAR.setInitParameters(Invisiboga.this, QCAR.GL_11);
+            // Das QCAR-Framework soll mit der Invisiboga-Activity und der
+            // gewählten OpenGL-ES-Version initialisiert werden.
+            QCAR.setInitParameters(Invisiboga.this, mQcarFlags);
             do {
                 mProgressValue = QCAR.init();
             } while (!isCancelled() && mProgressValue >= 0 && mProgressValue < 100);
@@ -237,23 +240,6 @@ public class Invisiboga extends Activity {
         updateAppStatus(APP_STATUS_INIT_APP);
     }
 
-    /**
-     * Lädt benötigte Texturen aus dem Android Package.<br>
-     * Die Reihenfolge ist wichtig, weil die Texturen im nativen Code anhand des
-     * Indexes den Felder-Arten zugeordnet werden.
-     */
-    private void loadTextures() {
-        Log.i("Loading textures");
-        // Textur für das Start-Feld
-        mTextures.add(Texture.loadTextureFromApk("startSpace.png", getAssets()));
-        // Textur für ein normales Feld
-        mTextures.add(Texture.loadTextureFromApk("space.png", getAssets()));
-        // Textur für ein Spezial-Feld
-        mTextures.add(Texture.loadTextureFromApk("specialSpace.png", getAssets()));
-        // Textur für das Ziel-Feld
-        mTextures.add(Texture.loadTextureFromApk("targetSpace.png", getAssets()));
-    }
-
     /**
      * Aktualisiert den App-Status.
      * 
@@ -313,6 +299,23 @@ public class Invisiboga extends Activity {
         }
     }
 
+    /**
+     * Wählt die OpenGL-ES-Version, mit der QCAR und die GLSurfaceView
+     * initialisiert werden. Unterstützt das Gerät OpenGL ES 2.0, wird mit
+     * Shadern gerendert, sonst mit der festen Funktions-Pipeline von OpenGL
+     * ES 1.1.
+     * 
+     * @return QCAR.GL_20 oder QCAR.GL_11.
+     */
+    private int selectOpenGlEsVersion() {
+        ActivityManager activityManager = (ActivityManager) getSystemService(
+            Context.ACTIVITY_SERVICE);
+        ConfigurationInfo configurationInfo = activityManager.getDeviceConfigurationInfo();
+        boolean openGlEs2Supported = configurationInfo.reqGlEsVersion >= 0x20000;
+        Log.i("Using OpenGL ES " + (openGlEs2Supported ? "2.0" : "1.1"));
+        return openGlEs2Supported ? QCAR.GL_20 : QCAR.GL_11;
+    }
+
     /**
      * Initialisiert Komponenten, die nichts mit QCAR oder Augmented Reality zu
      * tun haben.
@@ -321,9 +324,10 @@ public class Invisiboga extends Activity {
         // Lade-Fortschritt-Dialog erzeugen und anzeigen
         loadProgressDialog = ProgressDialog
             .show(Invisiboga.this, "", "Lade, bitte warten...", true);
-        // Texturen laden
-        mTextures = new Vector<Texture>();
-        loadTextures();
+        // Texturen im Hintergrund laden, während QCAR initialisiert wird
+        startLoadingNative(getAssets(), getFilesDir().getAbsolutePath());
+        // OpenGL-ES-Version wählen
+        mQcarFlags = selectOpenGlEsVersion();
         // Querformat setzen
         setRequestedOrientation(ActivityInfo.SCREEN_ORIENTATION_LANDSCAPE);
         // Flags setzen, damit der Bildschirm immer an und hell bleibt
@@ -358,7 +362,7 @@ public class Invisiboga extends Activity {
         mOverlayView = new OverlayView(this);
         mGlSurfaceView = new InvisibogaGlSurfaceView(this, mOverlayView);
         // Initialisierung der GLSurfaceView anstoßen
-        mGlSurfaceView.init(QCAR.GL_11, QCAR.requiresAlpha(), 16, 0);
+        mGlSurfaceView.init(mQcarFlags, QCAR.requiresAlpha(), 16, 0);
     }
 
     /**
@@ -400,6 +404,14 @@ public class Invisiboga extends Activity {
                 actionType = 3;
                 break;
         }
+        // Zwischenpositionen seit dem letzten Ereignis weitergeben, damit der Zieh-Pfad lückenlos
+        // ist
+        if (actionType == 1) {
+            for (int i = 0; i < event.getHistorySize(); i++) {
+                nativeTouchEvent(actionType, event.getHistoricalX(0, i),
+                        event.getHistoricalY(0, i));
+            }
+        }
         // Koordinaten der Berührung auslesen
         float x = event.getX(0);
         float y = event.getY(0);
@@ -408,35 +420,6 @@ public class Invisiboga extends Activity {
         return true;
     }
 
-    /**
-     * Gibt die Anzahl der Texturen zurück.<br>
-     * Wird vom nativen Code aufgerufen.
-     * 
-     * @return Anzahl der Texturen.
-     */
-    public int getTextureCount() {
-        return mTextures.size();
-    }
-
-    /**
-     * Gibt die Textur an einer bestimmten Stelle zurück.<br>
-     * Wird vom native Code aufgerufen.
-     * 
-     * @param i
-     *            Index der Textur.
-     * 
-     * @return Textur an der übergebenen Stelle.
-     */
-    public Texture getTexture(int i) {
-        Texture texture = null;
-        try {
-            texture = mTextures.elementAt(i);
-        } catch (IndexOutOfBoundsException e) {
-            Log.w(e.toString());
-        }
-        return texture;
-    }
-
     /**
      * Wird aufgerufen, wenn die App aus irgend einem Grund pausiert wird.
      */
@@ -499,15 +482,20 @@ public class Invisiboga extends Activity {
         }
         // native Deinitialisierung
         deinitNative();
-        // Texturen löschen
-        mTextures.clear();
-        mTextures = null;
         // QCAR deinitalisieren
         QCAR.deinit();
         // Aufforderung an den Garbage Collector zum Aufräumen
         System.gc();
     }
 
+    /**
+     * Native Methode, die das Laden der Texturen im Hintergrund startet. Der
+     * Asset-Manager wird übergeben, damit der native Code Dateien direkt aus
+     * dem Android Package lesen kann. Im Verzeichnis für die Dateien der App
+     * wird das Spielfeld gespeichert.
+     */
+    private native void startLoadingNative(AssetManager assetManager, String filesDirectory);
+
     /**
      * Native Methode zur App-Initialisierung.
      */
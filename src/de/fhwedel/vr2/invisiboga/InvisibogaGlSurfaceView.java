@@ -64,9 +64,10 @@ public class InvisibogaGlSurfaceView extends GLSurfaceView implements Renderer {
         if (translucent) {
             getHolder().setFormat(PixelFormat.TRANSLUCENT);
         }
-        setEGLContextFactory(new ContextFactory());
-        setEGLConfigChooser(translucent ? new ConfigChooser(8, 8, 8, 8, depth, stencil)
-            : new ConfigChooser(5, 6, 5, 0, depth, stencil));
+        boolean openGlEs2 = (flags & QCAR.GL_20) != 0;
+        setEGLContextFactory(new ContextFactory(openGlEs2));
+        setEGLConfigChooser(translucent ? new ConfigChooser(8, 8, 8, 8, depth, stencil, openGlEs2)
+            : new ConfigChooser(5, 6, 5, 0, depth, stencil, openGlEs2));
         setRenderer(this);
         // native Initialisierung
         nativeInit();
@@ -77,14 +78,19 @@ public class InvisibogaGlSurfaceView extends GLSurfaceView implements Renderer {
      */
     private static class ContextFactory implements EGLContextFactory {
         private static int EGL_CONTEXT_CLIENT_VERSION = 0x3098;
+        private boolean mOpenGlEs2;
+
+        public ContextFactory(boolean openGlEs2) {
+            mOpenGlEs2 = openGlEs2;
+        }
 
         public EGLContext createContext(EGL10 egl, EGLDisplay display, EGLConfig eglConfig) {
             EGLContext context;
-            Log.i("Creating OpenGL ES 1.x context");
+            Log.i("Creating OpenGL ES " + (mOpenGlEs2 ? "2.0" : "1.x") + " context");
             checkEglError("Before eglCreateContext", egl);
-            int[] attrib_list_gl1x = { EGL_CONTEXT_CLIENT_VERSION, 1, EGL10.EGL_NONE };
-            context = egl.eglCreateContext(display, eglConfig, EGL10.EGL_NO_CONTEXT,
-                attrib_list_gl1x);
+            int[] attrib_list = { EGL_CONTEXT_CLIENT_VERSION, mOpenGlEs2 ? 2 : 1,
+                EGL10.EGL_NONE };
+            context = egl.eglCreateContext(display, eglConfig, EGL10.EGL_NO_CONTEXT, attrib_list);
             checkEglError("After eglCreateContext", egl);
             return context;
         }
@@ -116,15 +122,18 @@ public class InvisibogaGlSurfaceView extends GLSurfaceView implements Renderer {
         protected int mAlphaSize;
         protected int mDepthSize;
         protected int mStencilSize;
+        protected boolean mOpenGlEs2;
         private int[] mValue = new int[1];
 
-        public ConfigChooser(int r, int g, int b, int a, int depth, int stencil) {
+        public ConfigChooser(int r, int g, int b, int a, int depth, int stencil,
+            boolean openGlEs2) {
             mRedSize = r;
             mGreenSize = g;
             mBlueSize = b;
             mAlphaSize = a;
             mDepthSize = depth;
             mStencilSize = stencil;
+            mOpenGlEs2 = openGlEs2;
         }
 
         private EGLConfig getMatchingConfig(EGL10 egl, EGLDisplay display, int[] configAttribs) {
@@ -141,10 +150,11 @@ public class InvisibogaGlSurfaceView extends GLSurfaceView implements Renderer {
 
         public EGLConfig chooseConfig(EGL10 egl, EGLDisplay display) {
             final int EGL_OPENGL_ES1X_BIT = 0x0001;
-            final int[] s_configAttribs_gl1x = { EGL10.EGL_RED_SIZE, 5, EGL10.EGL_GREEN_SIZE, 6,
-                EGL10.EGL_BLUE_SIZE, 5, EGL10.EGL_RENDERABLE_TYPE, EGL_OPENGL_ES1X_BIT,
-                EGL10.EGL_NONE };
-            return getMatchingConfig(egl, display, s_configAttribs_gl1x);
+            final int EGL_OPENGL_ES2_BIT = 0x0004;
+            final int[] s_configAttribs = { EGL10.EGL_RED_SIZE, 5, EGL10.EGL_GREEN_SIZE, 6,
+                EGL10.EGL_BLUE_SIZE, 5, EGL10.EGL_RENDERABLE_TYPE,
+                mOpenGlEs2 ? EGL_OPENGL_ES2_BIT : EGL_OPENGL_ES1X_BIT, EGL10.EGL_NONE };
+            return getMatchingConfig(egl, display, s_configAttribs);
         }
 
         public EGLConfig chooseConfig(EGL10 egl, EGLDisplay display, EGLConfig[] configs) {
@@ -0,0 +1,435 @@
+/**
+ * @file boardBenchmark.cpp
+ *
+ * @brief Werkzeug, das die Spielfeld-Dateien (jni/board.cpp) auf dem Entwicklungsrechner prüft und
+ *      das Laden misst.
+ *
+ * @details Zuerst werden Spielfelder verschiedener Größe (auch leere und solche, deren Typen
+ *      aufgefüllt werden müssen) geschrieben, wieder abgebildet und bitweise verglichen. Danach
+ *      werden einzelne Bytes der Datei verändert, die Datei gekürzt und verlängert sowie Kennung
+ *      und Version überschrieben. Keine dieser Dateien darf geladen werden.
+ *
+ *      Zum Schluss wird ein Spielfeld mit 10000 Feldern wiederholt geladen, genau wie in
+ *      loadField() in jni/field.cpp: Datei abbilden und prüfen, Abschnitte blockweise kopieren,
+ *      Felder und Gitter aufbauen. Ausgegeben wird die Dauer des ersten und die mittlere Dauer der
+ *      weiteren Ladevorgänge, jeweils aufgeteilt in Abbilden und Aufbauen. Die Datei liegt dabei
+ *      im Cache des Betriebssystems.
+ *
+ *      Weicht ein gelesenes Spielfeld ab oder wird eine fehlerhafte Datei geladen, bricht das
+ *      Werkzeug ab.
+ *
+ *      Das Werkzeug wird über "ant board-benchmark" gebaut und ausgeführt.
+ *
+ * @author Alexander Bertram
+ *
+ * @date 16.10.2026
+ */
+
+#include <math.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+#include <unistd.h>
+
+#include <vector>
+
+#include "../jni/board.h"
+#include "../jni/spaceGrid.h"
+
+/**
+ * Feld-Radius (wie in jni/constants.h).
+ */
+#define SPACE_RADIUS 10.0f
+
+/**
+ * Anzahl der Felder in einem Block (wie in jni/types.h).
+ */
+#define SPACE_CHUNK_SIZE 128
+
+/**
+ * Maximale Anzahl der Felder (wie in jni/types.h).
+ */
+#define MAX_SPACE_COUNT 16384
+
+/**
+ * Anzahl der Feld-Typen (wie SPACE_TYPE_COUNT in jni/types.h).
+ */
+#define SPACE_TYPE_COUNT 4
+
+/**
+ * Name der Datei, die während der Prüfung geschrieben wird.
+ */
+#define BOARD_FILE "bin/boardBenchmark.ibgb"
+
+/**
+ * Anzahl der Felder des gemessenen Spielfeldes.
+ */
+#define BENCHMARK_SPACE_COUNT 10000
+
+/**
+ * Anzahl der gemessenen Ladevorgänge.
+ */
+#define LOAD_COUNT 200
+
+/**
+ * @brief Feld wie Space in jni/types.h.
+ */
+typedef struct BenchmarkSpace {
+    int id;
+    int type;
+    float position[2];
+    float angle;
+    float rotationScale[4];
+    bool occupied;
+} BenchmarkSpace;
+
+/**
+ * @brief Block von Feldern wie SpaceChunk in jni/types.h.
+ */
+typedef struct BenchmarkChunk {
+    float x[SPACE_CHUNK_SIZE];
+    float y[SPACE_CHUNK_SIZE];
+    uint8_t types[SPACE_CHUNK_SIZE];
+    uint32_t occupied[SPACE_CHUNK_SIZE / 32];
+    BenchmarkSpace spaces[SPACE_CHUNK_SIZE];
+} BenchmarkChunk;
+
+/**
+ * @brief Spielfeld, das in eine Datei geschrieben wird.
+ */
+typedef struct Board {
+    std::vector<float> x;
+    std::vector<float> y;
+    std::vector<float> angles;
+    std::vector<uint8_t> types;
+} Board;
+
+/**
+ * Gibt die aktuelle Zeit in Sekunden zurück.
+ *
+ * @return Zeit in Sekunden.
+ */
+static double currentTime() {
+    struct timespec time;
+    clock_gettime(CLOCK_MONOTONIC, &time);
+    return time.tv_sec + time.tv_nsec / 1e9;
+}
+
+/**
+ * Gibt eine gleichverteilte Zufallszahl zurück.
+ *
+ * @param minimum Untere Grenze.
+ * @param maximum Obere Grenze.
+ * @return Zufallszahl zwischen minimum und maximum.
+ */
+static float randomFloat(float minimum, float maximum) {
+    return minimum + (maximum - minimum) * (rand() / (float)RAND_MAX);
+}
+
+/**
+ * Erzeugt ein zufälliges Spielfeld.
+ *
+ * @param spaceCount Anzahl der Felder.
+ * @param board Das Spielfeld.
+ */
+static void createBoard(int spaceCount, Board &board) {
+    board.x.resize(spaceCount);
+    board.y.resize(spaceCount);
+    board.angles.resize(spaceCount);
+    board.types.resize(spaceCount);
+    for (int i = 0; i < spaceCount; ++i) {
+        board.x[i] = randomFloat(-2000.f, 2000.f);
+        board.y[i] = randomFloat(-2000.f, 2000.f);
+        board.angles[i] = randomFloat(-180.f, 180.f);
+        board.types[i] = rand() % SPACE_TYPE_COUNT;
+    }
+}
+
+/**
+ * Schreibt ein Spielfeld nach BOARD_FILE.
+ *
+ * @param board Das Spielfeld.
+ * @return false, wenn die Datei nicht geschrieben werden konnte.
+ */
+static bool writeBoard(const Board &board) {
+    // data() gibt es in C++98 noch nicht, leere Vektoren haben kein erstes Element
+    static const float noFloat = 0.f;
+    static const uint8_t noType = 0;
+    bool empty = board.x.empty();
+    if (!writeBoardFile(BOARD_FILE, "Stones", board.x.size(), empty ? &noFloat : &board.x[0],
+            empty ? &noFloat : &board.y[0], empty ? &noFloat : &board.angles[0],
+            empty ? &noType : &board.types[0])) {
+        fprintf(stderr, "Could not write %s\n", BOARD_FILE);
+        return false;
+    }
+    return true;
+}
+
+/**
+ * Vergleicht ein abgebildetes Spielfeld bitweise mit dem geschriebenen.
+ *
+ * @param mapped Abgebildete Datei.
+ * @param board Geschriebenes Spielfeld.
+ * @return true, wenn beide übereinstimmen.
+ */
+static bool equalsBoard(const MappedBoardFile &mapped, const Board &board) {
+    size_t count = board.x.size();
+    return mapped.spaceCount == (int)count && strcmp(mapped.markerName, "Stones") == 0
+            && (count == 0 || (memcmp(mapped.x, &board.x[0], count * sizeof(float)) == 0
+                    && memcmp(mapped.y, &board.y[0], count * sizeof(float)) == 0
+                    && memcmp(mapped.angles, &board.angles[0], count * sizeof(float)) == 0
+                    && memcmp(mapped.types, &board.types[0], count) == 0));
+}
+
+/**
+ * Liest BOARD_FILE vollständig.
+ *
+ * @param data Inhalt der Datei.
+ */
+static void readFile(std::vector<uint8_t> &data) {
+    data.clear();
+    FILE *file = fopen(BOARD_FILE, "rb");
+    int c;
+    while (file != NULL && (c = fgetc(file)) != EOF) {
+        data.push_back(c);
+    }
+    if (file != NULL) {
+        fclose(file);
+    }
+}
+
+/**
+ * Ersetzt BOARD_FILE.
+ *
+ * @param data Neuer Inhalt der Datei.
+ */
+static void replaceFile(const std::vector<uint8_t> &data) {
+    FILE *file = fopen(BOARD_FILE, "wb");
+    if (file != NULL) {
+        if (!data.empty()) {
+            fwrite(&data[0], 1, data.size(), file);
+        }
+        fclose(file);
+    }
+}
+
+/**
+ * Prüft, dass BOARD_FILE nicht geladen wird.
+ *
+ * @param description Beschreibung der Veränderung für die Ausgabe.
+ * @return true, wenn die Datei abgelehnt wurde.
+ */
+static bool expectRejected(const char *description) {
+    MappedBoardFile mapped;
+    BoardFileStatus status = mapBoardFile(BOARD_FILE, MAX_SPACE_COUNT, &mapped);
+    if (status == BOARD_FILE_MAPPED) {
+        unmapBoardFile(&mapped);
+        fprintf(stderr, "File with %s was loaded\n", description);
+        return false;
+    }
+    return true;
+}
+
+/**
+ * Schreibt und liest Spielfelder verschiedener Größe und prüft, dass veränderte Dateien abgelehnt
+ * werden.
+ *
+ * @return true, wenn alle Prüfungen bestanden wurden.
+ */
+static bool checkRoundTrip() {
+    static const int spaceCounts[] = { 0, 1, 3, 127, 128, 129, BENCHMARK_SPACE_COUNT,
+            MAX_SPACE_COUNT };
+    Board board;
+    for (size_t i = 0; i < sizeof(spaceCounts) / sizeof(spaceCounts[0]); ++i) {
+        createBoard(spaceCounts[i], board);
+        MappedBoardFile mapped;
+        if (!writeBoard(board)
+                || mapBoardFile(BOARD_FILE, MAX_SPACE_COUNT, &mapped) != BOARD_FILE_MAPPED) {
+            fprintf(stderr, "Could not load %d spaces\n", spaceCounts[i]);
+            return false;
+        }
+        bool equal = equalsBoard(mapped, board);
+        unmapBoardFile(&mapped);
+        if (!equal) {
+            fprintf(stderr, "Loaded board with %d spaces differs\n", spaceCounts[i]);
+            return false;
+        }
+    }
+    // ein ungerades Spielfeld, damit auch die Auffüllung geprüft wird
+    createBoard(1001, board);
+    std::vector<uint8_t> original;
+    if (!writeBoard(board)) {
+        return false;
+    }
+    readFile(original);
+    // jedes geprüfte Byte einzeln verändern, einschließlich Header und Auffüllung
+    int changedCount = 0;
+    for (size_t offset = 0; offset < original.size(); offset += offset < 64 ? 1 : 509) {
+        std::vector<uint8_t> changed = original;
+        changed[offset] ^= 0x10;
+        replaceFile(changed);
+        if (!expectRejected("changed byte")) {
+            fprintf(stderr, "Offset %u\n", (unsigned int)offset);
+            return false;
+        }
+        changedCount++;
+    }
+    std::vector<uint8_t> changed = original;
+    changed[original.size() - 1] ^= 0x01;
+    replaceFile(changed);
+    if (!expectRejected("changed padding")) {
+        return false;
+    }
+    changed.assign(original.begin(), original.end() - 4);
+    replaceFile(changed);
+    if (!expectRejected("truncated sections")) {
+        return false;
+    }
+    changed.assign(original.begin(), original.begin() + sizeof(BoardFileHeader) - 1);
+    replaceFile(changed);
+    if (!expectRejected("truncated header")) {
+        return false;
+    }
+    changed = original;
+    changed.insert(changed.end(), 4, 0);
+    replaceFile(changed);
+    if (!expectRejected("appended bytes")) {
+        return false;
+    }
+    // eine korrekte Prüfsumme nützt bei falscher Version oder zu vielen Feldern nichts
+    createBoard(MAX_SPACE_COUNT, board);
+    MappedBoardFile mapped;
+    if (!writeBoard(board)
+            || mapBoardFile(BOARD_FILE, MAX_SPACE_COUNT - 1, &mapped) != BOARD_FILE_INVALID) {
+        fprintf(stderr, "File with too many spaces was not rejected\n");
+        return false;
+    }
+    changed = original;
+    ((BoardFileHeader*)&changed[0])->version = BOARD_FILE_VERSION + 1;
+    replaceFile(changed);
+    if (!expectRejected("other version")) {
+        return false;
+    }
+    unlink(BOARD_FILE);
+    if (mapBoardFile(BOARD_FILE, MAX_SPACE_COUNT, &mapped) != BOARD_FILE_MISSING) {
+        fprintf(stderr, "Missing file was not reported\n");
+        return false;
+    }
+    printf("round trip: %u sizes equal, %d changed files rejected\n",
+            (unsigned int)(sizeof(spaceCounts) / sizeof(spaceCounts[0])), changedCount + 6);
+    return true;
+}
+
+/**
+ * Baut Felder und Gitter aus einer abgebildeten Datei auf wie loadField() in jni/field.cpp.
+ *
+ * @param mapped Abgebildete Datei.
+ * @param chunks Blöcke, fehlende werden angefordert.
+ * @param grid Gitter.
+ * @return false, wenn kein Speicher angefordert werden konnte.
+ */
+static bool restoreBoard(const MappedBoardFile &mapped, std::vector<BenchmarkChunk*> &chunks,
+        SpaceGrid *grid) {
+    clearSpaceGrid(grid, 2 * SPACE_RADIUS);
+    for (int start = 0; start < mapped.spaceCount; start += SPACE_CHUNK_SIZE) {
+        int count = mapped.spaceCount - start < SPACE_CHUNK_SIZE ? mapped.spaceCount - start
+                : SPACE_CHUNK_SIZE;
+        if (start / SPACE_CHUNK_SIZE == (int)chunks.size()) {
+            chunks.push_back((BenchmarkChunk*)malloc(sizeof(BenchmarkChunk)));
+        }
+        BenchmarkChunk *chunk = chunks[start / SPACE_CHUNK_SIZE];
+        memcpy(chunk->x, mapped.x + start, count * sizeof(float));
+        memcpy(chunk->y, mapped.y + start, count * sizeof(float));
+        memcpy(chunk->types, mapped.types + start, count);
+        memset(chunk->occupied, 0, sizeof(chunk->occupied));
+        for (int i = 0; i < count; ++i) {
+            BenchmarkSpace *space = &chunk->spaces[i];
+            if (chunk->types[i] >= SPACE_TYPE_COUNT
+                    || !insertIntoSpaceGrid(grid, chunk->x[i], chunk->y[i])) {
+                return false;
+            }
+            float angle = mapped.angles[start + i];
+            float radians = angle * (float)M_PI / 180.f;
+            float cosine = SPACE_RADIUS * cosf(radians);
+            float sine = SPACE_RADIUS * sinf(radians);
+            space->id = start + i;
+            space->type = chunk->types[i];
+            space->position[0] = chunk->x[i];
+            space->position[1] = chunk->y[i];
+            space->angle = angle;
+            space->rotationScale[0] = cosine;
+            space->rotationScale[1] = sine;
+            space->rotationScale[2] = -sine;
+            space->rotationScale[3] = cosine;
+            space->occupied = false;
+        }
+    }
+    return true;
+}
+
+/**
+ * Misst das Laden eines großen Spielfeldes.
+ *
+ * @return true, wenn alle Ladevorgänge erfolgreich waren.
+ */
+static bool benchmarkLoad() {
+    Board board;
+    createBoard(BENCHMARK_SPACE_COUNT, board);
+    if (!writeBoard(board)) {
+        return false;
+    }
+    static SpaceGrid grid;
+    std::vector<BenchmarkChunk*> chunks;
+    double firstMapTime = 0.;
+    double firstRestoreTime = 0.;
+    double mapTime = 0.;
+    double restoreTime = 0.;
+    bool loaded = true;
+    for (int i = 0; loaded && i <= LOAD_COUNT; ++i) {
+        // wie beim Start sind die Blöcke jedes Mal neu anzufordern
+        for (size_t j = 0; j < chunks.size(); ++j) {
+            free(chunks[j]);
+        }
+        chunks.clear();
+        double start = currentTime();
+        MappedBoardFile mapped;
+        if (mapBoardFile(BOARD_FILE, MAX_SPACE_COUNT, &mapped) != BOARD_FILE_MAPPED) {
+            loaded = false;
+            break;
+        }
+        double mapEnd = currentTime();
+        loaded = restoreBoard(mapped, chunks, &grid) && (i > 0 || equalsBoard(mapped, board));
+        unmapBoardFile(&mapped);
+        double end = currentTime();
+        if (i == 0) {
+            firstMapTime = mapEnd - start;
+            firstRestoreTime = end - mapEnd;
+        } else {
+            mapTime += mapEnd - start;
+            restoreTime += end - mapEnd;
+        }
+    }
+    for (size_t j = 0; j < chunks.size(); ++j) {
+        free(chunks[j]);
+    }
+    clearSpaceGrid(&grid, 2 * SPACE_RADIUS);
+    unlink(BOARD_FILE);
+    if (!loaded) {
+        fprintf(stderr, "Could not load the benchmark board\n");
+        return false;
+    }
+    printf("%8s %10s %14s %16s %12s\n", "spaces", "load", "map [ms]", "restore [ms]",
+            "total [ms]");
+    printf("%8d %10s %14.3f %16.3f %12.3f\n", BENCHMARK_SPACE_COUNT, "first", firstMapTime * 1e3,
+            firstRestoreTime * 1e3, (firstMapTime + firstRestoreTime) * 1e3);
+    printf("%8d %10s %14.3f %16.3f %12.3f\n", BENCHMARK_SPACE_COUNT, "average",
+            mapTime / LOAD_COUNT * 1e3, restoreTime / LOAD_COUNT * 1e3,
+            (mapTime + restoreTime) / LOAD_COUNT * 1e3);
+    return true;
+}
+
+int main() {
+    srand(1);
+    return checkRoundTrip() && benchmarkLoad() ? 0 : 1;
+}
@@ -0,0 +1,277 @@
+/**
+ * @file drawCallBenchmark.cpp
+ *
+ * @brief Werkzeug, das die GL-Aufrufe des Renderers (jni/renderer.cpp) pro Frame auf dem
+ *      Entwicklungsrechner zählt.
+ *
+ * @details Der Renderer wird gegen die zählenden GL-Funktionen aus tools/glShim/glShim.cpp
+ *      gebunden. Für Spielfelder mit 10, 100, 1000 und 10000 Feldern wird ein Frame bei laufendem
+ *      Spiel gerendert, einmal mit dem früheren Renderer, der jedes Feld und jede Spielfigur mit
+ *      eigener Matrix und eigenem Zeichenaufruf gerendert hat (nachgebildet in
+ *      renderFrameBefore()), und je einmal mit dem aktuellen Renderer mit OpenGL ES 1.1 und
+ *      OpenGL ES 2.0. Die Kamera sieht dabei das ganze Spielfeld, es wird also kein Feld
+ *      aussortiert. Ausgegeben werden die Zeichenaufrufe und alle GL-Aufrufe pro Frame.
+ *
+ *      Gezählt wird jeweils der zweite Frame, der erste baut das Spielfeld auf und lädt es in den
+ *      Grafikspeicher. Weichen die gezählten Zeichenaufrufe von der Render-Statistik des Renderers
+ *      oder der frühere Renderer von field.length + 2 ab, oder lädt der zweite Frame Daten in den
+ *      Grafikspeicher, bricht das Werkzeug ab.
+ *
+ *      Das Werkzeug wird über "ant draw-call-benchmark" gebaut und ausgeführt.
+ *
+ * @author Alexander Bertram
+ *
+ * @date 17.10.2026
+ */
+
+#include <math.h>
+#include <stdio.h>
+#include <string.h>
+
+#include <GLES/gl.h>
+
+#include "glShim.h"
+
+#include "../jni/constants.h"
+#include "../jni/field.h"
+#include "../jni/mathUtils.h"
+#include "../jni/renderer.h"
+#include "../jni/Texture.h"
+#include "../jni/types.h"
+
+/**
+ * Anzahl der Spielfeld-Größen.
+ */
+#define FIELD_SIZE_COUNT 4
+
+/**
+ * Gemessene Spielfeld-Größen.
+ */
+static const int FIELD_SIZES[FIELD_SIZE_COUNT] = { 10, 100, 1000, 10000 };
+
+/*
+ * Zustand, den sonst invisiboga.cpp verwaltet und renderer.cpp liest.
+ */
+int gameState = GAME_STATE_RUNNING;
+QCAR::Matrix44F modelViewMatrix;
+QCAR::Matrix44F projectionMatrix;
+Player players[PLAYER_COUNT];
+Mesh pawnMesh;
+Texture *textures[TEXTURE_COUNT];
+TextureAtlasRegion spaceTextureRegions[SPACE_TYPE_COUNT];
+TouchEvent touchEvent;
+
+/*
+ * Render-Statistik (verwaltet in renderer.cpp).
+ */
+extern RenderStatistics renderStatistics;
+
+/**
+ * Header des Models der Spielfigur: ein Dreieck, eine Detailstufe.
+ */
+static const MeshFileHeader PAWN_MESH_HEADER = { { 'I', 'B', 'G', 'M' }, 1, 3, 3, 1,
+    { 0.f, 0.f, 0.5f }, 1.f / 32767.f };
+/**
+ * Detailstufe des Models der Spielfigur.
+ */
+static const MeshLevelOfDetail PAWN_MESH_LEVEL_OF_DETAIL = { 0, 3 };
+/**
+ * Vertices des Models der Spielfigur.
+ */
+static const MeshVertex PAWN_MESH_VERTICES[3] = { { { 0, 0, 0 }, 0, { 0, 0, 127 }, 0 },
+    { { 16384, 0, 0 }, 0, { 0, 0, 127 }, 0 }, { { 0, 16384, 0 }, 0, { 0, 0, 127 }, 0 } };
+/**
+ * Indizes des Models der Spielfigur.
+ */
+static const GLushort PAWN_MESH_INDICES[3] = { 0, 1, 2 };
+
+/**
+ * Textur-Atlas der Felder, wird nie hochgeladen.
+ */
+static Texture spaceTextureAtlas;
+
+/*
+ * Texture.cpp hängt vom Asset-Manager und den KTX-Dateien ab, deshalb werden hier nur Konstruktor
+ * und Destruktor nachgebildet.
+ */
+Texture::Texture() :
+        mWidth(0), mHeight(0), mChannelCount(0), mData(0), mTextureID(1), mAlphaTextureID(2),
+        mColorImage(0), mAlphaImage(0) {
+}
+
+Texture::~Texture() {
+}
+
+/**
+ * Erstellt ein quadratisches Spielfeld, dessen Felder im Abstand 2 * SPACE_RADIUS liegen, stellt
+ * die Spielfiguren auf die ersten beiden Felder und richtet die Kamera von oben auf das ganze
+ * Spielfeld.
+ *
+ * @param spaceCount Anzahl der Felder.
+ * @return false, wenn nicht alle Felder erstellt werden konnten.
+ */
+static bool createField(int spaceCount) {
+    clearField();
+    int side = (int)ceilf(sqrtf((float)spaceCount));
+    for (int i = 0; i < spaceCount; ++i) {
+        createSpace(QCAR::Vec2F(i % side * 2 * SPACE_RADIUS, i / side * 2 * SPACE_RADIUS));
+    }
+    if (field.length != spaceCount) {
+        fprintf(stderr, "only %d of %d spaces created\n", field.length, spaceCount);
+        return false;
+    }
+    for (int i = 0; i < PLAYER_COUNT; ++i) {
+        players[i].pawn.position = getSpace(i)->position;
+        players[i].pawn.levelOfDetail = 0;
+    }
+    // orthografische Projektion mit Rand um das Spielfeld
+    float center = (side - 1) * SPACE_RADIUS;
+    float extent = center + 4 * SPACE_RADIUS;
+    modelViewMatrix = matrix44FIdentity();
+    translatePoseMatrix(-center, -center, 0.f, modelViewMatrix.data);
+    projectionMatrix = matrix44FIdentity();
+    projectionMatrix.data[0] = 1.f / extent;
+    projectionMatrix.data[5] = 1.f / extent;
+    projectionMatrix.data[10] = -1.f / extent;
+    return true;
+}
+
+/**
+ * Rendert einen Frame wie der frühere Renderer: jedes Feld mit eigener Textur, Matrix und eigenem
+ * Zeichenaufruf, dazu jede Spielfigur mit eigenem Zeichenaufruf.
+ */
+static void renderFrameBefore() {
+    glEnableClientState(GL_VERTEX_ARRAY);
+    glEnableClientState(GL_NORMAL_ARRAY);
+    glMatrixMode(GL_PROJECTION);
+    glLoadMatrixf(projectionMatrix.data);
+    const GLfloat light0Position[] = { 0.0, 0.0, 0.0, 1.0 };
+    glLightfv(GL_LIGHT0, GL_POSITION, &light0Position[0]);
+    glMatrixMode(GL_MODELVIEW);
+    glLoadMatrixf(modelViewMatrix.data);
+    // Spielfeld
+    glEnableClientState(GL_TEXTURE_COORD_ARRAY);
+    glEnable(GL_BLEND);
+    glEnable(GL_TEXTURE_2D);
+    glDisable(GL_DEPTH_TEST);
+    glDisable(GL_LIGHTING);
+    glBlendFunc(GL_SRC_ALPHA, GL_ONE_MINUS_SRC_ALPHA);
+    glVertexPointer(3, GL_FLOAT, 0, UNIT_SQUARE_VERTICES);
+    glNormalPointer(GL_FLOAT, 0, UNIT_SQUARE_VERTICES);
+    glTexCoordPointer(2, GL_FLOAT, 0, UNIT_SQUARE_TEXTURE_COORDINATES);
+    for (int i = 0; i < field.length; ++i) {
+        const Space &space = *getSpace(i);
+        glBindTexture(GL_TEXTURE_2D, space.type + 1);
+        QCAR::Matrix44F transform = matrix44FIdentity();
+        translatePoseMatrix(space.position.data[0], space.position.data[1], 0.f, transform.data);
+        scalePoseMatrix(SPACE_RADIUS, SPACE_RADIUS, SPACE_RADIUS, transform.data);
+        rotatePoseMatrix(space.angle, 0, 0, 1, transform.data);
+        glPushMatrix();
+        glMultMatrixf(transform.data);
+        glDrawArrays(GL_TRIANGLE_STRIP, 0, 4);
+        glPopMatrix();
+    }
+    // Spielfiguren
+    glDisableClientState(GL_TEXTURE_COORD_ARRAY);
+    glEnable(GL_DEPTH_TEST);
+    glEnable(GL_LIGHTING);
+    glEnable(GL_LIGHT0);
+    glEnable(GL_RESCALE_NORMAL);
+    glDisable(GL_BLEND);
+    glDisable(GL_TEXTURE_2D);
+    glVertexPointer(3, GL_FLOAT, 0, UNIT_SQUARE_VERTICES);
+    glNormalPointer(GL_FLOAT, 0, UNIT_SQUARE_VERTICES);
+    for (int i = 0; i < PLAYER_COUNT; ++i) {
+        Pawn *pawn = &players[i].pawn;
+        glLightfv(GL_LIGHT0, GL_AMBIENT, pawn->light.ambient);
+        glLightfv(GL_LIGHT0, GL_DIFFUSE, pawn->light.diffuse);
+        glLightfv(GL_LIGHT0, GL_SPECULAR, pawn->light.specular);
+        QCAR::Matrix44F transform = matrix44FIdentity();
+        translatePoseMatrix(pawn->position.data[0], pawn->position.data[1], 0.f, transform.data);
+        scalePoseMatrix(PAWN_SCALE_FACTOR, PAWN_SCALE_FACTOR, PAWN_SCALE_FACTOR, transform.data);
+        glPushMatrix();
+        glMultMatrixf(transform.data);
+        glDrawArrays(GL_TRIANGLES, 0, 3);
+        glPopMatrix();
+    }
+    glGetError();
+}
+
+/**
+ * Rendert einen Frame mit dem aktuellen Renderer und prüft die Zeichenaufrufe gegen die
+ * Render-Statistik.
+ *
+ * @return false, wenn die gezählten Zeichenaufrufe von der Render-Statistik abweichen.
+ */
+static bool renderFrameAfter() {
+    memset(&renderStatistics, 0, sizeof(renderStatistics));
+    resetGlCallCounts();
+    renderAugmentation();
+    if (glCallCounts.drawCallCount != renderStatistics.drawCallCount) {
+        fprintf(stderr, "%u draw calls issued, render statistics report %u\n",
+                glCallCounts.drawCallCount, renderStatistics.drawCallCount);
+        return false;
+    }
+    return true;
+}
+
+/**
+ * Zählt die GL-Aufrufe pro Frame für alle Spielfeld-Größen.
+ *
+ * @return false, wenn ein Spielfeld nicht erstellt werden konnte oder die Zählungen abweichen.
+ */
+static bool countDrawCalls() {
+    static const char *VERSIONS[2] = { "OpenGL ES-CM 1.1", "OpenGL ES 2.0" };
+    textures[SPACE_TEXTURE_ATLAS] = &spaceTextureAtlas;
+    for (int i = 0; i < SPACE_TYPE_COUNT; ++i) {
+        spaceTextureRegions[i].scale[0] = spaceTextureRegions[i].scale[1] = 1.f;
+    }
+    pawnMesh.header = &PAWN_MESH_HEADER;
+    pawnMesh.levelsOfDetail = &PAWN_MESH_LEVEL_OF_DETAIL;
+    pawnMesh.vertices = PAWN_MESH_VERTICES;
+    pawnMesh.indices = PAWN_MESH_INDICES;
+    pawnMesh.boundingSphere[2] = 0.5f;
+    pawnMesh.boundingSphere[3] = 0.5f;
+    printf("draw calls / GL calls per frame with the whole field visible\n");
+    printf("  spaces     before (draws/calls)   ES 1.1 (draws/calls)   ES 2.0 (draws/calls)\n");
+    for (int i = 0; i < FIELD_SIZE_COUNT; ++i) {
+        if (!createField(FIELD_SIZES[i])) {
+            return false;
+        }
+        resetGlCallCounts();
+        renderFrameBefore();
+        printf("%8d %12u %9u", field.length, glCallCounts.drawCallCount, glCallCounts.callCount);
+        if (glCallCounts.drawCallCount != (unsigned int)(field.length + PLAYER_COUNT)) {
+            fprintf(stderr, "\n%u draw calls before, expected %d\n", glCallCounts.drawCallCount,
+                    field.length + PLAYER_COUNT);
+            return false;
+        }
+        for (int k = 0; k < 2; ++k) {
+            setGlShimVersion(VERSIONS[k]);
+            initRenderer();
+            // der erste Frame baut das Spielfeld auf, gezählt wird der zweite
+            if (!renderFrameAfter() || !renderFrameAfter()) {
+                return false;
+            }
+            if (glCallCounts.bufferUploadCount != 0) {
+                fprintf(stderr, "\n%u buffer uploads in an unchanged frame\n",
+                        glCallCounts.bufferUploadCount);
+                return false;
+            }
+            printf(" %12u %9u", glCallCounts.drawCallCount, glCallCounts.callCount);
+        }
+        printf("\n");
+    }
+    releaseFieldRenderData();
+    releaseField();
+    return true;
+}
+
+/**
+ * Einstiegspunkt des Werkzeugs.
+ *
+ * @return 0 bei Erfolg, sonst 1.
+ */
+int main() {
+    return countDrawCalls() ? 0 : 1;
+}
@@ -0,0 +1,244 @@
+/**
+ * @file etc1Encoder.cpp
+ *
+ * @brief Komprimiert Bilder in das Format ETC1 (siehe jni/etc1.cpp).
+ *
+ * @details Für jeden Block werden beide Teilungen (nebeneinander und übereinander) sowie der
+ *      einzelne und der differentielle Modus ausprobiert. Als Grundfarbe eines Teilblocks werden
+ *      der quantisierte Mittelwert seiner Pixel und einige hellere und dunklere Stufen getestet,
+ *      für jede Tabelle wird pro Pixel der Modifikator mit dem kleinsten quadratischen Fehler
+ *      gewählt. Der Block mit dem kleinsten Gesamtfehler wird
+ *      geschrieben.
+ *
+ * @author Alexander Bertram
+ *
+ * @date 16.10.2026
+ */
+
+#include "etc1Encoder.h"
+#include "../jni/etc1.h"
+
+/**
+ * Anzahl der Quantisierungsstufen, um die die Grundfarbe eines Teilblocks gegenüber dem
+ * gerundeten Mittelwert nach oben und unten verschoben ausprobiert wird.
+ */
+#define BASE_COLOR_SEARCH_RADIUS 2
+
+/**
+ * @brief Kodierung eines Teilblocks.
+ */
+typedef struct SubblockEncoding {
+    /**
+     * Index der Modifikator-Tabelle.
+     */
+    int table;
+    /**
+     * Pixel-Indizes (0 bis 3) der acht Pixel des Teilblocks.
+     */
+    int indices[8];
+    /**
+     * Quadratischer Fehler.
+     */
+    int error;
+} SubblockEncoding;
+
+/**
+ * Begrenzt einen Wert auf einen Bereich.
+ *
+ * @param value Der Wert.
+ * @param minimum Untere Grenze.
+ * @param maximum Obere Grenze.
+ * @return Der begrenzte Wert.
+ */
+static int clamp(int value, int minimum, int maximum) {
+    return value < minimum ? minimum : (value > maximum ? maximum : value);
+}
+
+/**
+ * Wählt für einen Teilblock mit gegebener Grundfarbe die Tabelle und die Pixel-Indizes mit dem
+ * kleinsten Fehler.
+ *
+ * @param pixels Die acht Pixel des Teilblocks (RGB).
+ * @param baseColor Die auf 8 Bit erweiterte Grundfarbe.
+ * @param encoding Erhält die Kodierung.
+ */
+static void encodeSubblock(const int pixels[8][3], const int baseColor[3],
+        SubblockEncoding *encoding) {
+    encoding->error = 0x7fffffff;
+    for (int table = 0; table < 8; ++table) {
+        int indices[8];
+        int error = 0;
+        for (int i = 0; i < 8; ++i) {
+            int bestError = 0x7fffffff;
+            for (int index = 0; index < 4; ++index) {
+                int modifier = ETC1_MODIFIERS[table][index & 1];
+                modifier = index & 2 ? -modifier : modifier;
+                int pixelError = 0;
+                for (int c = 0; c < 3; ++c) {
+                    int d = clamp(baseColor[c] + modifier, 0, 255) - pixels[i][c];
+                    pixelError += d * d;
+                }
+                if (pixelError < bestError) {
+                    bestError = pixelError;
+                    indices[i] = index;
+                }
+            }
+            error += bestError;
+        }
+        if (error < encoding->error) {
+            encoding->error = error;
+            encoding->table = table;
+            for (int i = 0; i < 8; ++i) {
+                encoding->indices[i] = indices[i];
+            }
+        }
+    }
+}
+
+/**
+ * Komprimiert einen Block aus 4x4 Pixeln.
+ *
+ * @param pixels Die Pixel (RGB, zeilenweise).
+ * @param block Erhält den Block (8 Byte).
+ */
+static void encodeBlock(const int pixels[16][3], uint8_t *block) {
+    int bestError = 0x7fffffff;
+    uint32_t bestHigh = 0;
+    uint32_t bestLow = 0;
+    for (int flipped = 0; flipped < 2; ++flipped) {
+        // Pixel der Teilblöcke sammeln und deren Positionen (Index im Block, spaltenweise) merken
+        int subblockPixels[2][8][3];
+        int positions[2][8];
+        int counts[2] = { 0, 0 };
+        for (int x = 0; x < 4; ++x) {
+            for (int y = 0; y < 4; ++y) {
+                int subblock = flipped ? (y >= 2) : (x >= 2);
+                int n = counts[subblock]++;
+                for (int c = 0; c < 3; ++c) {
+                    subblockPixels[subblock][n][c] = pixels[y * 4 + x][c];
+                }
+                positions[subblock][n] = x * 4 + y;
+            }
+        }
+        // Mittelwerte der Teilblöcke
+        int averages[2][3];
+        for (int s = 0; s < 2; ++s) {
+            for (int c = 0; c < 3; ++c) {
+                int sum = 0;
+                for (int i = 0; i < 8; ++i) {
+                    sum += subblockPixels[s][i][c];
+                }
+                averages[s][c] = (sum + 4) / 8;
+            }
+        }
+        for (int differential = 0; differential < 2; ++differential) {
+            // einzeln 4 Bit pro Kanal, differentiell 5 Bit und beim zweiten Teilblock eine
+            // Differenz von -4 bis 3 zur ersten Grundfarbe
+            int maximum = differential ? 31 : 15;
+            int quantized[2][3];
+            SubblockEncoding encodings[2];
+            for (int s = 0; s < 2; ++s) {
+                int rounded[3];
+                for (int c = 0; c < 3; ++c) {
+                    rounded[c] = (averages[s][c] * maximum + 127) / 255;
+                }
+                encodings[s].error = 0x7fffffff;
+                // hellere und dunklere Grundfarben ausprobieren, weil der Mittelwert bei ungleich
+                // verteilten Helligkeiten nicht die beste Grundfarbe ist
+                for (int shift = -BASE_COLOR_SEARCH_RADIUS; shift <= BASE_COLOR_SEARCH_RADIUS;
+                        ++shift) {
+                    int candidate[3];
+                    int expanded[3];
+                    for (int c = 0; c < 3; ++c) {
+                        candidate[c] = clamp(rounded[c] + shift, 0, maximum);
+                        if (differential && s == 1) {
+                            candidate[c] = clamp(candidate[c], quantized[0][c] - 4,
+                                    quantized[0][c] + 3);
+                        }
+                        expanded[c] = differential ? (candidate[c] << 3) | (candidate[c] >> 2)
+                                : (candidate[c] << 4) | candidate[c];
+                    }
+                    SubblockEncoding encoding;
+                    encodeSubblock(subblockPixels[s], expanded, &encoding);
+                    if (encoding.error < encodings[s].error) {
+                        encodings[s] = encoding;
+                        for (int c = 0; c < 3; ++c) {
+                            quantized[s][c] = candidate[c];
+                        }
+                    }
+                }
+            }
+            if (differential) {
+                // der zweite Teilblock speichert nur die Differenz
+                for (int c = 0; c < 3; ++c) {
+                    quantized[1][c] -= quantized[0][c];
+                }
+            }
+            int error = encodings[0].error + encodings[1].error;
+            if (error >= bestError) {
+                continue;
+            }
+            bestError = error;
+            // Grundfarben, Tabellen und Flags
+            uint32_t high = 0;
+            for (int c = 0; c < 3; ++c) {
+                int shift = 27 - 8 * c;
+                if (differential) {
+                    high |= quantized[0][c] << shift;
+                    high |= (quantized[1][c] & 7) << (shift - 3);
+                } else {
+                    high |= quantized[0][c] << (shift + 1);
+                    high |= quantized[1][c] << (shift - 3);
+                }
+            }
+            high |= encodings[0].table << 5;
+            high |= encodings[1].table << 2;
+            high |= differential << 1;
+            high |= flipped;
+            // Pixel-Indizes: höherwertiges Bit in den oberen, niederwertiges in den unteren 16 Bit
+            uint32_t low = 0;
+            for (int s = 0; s < 2; ++s) {
+                for (int i = 0; i < 8; ++i) {
+                    int index = encodings[s].indices[i];
+                    low |= (uint32_t)(index >> 1) << (positions[s][i] + 16);
+                    low |= (uint32_t)(index & 1) << positions[s][i];
+                }
+            }
+            bestHigh = high;
+            bestLow = low;
+        }
+    }
+    for (int i = 0; i < 4; ++i) {
+        block[i] = bestHigh >> (24 - 8 * i);
+        block[i + 4] = bestLow >> (24 - 8 * i);
+    }
+}
+
+/**
+ * Komprimiert ein Bild in das Format ETC1. Es werden nur die Farbkanäle verwendet. Bei
+ * Kantenlängen, die kein Vielfaches von 4 sind, werden die Randpixel wiederholt.
+ *
+ * @param pixels Das Bild (RGBA, zeilenweise).
+ * @param width Breite in Pixeln.
+ * @param height Höhe in Pixeln.
+ * @param data Erhält die Blöcke (etc1ImageSize(width, height) Byte).
+ */
+void encodeEtc1Image(const uint8_t *pixels, uint32_t width, uint32_t height, uint8_t *data) {
+    for (uint32_t blockY = 0; blockY < height; blockY += 4) {
+        for (uint32_t blockX = 0; blockX < width; blockX += 4) {
+            int block[16][3];
+            for (uint32_t y = 0; y < 4; ++y) {
+                for (uint32_t x = 0; x < 4; ++x) {
+                    uint32_t sourceX = blockX + x < width ? blockX + x : width - 1;
+                    uint32_t sourceY = blockY + y < height ? blockY + y : height - 1;
+                    const uint8_t *pixel = pixels + (sourceY * width + sourceX) * 4;
+                    for (int c = 0; c < 3; ++c) {
+                        block[y * 4 + x][c] = pixel[c];
+                    }
+                }
+            }
+            encodeBlock(block, data);
+            data += ETC1_BLOCK_SIZE;
+        }
+    }
+}
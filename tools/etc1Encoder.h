@@ -0,0 +1,18 @@
+/**
+ * @file etc1Encoder.h
+ *
+ * @brief Schnittstelle zu etc1Encoder.cpp.
+ *
+ * @author Alexander Bertram
+ *
+ * @date 16.10.2026
+ */
+
+#ifndef ETC1_ENCODER_H
+#define ETC1_ENCODER_H
+
+#include <stdint.h>
+
+void encodeEtc1Image(const uint8_t *pixels, uint32_t width, uint32_t height, uint8_t *data);
+
+#endif
@@ -0,0 +1,438 @@
+/**
+ * @file fieldBenchmark.cpp
+ *
+ * @brief Werkzeug, das die Abstandsabfragen des Spielfeldes (jni/spaceGrid.cpp und
+ *      jni/spaceKernels.cpp) auf dem Entwicklungsrechner misst und prüft.
+ *
+ * @details Ein Spielfeld wird wie beim Ziehen mit dem Finger schrittweise auf mehrere tausend
+ *      Felder vergrößert. Bei jeder Größe werden zufällige Positionen in der Nähe des Spielfeldes
+ *      geprüft, einmal mit dem Gitter und einmal mit dem früheren linearen Durchlauf über alle
+ *      Felder. Ausgegeben wird die durchschnittliche Dauer einer Prüfung.
+ *
+ *      Danach wird das Tippen auf Felder gemessen: Für Spielfelder mit 100, 1000 und 10000 Feldern
+ *      werden jeweils eine Million zufällige Tipp-Positionen mit dem Gitter, mit der Suche nach
+ *      dem nächsten Feld durch alle Felder und mit dem früheren selectSpace() aufgelöst.
+ *
+ *      Zum Schluss werden die skalaren, SSE2- und (auf ARM mit HAVE_NEON_KERNELS) NEON-Kernel
+ *      über zufälligen Arrays mit vielen gleichen Abständen verglichen und für kleine Spielfelder
+ *      gegen das Gitter gemessen. Daraus ergibt sich MAX_SPACE_SCAN_COUNT in jni/constants.h.
+ *      Auf dem Entwicklungsrechner laufen die NEON-Kernel nicht, sie werden in Debug-Builds beim
+ *      Start der Anwendung mit derselben Prüfung verglichen (siehe initSpaceKernels()).
+ *
+ *      Weichen die Ergebnisse von Gitter, Kerneln und linearer Suche voneinander ab, bricht das
+ *      Werkzeug ab.
+ *
+ *      Das Werkzeug wird über "ant field-benchmark" gebaut und ausgeführt.
+ *
+ * @author Alexander Bertram
+ *
+ * @date 16.10.2026
+ */
+
+#include <math.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <time.h>
+
+#include <vector>
+
+#include "../jni/spaceGrid.h"
+#include "../jni/spaceKernels.h"
+
+/**
+ * Feld-Radius (wie in jni/constants.h).
+ */
+#define SPACE_RADIUS 10.0f
+
+/**
+ * Größte Anzahl der Felder.
+ */
+#define MAX_FIELD_SIZE 8000
+
+/**
+ * Anzahl der Prüfungen pro Spielfeld-Größe.
+ */
+#define CHECK_COUNT 20000
+
+/**
+ * Anzahl der Tipp-Abfragen pro Spielfeld-Größe.
+ */
+#define TAP_COUNT 1000000
+
+/**
+ * Ergebnis der zuletzt gemessenen Suche, volatile, damit der Compiler die Suche nicht wegoptimiert.
+ */
+static volatile int32_t selectedSpace;
+
+/**
+ * Gibt die aktuelle Zeit in Sekunden zurück.
+ *
+ * @return Zeit in Sekunden.
+ */
+static double currentTime() {
+    struct timespec time;
+    clock_gettime(CLOCK_MONOTONIC, &time);
+    return time.tv_sec + time.tv_nsec / 1e9;
+}
+
+/**
+ * Gibt eine gleichverteilte Zufallszahl zurück.
+ *
+ * @param minimum Untere Grenze.
+ * @param maximum Obere Grenze.
+ * @return Zufallszahl zwischen minimum und maximum.
+ */
+static float randomFloat(float minimum, float maximum) {
+    return minimum + (maximum - minimum) * (rand() / (float)RAND_MAX);
+}
+
+/**
+ * Prüft den Abstand wie canCreateSpace() vor der Einführung des Gitters: linear über alle Felder
+ * mit einer Wurzel pro Feld.
+ *
+ * @param points Positionen der Felder.
+ * @param x X-Koordinate der Position.
+ * @param y Y-Koordinate der Position.
+ * @return true, wenn an der Position ein Feld erzeugt werden kann.
+ */
+static bool canCreateSpaceLinear(const std::vector<SpaceGridPoint> &points, float x, float y) {
+    for (size_t i = 0; i < points.size(); ++i) {
+        float deltaX = points[i].x - x;
+        float deltaY = points[i].y - y;
+        if (sqrtf(deltaX * deltaX + deltaY * deltaY) <= 2 * SPACE_RADIUS) {
+            return false;
+        }
+    }
+    return true;
+}
+
+/**
+ * Sucht wie selectSpace() vor der Einführung des Gitters: das erste Feld in der Reihenfolge des
+ * Spielfeldes, das höchstens den Feldradius entfernt ist.
+ *
+ * @param points Positionen der Felder.
+ * @param x X-Koordinate der Tipp-Position.
+ * @param y Y-Koordinate der Tipp-Position.
+ * @return Index des Feldes oder -1.
+ */
+static int32_t selectSpaceLinear(const std::vector<SpaceGridPoint> &points, float x, float y) {
+    for (size_t i = 0; i < points.size(); ++i) {
+        float deltaX = points[i].x - x;
+        float deltaY = points[i].y - y;
+        if (sqrtf(deltaX * deltaX + deltaY * deltaY) <= SPACE_RADIUS) {
+            return (int32_t)i;
+        }
+    }
+    return -1;
+}
+
+/**
+ * Sucht linear das nächste Feld innerhalb des Feldradius, bei gleichem Abstand das mit dem
+ * kleineren Index. Referenz für findNearestInSpaceGrid().
+ *
+ * @param points Positionen der Felder.
+ * @param x X-Koordinate der Tipp-Position.
+ * @param y Y-Koordinate der Tipp-Position.
+ * @return Index des Feldes oder -1.
+ */
+static int32_t findNearestLinear(const std::vector<SpaceGridPoint> &points, float x, float y) {
+    int32_t nearest = -1;
+    float nearestDistanceSquared = SPACE_RADIUS * SPACE_RADIUS;
+    for (size_t i = 0; i < points.size(); ++i) {
+        float deltaX = points[i].x - x;
+        float deltaY = points[i].y - y;
+        float distanceSquared = deltaX * deltaX + deltaY * deltaY;
+        if (distanceSquared < nearestDistanceSquared
+                || (distanceSquared == nearestDistanceSquared && nearest < 0)) {
+            nearest = (int32_t)i;
+            nearestDistanceSquared = distanceSquared;
+        }
+    }
+    return nearest;
+}
+
+/**
+ * Erzeugt zufällige Positionen in der Nähe vorhandener Felder, wie sie beim Ziehen und Tippen
+ * entstehen.
+ *
+ * @param points Positionen der Felder.
+ * @param count Anzahl der Positionen.
+ * @param queries Erhält die Positionen.
+ */
+static void createQueries(const std::vector<SpaceGridPoint> &points, size_t count,
+        std::vector<SpaceGridPoint> &queries) {
+    queries.resize(count);
+    for (size_t i = 0; i < queries.size(); ++i) {
+        const SpaceGridPoint &near = points[rand() % points.size()];
+        queries[i].x = near.x + randomFloat(-4 * SPACE_RADIUS, 4 * SPACE_RADIUS);
+        queries[i].y = near.y + randomFloat(-4 * SPACE_RADIUS, 4 * SPACE_RADIUS);
+    }
+}
+
+/**
+ * @brief Zustand des Fingers beim Vergrößern eines Spielfeldes.
+ */
+typedef struct Drag {
+    /**
+     * Position des Fingers.
+     */
+    float x, y;
+    /**
+     * Richtung, in die der Finger gezogen wird, im Bogenmaß.
+     */
+    float direction;
+} Drag;
+
+/**
+ * Vergrößert ein Spielfeld um ein Feld, indem der Finger weitergezogen wird. Bei einer Sackgasse
+ * wird an einem zufälligen Feld weitergemacht.
+ *
+ * @param grid Gitter des Spielfeldes.
+ * @param points Positionen der Felder.
+ * @param drag Zustand des Fingers.
+ * @return false, wenn kein Speicher angefordert werden konnte.
+ */
+static bool growField(SpaceGrid *grid, std::vector<SpaceGridPoint> &points, Drag &drag) {
+    for (;;) {
+        for (int attempt = 0; attempt < 16; ++attempt) {
+            drag.direction += randomFloat(-0.8f, 0.8f);
+            float x = drag.x + cosf(drag.direction) * 2.2f * SPACE_RADIUS;
+            float y = drag.y + sinf(drag.direction) * 2.2f * SPACE_RADIUS;
+            if (isSpaceGridAreaFree(grid, x, y, 2 * SPACE_RADIUS)) {
+                SpaceGridPoint point = { x, y };
+                points.push_back(point);
+                drag.x = x;
+                drag.y = y;
+                return insertIntoSpaceGrid(grid, x, y);
+            }
+        }
+        const SpaceGridPoint &restart = points[rand() % points.size()];
+        drag.x = restart.x;
+        drag.y = restart.y;
+        drag.direction = randomFloat(0.f, 6.2832f);
+    }
+}
+
+/**
+ * Misst die Prüfung beim Erzeugen von Feldern für wachsende Spielfelder.
+ *
+ * @return true, wenn Gitter und linearer Durchlauf übereinstimmen.
+ */
+static bool benchmarkPlacement() {
+    static SpaceGrid grid;
+    clearSpaceGrid(&grid, 2 * SPACE_RADIUS);
+    std::vector<SpaceGridPoint> points;
+    std::vector<SpaceGridPoint> queries;
+    Drag drag = { 0.f, 0.f, 0.f };
+    printf("%8s %16s %16s\n", "spaces", "grid [ns/check]", "linear [ns/check]");
+    for (size_t size = 125; size <= MAX_FIELD_SIZE; size *= 2) {
+        while (points.size() < size) {
+            if (!growField(&grid, points, drag)) {
+                fprintf(stderr, "Out of memory\n");
+                return false;
+            }
+        }
+        createQueries(points, CHECK_COUNT, queries);
+        std::vector<bool> gridResults(queries.size());
+        double start = currentTime();
+        for (size_t i = 0; i < queries.size(); ++i) {
+            gridResults[i] = isSpaceGridAreaFree(&grid, queries[i].x, queries[i].y,
+                    2 * SPACE_RADIUS);
+        }
+        double gridTime = currentTime() - start;
+        int mismatchCount = 0;
+        start = currentTime();
+        for (size_t i = 0; i < queries.size(); ++i) {
+            mismatchCount += canCreateSpaceLinear(points, queries[i].x, queries[i].y)
+                    != gridResults[i];
+        }
+        double linearTime = currentTime() - start;
+        printf("%8u %16.1f %16.1f\n", (unsigned int)points.size(),
+                gridTime / queries.size() * 1e9, linearTime / queries.size() * 1e9);
+        if (mismatchCount > 0) {
+            fprintf(stderr, "%d checks differ from the linear scan\n", mismatchCount);
+            return false;
+        }
+    }
+    clearSpaceGrid(&grid, 2 * SPACE_RADIUS);
+    return true;
+}
+
+/**
+ * Misst das Tippen auf Felder für mehrere Spielfeld-Größen.
+ *
+ * @return true, wenn Gitter und lineare Suche übereinstimmen.
+ */
+static bool benchmarkTaps() {
+    static const size_t sizes[] = { 100, 1000, 10000 };
+    static SpaceGrid grid;
+    std::vector<SpaceGridPoint> taps;
+    printf("%8s %8s %14s %14s %14s\n", "spaces", "hits", "grid [ns/tap]", "nearest [ns]",
+            "first [ns]");
+    for (size_t s = 0; s < sizeof(sizes) / sizeof(sizes[0]); ++s) {
+        clearSpaceGrid(&grid, 2 * SPACE_RADIUS);
+        std::vector<SpaceGridPoint> points;
+        Drag drag = { 0.f, 0.f, 0.f };
+        while (points.size() < sizes[s]) {
+            if (!growField(&grid, points, drag)) {
+                fprintf(stderr, "Out of memory\n");
+                return false;
+            }
+        }
+        createQueries(points, TAP_COUNT, taps);
+        std::vector<int32_t> gridResults(taps.size());
+        double start = currentTime();
+        for (size_t i = 0; i < taps.size(); ++i) {
+            gridResults[i] = findNearestInSpaceGrid(&grid, taps[i].x, taps[i].y, SPACE_RADIUS);
+        }
+        double gridTime = currentTime() - start;
+        // die linearen Suchen nur auf einer Stichprobe messen, bei 10000 Feldern dauert eine
+        // Million Abfragen sonst zu lange
+        size_t sampleCount = taps.size() / (sizes[s] >= 10000 ? 100 : sizes[s] >= 1000 ? 10 : 1);
+        int mismatchCount = 0;
+        start = currentTime();
+        for (size_t i = 0; i < sampleCount; ++i) {
+            mismatchCount += findNearestLinear(points, taps[i].x, taps[i].y) != gridResults[i];
+        }
+        double nearestTime = currentTime() - start;
+        start = currentTime();
+        for (size_t i = 0; i < sampleCount; ++i) {
+            selectedSpace = selectSpaceLinear(points, taps[i].x, taps[i].y);
+        }
+        double firstTime = currentTime() - start;
+        size_t hitCount = 0;
+        for (size_t i = 0; i < taps.size(); ++i) {
+            hitCount += gridResults[i] >= 0;
+        }
+        printf("%8u %7.1f%% %14.1f %14.1f %14.1f\n", (unsigned int)sizes[s],
+                100.f * hitCount / taps.size(), gridTime / taps.size() * 1e9,
+                nearestTime / sampleCount * 1e9, firstTime / sampleCount * 1e9);
+        if (mismatchCount > 0) {
+            fprintf(stderr, "%d taps differ from the linear search\n", mismatchCount);
+            return false;
+        }
+    }
+    clearSpaceGrid(&grid, 2 * SPACE_RADIUS);
+    return true;
+}
+
+/**
+ * @brief Umsetzung der Kernel, die mit der skalaren verglichen wird.
+ */
+typedef struct SpaceKernel {
+    /**
+     * Name der Umsetzung.
+     */
+    const char *name;
+    /**
+     * Umsetzung von isSpaceArrayAreaFreeScalar().
+     */
+    IsSpaceArrayAreaFreeFunction isAreaFree;
+    /**
+     * Umsetzung von findNearestInSpaceArrayScalar().
+     */
+    FindNearestInSpaceArrayFunction findNearest;
+} SpaceKernel;
+
+/**
+ * Umsetzungen der Kernel, die mit der skalaren verglichen werden.
+ */
+static const SpaceKernel SPACE_KERNELS[] = {
+#ifdef __SSE2__
+    { "SSE2", isSpaceArrayAreaFreeSse, findNearestInSpaceArraySse },
+#endif
+#ifdef HAVE_NEON_KERNELS
+    { "NEON", isSpaceArrayAreaFreeNeon, findNearestInSpaceArrayNeon },
+#endif
+    { "scalar", isSpaceArrayAreaFreeScalar, findNearestInSpaceArrayScalar }
+};
+
+/**
+ * Vergleicht die Kernel mit countSpaceKernelMismatches() mit der skalaren Umsetzung, mit derselben
+ * Prüfung, die Debug-Builds auf dem Gerät beim Start für die NEON-Kernel ausführen.
+ *
+ * @return true, wenn alle Kernel übereinstimmen.
+ */
+static bool checkKernels() {
+    static const int kernelCount = sizeof(SPACE_KERNELS) / sizeof(SPACE_KERNELS[0]);
+    static const int32_t roundCount = 200;
+    int mismatchCount = 0;
+    printf("kernels:");
+    for (int k = 0; k < kernelCount; ++k) {
+        int32_t mismatches = countSpaceKernelMismatches(SPACE_KERNELS[k].isAreaFree,
+                SPACE_KERNELS[k].findNearest, roundCount);
+        if (mismatches != 0) {
+            fprintf(stderr, "%s differs in %d queries\n", SPACE_KERNELS[k].name, mismatches);
+        }
+        mismatchCount += mismatches;
+        printf(" %s", SPACE_KERNELS[k].name);
+    }
+    printf(", %d queries each, %d mismatches\n", roundCount * 301, mismatchCount);
+    return mismatchCount == 0;
+}
+
+/**
+ * Misst die Prüfung beim Erzeugen von Feldern für kleine Spielfelder mit dem Gitter und mit dem
+ * Durchlauf über alle Felder mit den Kerneln.
+ *
+ * @return true, wenn Gitter und Kernel übereinstimmen.
+ */
+static bool benchmarkKernels() {
+    static SpaceGrid grid;
+    static const int kernelCount = sizeof(SPACE_KERNELS) / sizeof(SPACE_KERNELS[0]);
+    clearSpaceGrid(&grid, 2 * SPACE_RADIUS);
+    std::vector<SpaceGridPoint> points;
+    std::vector<SpaceGridPoint> queries;
+    std::vector<float> x, y;
+    Drag drag = { 0.f, 0.f, 0.f };
+    float limit = 4 * SPACE_RADIUS * SPACE_RADIUS;
+    printf("%8s %16s", "spaces", "grid [ns/check]");
+    for (int k = 0; k < kernelCount; ++k) {
+        printf(" %10s [ns]", SPACE_KERNELS[k].name);
+    }
+    printf("\n");
+    for (size_t size = 16; size <= 1024; size *= 2) {
+        while (points.size() < size) {
+            if (!growField(&grid, points, drag)) {
+                fprintf(stderr, "Out of memory\n");
+                return false;
+            }
+            x.push_back(points.back().x);
+            y.push_back(points.back().y);
+        }
+        createQueries(points, CHECK_COUNT * 10, queries);
+        std::vector<bool> gridResults(queries.size());
+        double start = currentTime();
+        for (size_t i = 0; i < queries.size(); ++i) {
+            gridResults[i] = isSpaceGridAreaFree(&grid, queries[i].x, queries[i].y,
+                    2 * SPACE_RADIUS);
+        }
+        printf("%8u %16.1f", (unsigned int)size, (currentTime() - start) / queries.size() * 1e9);
+        int mismatchCount = 0;
+        for (int k = 0; k < kernelCount; ++k) {
+            start = currentTime();
+            for (size_t i = 0; i < queries.size(); ++i) {
+                mismatchCount += SPACE_KERNELS[k].isAreaFree(&x[0], &y[0], (int32_t)size,
+                        queries[i].x, queries[i].y, limit) != gridResults[i];
+            }
+            printf(" %15.1f", (currentTime() - start) / queries.size() * 1e9);
+        }
+        printf("\n");
+        if (mismatchCount > 0) {
+            fprintf(stderr, "%d checks differ from the grid\n", mismatchCount);
+            return false;
+        }
+    }
+    clearSpaceGrid(&grid, 2 * SPACE_RADIUS);
+    return true;
+}
+
+/**
+ * Einstiegspunkt des Werkzeugs.
+ *
+ * @return 0 bei Erfolg, sonst 1.
+ */
+int main() {
+    srand(1);
+    return benchmarkPlacement() && benchmarkTaps() && checkKernels() && benchmarkKernels() ? 0 : 1;
+}
@@ -0,0 +1,63 @@
+/**
+ * @file Matrices.h
+ *
+ * @brief Nachbildung der Vektoren und Matrizen des QCAR SDK für tools/drawCallBenchmark.cpp.
+ *
+ * @author Alexander Bertram
+ *
+ * @date 17.10.2026
+ */
+
+#ifndef GL_SHIM_QCAR_MATRICES_H
+#define GL_SHIM_QCAR_MATRICES_H
+
+namespace QCAR {
+
+struct Vec2F {
+    Vec2F() {
+    }
+    Vec2F(float v0, float v1) {
+        data[0] = v0;
+        data[1] = v1;
+    }
+    float data[2];
+};
+
+struct Vec3F {
+    Vec3F() {
+    }
+    Vec3F(float v0, float v1, float v2) {
+        data[0] = v0;
+        data[1] = v1;
+        data[2] = v2;
+    }
+    float data[3];
+};
+
+struct Vec4F {
+    Vec4F() {
+    }
+    Vec4F(float v0, float v1, float v2, float v3) {
+        data[0] = v0;
+        data[1] = v1;
+        data[2] = v2;
+        data[3] = v3;
+    }
+    float data[4];
+};
+
+struct Vec2I {
+    int data[2];
+};
+
+struct Matrix34F {
+    float data[12];
+};
+
+struct Matrix44F {
+    float data[16];
+};
+
+}
+
+#endif
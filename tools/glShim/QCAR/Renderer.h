@@ -0,0 +1,28 @@
+/**
+ * @file Renderer.h
+ *
+ * @brief Nachbildung des Renderers des QCAR SDK für tools/drawCallBenchmark.cpp. Es wird nur die
+ *      Konfiguration des Video-Hintergrundes abgefragt (siehe glShim.cpp).
+ *
+ * @author Alexander Bertram
+ *
+ * @date 17.10.2026
+ */
+
+#ifndef GL_SHIM_QCAR_RENDERER_H
+#define GL_SHIM_QCAR_RENDERER_H
+
+#include <QCAR/Matrices.h>
+#include <QCAR/VideoBackgroundConfig.h>
+
+namespace QCAR {
+
+class Renderer {
+public:
+    static Renderer& getInstance();
+    const VideoBackgroundConfig& getVideoBackgroundConfig() const;
+};
+
+}
+
+#endif
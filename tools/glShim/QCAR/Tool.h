@@ -0,0 +1,30 @@
+/**
+ * @file Tool.h
+ *
+ * @brief Nachbildung der Hilfsfunktionen des QCAR SDK für tools/drawCallBenchmark.cpp. Die
+ *      Funktionen werden vom Renderer nicht aufgerufen und sind deshalb nur deklariert.
+ *
+ * @author Alexander Bertram
+ *
+ * @date 17.10.2026
+ */
+
+#ifndef GL_SHIM_QCAR_TOOL_H
+#define GL_SHIM_QCAR_TOOL_H
+
+#include <QCAR/Matrices.h>
+
+namespace QCAR {
+
+class CameraCalibration;
+
+namespace Tool {
+
+Matrix44F convertPose2GLMatrix(const Matrix34F&);
+Matrix44F getProjectionGL(const CameraCalibration&, float, float);
+
+}
+
+}
+
+#endif
@@ -0,0 +1,28 @@
+/**
+ * @file VideoBackgroundConfig.h
+ *
+ * @brief Nachbildung der Konfiguration des Video-Hintergrundes des QCAR SDK für
+ *      tools/drawCallBenchmark.cpp.
+ *
+ * @author Alexander Bertram
+ *
+ * @date 17.10.2026
+ */
+
+#ifndef GL_SHIM_QCAR_VIDEO_BACKGROUND_CONFIG_H
+#define GL_SHIM_QCAR_VIDEO_BACKGROUND_CONFIG_H
+
+#include <QCAR/Matrices.h>
+
+namespace QCAR {
+
+struct VideoBackgroundConfig {
+    bool mEnabled;
+    bool mSynchronous;
+    Vec2I mPosition;
+    Vec2I mSize;
+};
+
+}
+
+#endif
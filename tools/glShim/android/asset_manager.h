@@ -0,0 +1,18 @@
+/**
+ * @file asset_manager.h
+ *
+ * @brief Nachbildung der Typen des Android-Asset-Managers für tools/drawCallBenchmark.cpp. Es
+ *      werden keine Dateien aus dem Android Package gelesen.
+ *
+ * @author Alexander Bertram
+ *
+ * @date 17.10.2026
+ */
+
+#ifndef GL_SHIM_ANDROID_ASSET_MANAGER_H
+#define GL_SHIM_ANDROID_ASSET_MANAGER_H
+
+typedef struct AAssetManager AAssetManager;
+typedef struct AAsset AAsset;
+
+#endif
@@ -0,0 +1,23 @@
+/**
+ * @file log.h
+ *
+ * @brief Nachbildung des Android-Logs für tools/drawCallBenchmark.cpp (siehe glShim.cpp).
+ *
+ * @author Alexander Bertram
+ *
+ * @date 17.10.2026
+ */
+
+#ifndef GL_SHIM_ANDROID_LOG_H
+#define GL_SHIM_ANDROID_LOG_H
+
+enum {
+    ANDROID_LOG_DEBUG = 3,
+    ANDROID_LOG_INFO = 4,
+    ANDROID_LOG_WARN = 5,
+    ANDROID_LOG_ERROR = 6
+};
+
+int __android_log_print(int, const char*, const char*, ...);
+
+#endif
@@ -0,0 +1,304 @@
+/**
+ * @file glShim.cpp
+ *
+ * @brief Zählende Nachbildung der von jni/renderer.cpp verwendeten GL-Funktionen, damit der
+ *      Renderer auf dem Entwicklungsrechner ohne GL-Kontext ausgeführt werden kann.
+ *
+ * @details Jede Funktion zählt ihren Aufruf, Zeichenaufrufe und Uploads werden zusätzlich getrennt
+ *      gezählt. Shader werden immer erfolgreich übersetzt und gebunden. Die Version des Kontextes
+ *      lässt sich setzen, damit der Renderer sowohl die feste Funktions-Pipeline (OpenGL ES 1.1)
+ *      als auch die Shader (OpenGL ES 2.0) wählt. Außerdem werden das Android-Log und der
+ *      QCAR-Renderer nachgebildet (siehe die Header in diesem Verzeichnis).
+ *
+ * @author Alexander Bertram
+ *
+ * @date 17.10.2026
+ */
+
+#include <stdarg.h>
+#include <stdio.h>
+#include <string.h>
+
+#include <GLES/gl.h>
+#include <GLES2/gl2.h>
+
+#include <android/log.h>
+#include <QCAR/Renderer.h>
+
+#include "glShim.h"
+
+/**
+ * GL-Aufrufe.
+ */
+GlCallCounts glCallCounts;
+/**
+ * Version, die glGetString(GL_VERSION) zurückgibt.
+ */
+static const char *glShimVersion = "OpenGL ES-CM 1.1";
+/**
+ * Zuletzt vergebener Name für Buffer, Shader, Programme und Uniforms.
+ */
+static GLuint lastGlName = 0;
+
+/**
+ * Setzt die Anzahl der GL-Aufrufe zurück.
+ */
+void resetGlCallCounts() {
+    memset(&glCallCounts, 0, sizeof(glCallCounts));
+}
+
+/**
+ * Setzt die Version des nachgebildeten Kontextes.
+ *
+ * @param version Rückgabe von glGetString(GL_VERSION), z.B. "OpenGL ES 2.0".
+ */
+void setGlShimVersion(const char *version) {
+    glShimVersion = version;
+}
+
+/**
+ * Gibt Fehler des Renderers aus, alle anderen Log-Einträge werden verworfen.
+ */
+int __android_log_print(int priority, const char *tag, const char *format, ...) {
+    if (priority < ANDROID_LOG_ERROR) {
+        return 0;
+    }
+    va_list arguments;
+    va_start(arguments, format);
+    fprintf(stderr, "%s: ", tag);
+    int length = vfprintf(stderr, format, arguments);
+    fputc('\n', stderr);
+    va_end(arguments);
+    return length;
+}
+
+namespace QCAR {
+
+/**
+ * Gibt den einzigen Renderer zurück.
+ */
+Renderer& Renderer::getInstance() {
+    static Renderer renderer;
+    return renderer;
+}
+
+/**
+ * Gibt einen Video-Hintergrund in der Größe eines typischen Displays zurück.
+ */
+const VideoBackgroundConfig& Renderer::getVideoBackgroundConfig() const {
+    static const VideoBackgroundConfig config = { true, true, { { 0, 0 } }, { { 800, 480 } } };
+    return config;
+}
+
+}
+
+/**
+ * Zählt einen GL-Aufruf.
+ */
+#define COUNT_GL_CALL() ++glCallCounts.callCount
+
+// GL-Funktionen
+extern "C" {
+
+void glActiveTexture(GLenum) {
+    COUNT_GL_CALL();
+}
+
+void glAttachShader(GLuint, GLuint) {
+    COUNT_GL_CALL();
+}
+
+void glBindAttribLocation(GLuint, GLuint, const GLchar*) {
+    COUNT_GL_CALL();
+}
+
+void glBindBuffer(GLenum, GLuint) {
+    COUNT_GL_CALL();
+}
+
+void glBindTexture(GLenum, GLuint) {
+    COUNT_GL_CALL();
+}
+
+void glBlendFunc(GLenum, GLenum) {
+    COUNT_GL_CALL();
+}
+
+void glBufferData(GLenum, GLsizeiptr, const void*, GLenum) {
+    COUNT_GL_CALL();
+    ++glCallCounts.bufferUploadCount;
+}
+
+void glCompileShader(GLuint) {
+    COUNT_GL_CALL();
+}
+
+GLuint glCreateProgram() {
+    COUNT_GL_CALL();
+    return ++lastGlName;
+}
+
+GLuint glCreateShader(GLenum) {
+    COUNT_GL_CALL();
+    return ++lastGlName;
+}
+
+void glDeleteProgram(GLuint) {
+    COUNT_GL_CALL();
+}
+
+void glDeleteShader(GLuint) {
+    COUNT_GL_CALL();
+}
+
+void glDisable(GLenum) {
+    COUNT_GL_CALL();
+}
+
+void glDisableClientState(GLenum) {
+    COUNT_GL_CALL();
+}
+
+void glDisableVertexAttribArray(GLuint) {
+    COUNT_GL_CALL();
+}
+
+void glDrawArrays(GLenum, GLint, GLsizei) {
+    COUNT_GL_CALL();
+    ++glCallCounts.drawCallCount;
+}
+
+void glDrawElements(GLenum, GLsizei, GLenum, const void*) {
+    COUNT_GL_CALL();
+    ++glCallCounts.drawCallCount;
+}
+
+void glEnable(GLenum) {
+    COUNT_GL_CALL();
+}
+
+void glEnableClientState(GLenum) {
+    COUNT_GL_CALL();
+}
+
+void glEnableVertexAttribArray(GLuint) {
+    COUNT_GL_CALL();
+}
+
+void glGenBuffers(GLsizei count, GLuint *buffers) {
+    COUNT_GL_CALL();
+    for (GLsizei i = 0; i < count; ++i) {
+        buffers[i] = ++lastGlName;
+    }
+}
+
+GLenum glGetError() {
+    COUNT_GL_CALL();
+    return GL_NO_ERROR;
+}
+
+void glGetProgramInfoLog(GLuint, GLsizei, GLsizei *length, GLchar *infoLog) {
+    COUNT_GL_CALL();
+    if (length != NULL) {
+        *length = 0;
+    }
+    if (infoLog != NULL) {
+        infoLog[0] = '\0';
+    }
+}
+
+void glGetProgramiv(GLuint, GLenum name, GLint *value) {
+    COUNT_GL_CALL();
+    *value = name == GL_LINK_STATUS ? GL_TRUE : 0;
+}
+
+void glGetShaderInfoLog(GLuint, GLsizei, GLsizei *length, GLchar *infoLog) {
+    COUNT_GL_CALL();
+    if (length != NULL) {
+        *length = 0;
+    }
+    if (infoLog != NULL) {
+        infoLog[0] = '\0';
+    }
+}
+
+void glGetShaderiv(GLuint, GLenum name, GLint *value) {
+    COUNT_GL_CALL();
+    *value = name == GL_COMPILE_STATUS ? GL_TRUE : 0;
+}
+
+const GLubyte* glGetString(GLenum name) {
+    COUNT_GL_CALL();
+    return (const GLubyte*)(name == GL_VERSION ? glShimVersion : "");
+}
+
+GLint glGetUniformLocation(GLuint, const GLchar*) {
+    COUNT_GL_CALL();
+    return ++lastGlName;
+}
+
+void glLightfv(GLenum, GLenum, const GLfloat*) {
+    COUNT_GL_CALL();
+}
+
+void glLinkProgram(GLuint) {
+    COUNT_GL_CALL();
+}
+
+void glLoadMatrixf(const GLfloat*) {
+    COUNT_GL_CALL();
+}
+
+void glMatrixMode(GLenum) {
+    COUNT_GL_CALL();
+}
+
+void glMultMatrixf(const GLfloat*) {
+    COUNT_GL_CALL();
+}
+
+void glNormalPointer(GLenum, GLsizei, const void*) {
+    COUNT_GL_CALL();
+}
+
+void glPopMatrix() {
+    COUNT_GL_CALL();
+}
+
+void glPushMatrix() {
+    COUNT_GL_CALL();
+}
+
+void glShaderSource(GLuint, GLsizei, const GLchar *const*, const GLint*) {
+    COUNT_GL_CALL();
+}
+
+void glTexCoordPointer(GLint, GLenum, GLsizei, const void*) {
+    COUNT_GL_CALL();
+}
+
+void glUniform1i(GLint, GLint) {
+    COUNT_GL_CALL();
+}
+
+void glUniform4fv(GLint, GLsizei, const GLfloat*) {
+    COUNT_GL_CALL();
+}
+
+void glUniformMatrix4fv(GLint, GLsizei, GLboolean, const GLfloat*) {
+    COUNT_GL_CALL();
+}
+
+void glUseProgram(GLuint) {
+    COUNT_GL_CALL();
+}
+
+void glVertexAttribPointer(GLuint, GLint, GLenum, GLboolean, GLsizei, const void*) {
+    COUNT_GL_CALL();
+}
+
+void glVertexPointer(GLint, GLenum, GLsizei, const void*) {
+    COUNT_GL_CALL();
+}
+
+}
@@ -0,0 +1,40 @@
+/**
+ * @file glShim.h
+ *
+ * @brief Schnittstelle zu glShim.cpp.
+ *
+ * @author Alexander Bertram
+ *
+ * @date 17.10.2026
+ */
+
+#ifndef GL_SHIM_H
+#define GL_SHIM_H
+
+/**
+ * @brief Anzahl der GL-Aufrufe seit dem letzten resetGlCallCounts().
+ */
+typedef struct GlCallCounts {
+    /**
+     * Alle GL-Aufrufe.
+     */
+    unsigned int callCount;
+    /**
+     * Zeichenaufrufe (glDrawArrays und glDrawElements).
+     */
+    unsigned int drawCallCount;
+    /**
+     * Uploads in Buffer-Objekte (glBufferData).
+     */
+    unsigned int bufferUploadCount;
+} GlCallCounts;
+
+/*
+ * GL-Aufrufe (verwaltet in glShim.cpp).
+ */
+extern GlCallCounts glCallCounts;
+
+void resetGlCallCounts();
+void setGlShimVersion(const char*);
+
+#endif
@@ -0,0 +1,144 @@
+/**
+ * @file latheBenchmark.cpp
+ *
+ * @brief Werkzeug, das die Erzeugung der Spielfigur als Rotationskörper (jni/latheMesh.cpp) auf
+ *      dem Entwicklungsrechner misst und prüft.
+ *
+ * @details Für mehrere Segment-Anzahlen werden Vertices, Dreiecke und Größe des erzeugten Models
+ *      sowie die durchschnittliche Dauer einer Erzeugung ausgegeben. Zusätzlich wird geprüft, wie
+ *      weit die Spielfigur bei 32 Segmenten (der Unterteilung der Quelldaten) von den Positionen
+ *      in media/pawnSource.h abweicht.
+ *
+ *      Das Werkzeug wird über "ant lathe-benchmark" gebaut und ausgeführt.
+ *
+ * @author Alexander Bertram
+ *
+ * @date 15.10.2026
+ */
+
+#include <math.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <time.h>
+
+#include "../jni/latheMesh.h"
+#include "../jni/meshFile.h"
+#include "../jni/pawnProfile.h"
+#include "../media/pawnSource.h"
+
+/**
+ * Knickwinkel in Grad, mit dem die Spielfigur erzeugt wird (wie in jni/constants.h).
+ */
+#define CREASE_ANGLE 45.f
+
+/**
+ * Anzahl der Detailstufen, mit der die Spielfigur erzeugt wird.
+ */
+#define LEVEL_OF_DETAIL_COUNT 4
+
+/**
+ * Segment-Anzahl der Quelldaten.
+ */
+#define SOURCE_SEGMENT_COUNT 32
+
+/**
+ * Mindestdauer einer Messung in Sekunden.
+ */
+#define MIN_MEASUREMENT_TIME 0.25
+
+/**
+ * Gibt die aktuelle Zeit in Sekunden zurück.
+ *
+ * @return Zeit in Sekunden.
+ */
+static double currentTime() {
+    struct timespec time;
+    clock_gettime(CLOCK_MONOTONIC, &time);
+    return time.tv_sec + time.tv_nsec / 1e9;
+}
+
+/**
+ * Bestimmt die größte Abweichung der Quell-Positionen von der nächstgelegenen Position der vollen
+ * Detailstufe eines erzeugten Models.
+ *
+ * @param data Das erzeugte Model im Format der Model-Dateien.
+ * @return Größte Abweichung in Model-Koordinaten.
+ */
+static float maxSourceDeviation(const void *data) {
+    const MeshFileHeader *header = (const MeshFileHeader*)data;
+    const MeshLevelOfDetail *levelsOfDetail = (const MeshLevelOfDetail*)(header + 1);
+    const MeshVertex *vertices = (const MeshVertex*)(levelsOfDetail + header->levelOfDetailCount);
+    const uint16_t *indices = (const uint16_t*)(vertices + header->vertexCount);
+    // Vertices der vollen Detailstufe (liegen vor den Vertices der anderen Detailstufen)
+    unsigned int vertexCount = 0;
+    for (int i = 0; i < levelsOfDetail[0].indexCount; ++i) {
+        if (indices[i] + 1u > vertexCount) {
+            vertexCount = indices[i] + 1;
+        }
+    }
+    float maxDeviation = 0.f;
+    for (int s = 0; s < PAWN_VERTICES_COUNT; ++s) {
+        float minDistanceSquared = HUGE_VALF;
+        for (unsigned int v = 0; v < vertexCount; ++v) {
+            float distanceSquared = 0.f;
+            for (int j = 0; j < 3; ++j) {
+                float d = header->positionOffset[j] + header->positionScale
+                        * vertices[v].position[j] - pawnVertices[s * 3 + j];
+                distanceSquared += d * d;
+            }
+            if (distanceSquared < minDistanceSquared) {
+                minDistanceSquared = distanceSquared;
+            }
+        }
+        if (sqrtf(minDistanceSquared) > maxDeviation) {
+            maxDeviation = sqrtf(minDistanceSquared);
+        }
+    }
+    return maxDeviation;
+}
+
+/**
+ * Einstiegspunkt des Werkzeugs.
+ *
+ * @return 0 bei Erfolg, sonst 1.
+ */
+int main() {
+    static const int segmentCounts[] = { 8, 12, 16, 24, 32, 48, 64, 96, 128 };
+    printf("Profile points: %d, levels of detail: %d\n", PAWN_PROFILE_POINT_COUNT,
+            LEVEL_OF_DETAIL_COUNT);
+    printf("%8s %9s %10s %9s %12s\n", "segments", "vertices", "triangles", "bytes", "time [us]");
+    for (size_t i = 0; i < sizeof(segmentCounts) / sizeof(segmentCounts[0]); ++i) {
+        size_t size = 0;
+        void *data = NULL;
+        int iterations = 0;
+        double start = currentTime();
+        double elapsed;
+        do {
+            free(data);
+            data = generateLatheMesh(pawnProfile, PAWN_PROFILE_POINT_COUNT, segmentCounts[i],
+                    LEVEL_OF_DETAIL_COUNT, CREASE_ANGLE, &size);
+            if (data == NULL) {
+                fprintf(stderr, "Generating %d segments failed\n", segmentCounts[i]);
+                return 1;
+            }
+            ++iterations;
+            elapsed = currentTime() - start;
+        } while (elapsed < MIN_MEASUREMENT_TIME);
+        const MeshFileHeader *header = (const MeshFileHeader*)data;
+        const MeshLevelOfDetail *levelsOfDetail = (const MeshLevelOfDetail*)(header + 1);
+        printf("%8d %9u %10d %9u %12.1f\n", segmentCounts[i], header->vertexCount,
+                levelsOfDetail[0].indexCount / 3, (unsigned int)size,
+                elapsed / iterations * 1e6);
+        if (segmentCounts[i] == SOURCE_SEGMENT_COUNT) {
+            float deviation = maxSourceDeviation(data);
+            printf("%8s max deviation from source: %g model units\n", "", deviation);
+            if (deviation > 1e-3f) {
+                fprintf(stderr, "Lathe does not match the source model\n");
+                free(data);
+                return 1;
+            }
+        }
+        free(data);
+    }
+    return 0;
+}
@@ -0,0 +1,39 @@
+/**
+ * @file mesh.h
+ *
+ * @brief Datentypen der Werkzeuge zur Model-Aufbereitung.
+ *
+ * @author Alexander Bertram
+ *
+ * @date 14.10.2026
+ */
+
+#ifndef MESH_H
+#define MESH_H
+
+#include <vector>
+
+/**
+ * @brief Indiziertes Model.
+ */
+typedef struct Mesh {
+    /**
+     * Vertex-Positionen (jeweils x, y und z).
+     */
+    std::vector<float> positions;
+    /**
+     * Vertex-Normale (jeweils x, y und z).
+     */
+    std::vector<float> normals;
+    /**
+     * Indizes der Dreiecke (jeweils drei pro Dreieck) in voller Detailstufe.
+     */
+    std::vector<unsigned short> indices;
+    /**
+     * Indizes der vereinfachten Detailstufen, beginnend mit der zweiten Detailstufe. Alle
+     * Detailstufen verwenden dieselben Vertices.
+     */
+    std::vector<std::vector<unsigned short> > levelsOfDetail;
+} Mesh;
+
+#endif
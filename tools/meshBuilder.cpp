@@ -0,0 +1,805 @@
+/**
+ * @file meshBuilder.cpp
+ *
+ * @brief Werkzeug, das aus den Quelldaten der Spielfigur (media/pawnSource.h) die Render-Daten
+ *      erzeugt.
+ *
+ * @details Die Quelldaten sind eine nicht indizierte Dreiecksliste, in der jeder Vertex bis zu
+ *      sechs Mal vorkommt. Das Werkzeug fasst gleiche Positions-Normalen-Paare zu einem Vertex
+ *      zusammen und erzeugt eine Vertex-Tabelle und einen 16-Bit-Index-Buffer, die als binäre
+ *      Model-Datei (siehe jni/meshFile.h) nach assets/pawn.mesh geschrieben werden. Die Datei wird
+ *      danach wieder eingelesen und gegen das Model geprüft.
+ *
+ *      Weil die Quelldaten flach schattiert sind (eine Normale pro Dreieck), bringt das reine
+ *      Zusammenfassen gleicher Paare kaum etwas. Deshalb werden die Normalen benachbarter Dreiecke,
+ *      deren Winkel den Knickwinkel nicht überschreitet, vorher gemittelt. Bei einem Knickwinkel
+ *      von 0 Grad werden die Normalen unverändert übernommen.
+ *
+ *      Nach dem Erzeugen wird das indizierte Model wieder zu einer Dreiecksliste expandiert und mit
+ *      den Quelldaten verglichen. Bei Abweichungen bricht das Werkzeug mit einem Fehler ab.
+ *
+ *      Anschließend wird das Model quantisiert: Positionen als GLshort, Normale als GLbyte,
+ *      verschränkt in einem Vertex von 12 Byte statt 24 Byte. Der größte Quantisierungsfehler
+ *      gegenüber den Float-Quelldaten wird ausgegeben.
+ *
+ *      Zusätzlich werden vereinfachte Detailstufen erzeugt (siehe meshSimplifier.cpp), die
+ *      denselben Vertex-Buffer verwenden und hintereinander im Index-Buffer abgelegt werden.
+ *      Danach werden Dreiecke und Vertices für den Vertex-Cache umsortiert (siehe
+ *      meshOptimizer.cpp). Die durchschnittliche Anzahl an Cache-Fehlern pro Dreieck wird vorher
+ *      und nachher ausgegeben.
+ *
+ *      Mit der Option -p wird zusätzlich das Profil der Spielfigur als Header-Datei ausgegeben, aus
+ *      dem jni/latheMesh.cpp die Spielfigur zur Laufzeit als Rotationskörper erzeugt.
+ *
+ *      Das Werkzeug läuft auf dem Entwicklungsrechner und wird über "ant mesh" gebaut und
+ *      ausgeführt. Aufruf: meshBuilder [-c Knickwinkel] [-l Detailstufen] [-p Profildatei]
+ *      Ausgabedatei
+ *
+ * @author Alexander Bertram
+ *
+ * @date 14.10.2026
+ */
+
+#include <fcntl.h>
+#include <math.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <unistd.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+
+#include <algorithm>
+#include <map>
+#include <set>
+#include <vector>
+
+#include "../jni/meshFile.h"
+#include "../media/pawnSource.h"
+#include "mesh.h"
+#include "meshOptimizer.h"
+#include "meshSimplifier.h"
+
+/**
+ * Standard-Knickwinkel in Grad, bis zu dem die Normalen benachbarter Dreiecke gemittelt werden.
+ */
+#define DEFAULT_CREASE_ANGLE 45.f
+
+/**
+ * Standard-Anzahl der Detailstufen (inklusive der vollen Detailstufe).
+ */
+#define DEFAULT_LEVEL_OF_DETAIL_COUNT 4
+
+/**
+ * Größe des FIFO-Caches, mit dem die durchschnittliche Anzahl an Cache-Fehlern pro Dreieck (ACMR)
+ * gemessen wird. Entspricht dem Post-Transform-Cache typischer mobiler GPUs.
+ */
+#define ACMR_CACHE_SIZE 16
+
+/**
+ * Größter Vertex-Index, der in einem 16-Bit-Index-Buffer abgelegt werden kann.
+ */
+#define MAX_INDEX 0xffff
+
+/**
+ * Größter Betrag einer quantisierten Positions-Komponente (GLshort).
+ */
+#define MAX_QUANTIZED_POSITION 32767L
+
+/**
+ * Größter Wert einer quantisierten Normalen-Komponente (GLbyte).
+ */
+#define MAX_QUANTIZED_NORMAL 127L
+
+/**
+ * @brief Quantisiertes Model.
+ */
+typedef struct QuantizedMesh {
+    /**
+     * Mittelpunkt der Bounding-Box, auf den sich die quantisierten Positionen beziehen.
+     */
+    float offset[3];
+    /**
+     * Faktor, mit dem die quantisierten Positionen in Model-Koordinaten umgerechnet werden.
+     */
+    float scale;
+    /**
+     * Quantisierte Positionen (jeweils x, y und z).
+     */
+    std::vector<short> positions;
+    /**
+     * Quantisierte Normale (jeweils x, y und z).
+     */
+    std::vector<signed char> normals;
+    /**
+     * Größter Abstand einer quantisierten Position zur Original-Position in Model-Koordinaten.
+     */
+    float maxPositionError;
+    /**
+     * Größter Winkel zwischen einer quantisierten Normalen und der Original-Normalen in Grad.
+     */
+    float maxNormalError;
+} QuantizedMesh;
+
+/**
+ * @brief Schlüssel, über den gleiche Vertices gefunden werden.
+ *
+ * Es werden die Bitmuster der Komponenten verglichen, damit nur exakt gleiche Werte zusammengefasst
+ * werden.
+ */
+typedef struct VertexKey {
+    /**
+     * Index der geschweißten Position.
+     */
+    unsigned int positionIndex;
+    /**
+     * Bitmuster der Normalen-Komponenten.
+     */
+    unsigned int normal[3];
+
+    bool operator<(const VertexKey &other) const {
+        return memcmp(this, &other, sizeof(VertexKey)) < 0;
+    }
+} VertexKey;
+
+/**
+ * @brief Bitmuster einer Position (für das Schweißen gleicher Positionen).
+ */
+typedef struct PositionKey {
+    /**
+     * Bitmuster der Positions-Komponenten.
+     */
+    unsigned int data[3];
+
+    bool operator<(const PositionKey &other) const {
+        return memcmp(data, other.data, sizeof(data)) < 0;
+    }
+} PositionKey;
+
+/**
+ * Erzeugt den Positions-Schlüssel für einen Vertex der Quelldaten.
+ *
+ * @param vertex Index des Vertex in den Quelldaten.
+ * @return Positions-Schlüssel.
+ */
+static PositionKey sourcePositionKey(int vertex) {
+    PositionKey key;
+    memcpy(key.data, &pawnVertices[vertex * 3], sizeof(key.data));
+    return key;
+}
+
+/**
+ * Normalisiert einen 3D-Vektor.
+ *
+ * @param v Vektor, der normalisiert werden soll.
+ * @return Länge des Vektors vor der Normalisierung.
+ */
+static float normalize(float *v) {
+    float length = sqrtf(v[0] * v[0] + v[1] * v[1] + v[2] * v[2]);
+    if (length != 0.f) {
+        v[0] /= length;
+        v[1] /= length;
+        v[2] /= length;
+    }
+    return length;
+}
+
+/**
+ * Berechnet die Fläche eines Dreiecks der Quelldaten.
+ *
+ * @param triangle Index des Dreiecks.
+ * @return Fläche des Dreiecks.
+ */
+static float sourceTriangleArea(int triangle) {
+    const float *a = &pawnVertices[triangle * 9];
+    const float *b = a + 3;
+    const float *c = a + 6;
+    float u[3] = { b[0] - a[0], b[1] - a[1], b[2] - a[2] };
+    float v[3] = { c[0] - a[0], c[1] - a[1], c[2] - a[2] };
+    float cross[3] = { u[1] * v[2] - u[2] * v[1], u[2] * v[0] - u[0] * v[2], u[0] * v[1]
+            - u[1] * v[0] };
+    return normalize(cross) / 2.f;
+}
+
+/**
+ * Erzeugt aus den Quelldaten ein indiziertes Model.
+ *
+ * @param creaseAngle Knickwinkel in Grad, bis zu dem die Normalen benachbarter Dreiecke gemittelt
+ *      werden. Bei 0 werden die Normalen der Quelldaten unverändert übernommen.
+ * @param mesh Das erzeugte Model.
+ * @return True, wenn das Model erzeugt werden konnte.
+ */
+static bool buildIndexedMesh(float creaseAngle, Mesh &mesh) {
+    const int triangleCount = PAWN_VERTICES_COUNT / 3;
+    // Positionen schweißen und für jede Position die angrenzenden Dreiecke sammeln
+    std::map<PositionKey, unsigned int> positionIndices;
+    std::vector<unsigned int> vertexPositions(PAWN_VERTICES_COUNT);
+    std::vector<std::vector<int> > positionTriangles;
+    for (int i = 0; i < PAWN_VERTICES_COUNT; ++i) {
+        PositionKey key = sourcePositionKey(i);
+        std::map<PositionKey, unsigned int>::iterator it = positionIndices.find(key);
+        if (it == positionIndices.end()) {
+            it = positionIndices.insert(std::make_pair(key, (unsigned int)positionTriangles.size()))
+                    .first;
+            positionTriangles.push_back(std::vector<int>());
+        }
+        vertexPositions[i] = it->second;
+        positionTriangles[it->second].push_back(i / 3);
+    }
+    // normalisierte Dreiecks-Normale und Flächen der Quelldaten vorberechnen
+    std::vector<float> triangleNormals(triangleCount * 3);
+    std::vector<float> triangleAreas(triangleCount);
+    for (int t = 0; t < triangleCount; ++t) {
+        memcpy(&triangleNormals[t * 3], &pawnNormals[t * 9], 3 * sizeof(float));
+        normalize(&triangleNormals[t * 3]);
+        triangleAreas[t] = sourceTriangleArea(t);
+    }
+    float cosCreaseAngle = cosf(creaseAngle * (float)M_PI / 180.f);
+    // Vertices erzeugen und gleiche Vertices zusammenfassen
+    std::map<VertexKey, unsigned short> vertexIndices;
+    mesh.positions.clear();
+    mesh.normals.clear();
+    mesh.indices.clear();
+    for (int i = 0; i < PAWN_VERTICES_COUNT; ++i) {
+        float normal[3];
+        if (creaseAngle <= 0.f) {
+            // Normale unverändert übernehmen
+            memcpy(normal, &pawnNormals[i * 3], sizeof(normal));
+        } else {
+            // flächengewichtetes Mittel der Normalen aller angrenzenden Dreiecke bilden, die nicht
+            // stärker als der Knickwinkel abweichen
+            const float *ownNormal = &triangleNormals[(i / 3) * 3];
+            const std::vector<int> &triangles = positionTriangles[vertexPositions[i]];
+            normal[0] = normal[1] = normal[2] = 0.f;
+            for (size_t j = 0; j < triangles.size(); ++j) {
+                const float *n = &triangleNormals[triangles[j] * 3];
+                if (n[0] * ownNormal[0] + n[1] * ownNormal[1] + n[2] * ownNormal[2]
+                        >= cosCreaseAngle) {
+                    float area = triangleAreas[triangles[j]];
+                    normal[0] += n[0] * area;
+                    normal[1] += n[1] * area;
+                    normal[2] += n[2] * area;
+                }
+            }
+            // bei entarteten Dreiecken die eigene Normale verwenden
+            if (normalize(normal) == 0.f) {
+                memcpy(normal, ownNormal, sizeof(normal));
+            }
+        }
+        VertexKey key;
+        key.positionIndex = vertexPositions[i];
+        memcpy(key.normal, normal, sizeof(key.normal));
+        std::map<VertexKey, unsigned short>::iterator it = vertexIndices.find(key);
+        if (it == vertexIndices.end()) {
+            unsigned int index = mesh.positions.size() / 3;
+            if (index > MAX_INDEX) {
+                fprintf(stderr, "Model has more than %d vertices\n", MAX_INDEX + 1);
+                return false;
+            }
+            it = vertexIndices.insert(std::make_pair(key, (unsigned short)index)).first;
+            mesh.positions.insert(mesh.positions.end(), &pawnVertices[i * 3],
+                    &pawnVertices[i * 3 + 3]);
+            mesh.normals.insert(mesh.normals.end(), normal, normal + 3);
+        }
+        mesh.indices.push_back(it->second);
+    }
+    return true;
+}
+
+/**
+ * Vergleicht das indizierte Model mit den Quelldaten.
+ *
+ * Die Positionen müssen exakt übereinstimmen. Die Normalen müssen bei einem Knickwinkel von 0 Grad
+ * exakt übereinstimmen und dürfen sonst höchstens um den Knickwinkel von der Dreiecks-Normalen der
+ * Quelldaten abweichen.
+ *
+ * @param mesh Das zu prüfende Model.
+ * @param creaseAngle Knickwinkel in Grad, mit dem das Model erzeugt wurde.
+ * @return True, wenn das Model dieselben Dreiecke wie die Quelldaten beschreibt.
+ */
+static bool verifyIndexedMesh(const Mesh &mesh, float creaseAngle) {
+    if (mesh.indices.size() != PAWN_VERTICES_COUNT) {
+        fprintf(stderr, "Index count %u differs from source vertex count %d\n",
+                (unsigned int)mesh.indices.size(), PAWN_VERTICES_COUNT);
+        return false;
+    }
+    // kleine Toleranz für Rundungsfehler bei der Normalen-Mittelung
+    float cosCreaseAngle = cosf(creaseAngle * (float)M_PI / 180.f) - 1e-4f;
+    for (int i = 0; i < PAWN_VERTICES_COUNT; ++i) {
+        unsigned int index = mesh.indices[i];
+        if (index * 3 >= mesh.positions.size()) {
+            fprintf(stderr, "Index %u of vertex %d out of range\n", index, i);
+            return false;
+        }
+        if (memcmp(&mesh.positions[index * 3], &pawnVertices[i * 3], 3 * sizeof(float)) != 0) {
+            fprintf(stderr, "Position of vertex %d differs from source\n", i);
+            return false;
+        }
+        const float *normal = &mesh.normals[index * 3];
+        if (creaseAngle <= 0.f) {
+            if (memcmp(normal, &pawnNormals[i * 3], 3 * sizeof(float)) != 0) {
+                fprintf(stderr, "Normal of vertex %d differs from source\n", i);
+                return false;
+            }
+        } else {
+            float sourceNormal[3];
+            memcpy(sourceNormal, &pawnNormals[i * 3], sizeof(sourceNormal));
+            normalize(sourceNormal);
+            if (normal[0] * sourceNormal[0] + normal[1] * sourceNormal[1] + normal[2]
+                    * sourceNormal[2] < cosCreaseAngle) {
+                fprintf(stderr, "Normal of vertex %d exceeds crease angle\n", i);
+                return false;
+            }
+        }
+    }
+    return true;
+}
+
+/**
+ * Sammelt die Dreiecke einer Index-Liste als sortierte Liste von Positionen und Normalen. Damit
+ * lässt sich unabhängig von der Reihenfolge der Dreiecke und Vertices prüfen, ob zwei Index-Listen
+ * dieselbe Geometrie beschreiben.
+ *
+ * @param mesh Das Model.
+ * @param indices Die Indizes (jeweils drei pro Dreieck).
+ * @param triangles Die sortierten Dreiecke mit jeweils 18 Werten (Ausgabe).
+ */
+static void sortedTriangles(const Mesh &mesh, const std::vector<unsigned short> &indices,
+        std::vector<std::vector<float> > &triangles) {
+    triangles.clear();
+    for (size_t i = 0; i < indices.size(); i += 3) {
+        std::vector<float> triangle;
+        for (int j = 0; j < 3; ++j) {
+            triangle.insert(triangle.end(), &mesh.positions[indices[i + j] * 3],
+                    &mesh.positions[indices[i + j] * 3 + 3]);
+            triangle.insert(triangle.end(), &mesh.normals[indices[i + j] * 3],
+                    &mesh.normals[indices[i + j] * 3 + 3]);
+        }
+        triangles.push_back(triangle);
+    }
+    std::sort(triangles.begin(), triangles.end());
+}
+
+/**
+ * Quantisiert das Model.
+ *
+ * Die Positionen werden relativ zum Mittelpunkt der Bounding-Box mit einem einheitlichen Faktor auf
+ * den Wertebereich von GLshort abgebildet. Der Faktor ist für alle Achsen gleich, damit die
+ * Skalierung beim Rendern uniform bleibt und GL_RESCALE_NORMAL weiterhin ausreicht. Die Normalen
+ * werden auf GLbyte abgebildet.
+ *
+ * @param mesh Das zu quantisierende Model.
+ * @param quantizedMesh Das quantisierte Model inklusive der maximalen Quantisierungsfehler.
+ */
+static void quantizeMesh(const Mesh &mesh, QuantizedMesh &quantizedMesh) {
+    unsigned int vertexCount = mesh.positions.size() / 3;
+    // Bounding-Box bestimmen
+    float minimum[3] = { HUGE_VALF, HUGE_VALF, HUGE_VALF };
+    float maximum[3] = { -HUGE_VALF, -HUGE_VALF, -HUGE_VALF };
+    for (unsigned int i = 0; i < vertexCount; ++i) {
+        for (int j = 0; j < 3; ++j) {
+            minimum[j] = std::min(minimum[j], mesh.positions[i * 3 + j]);
+            maximum[j] = std::max(maximum[j], mesh.positions[i * 3 + j]);
+        }
+    }
+    float halfExtent = 0.f;
+    for (int j = 0; j < 3; ++j) {
+        quantizedMesh.offset[j] = (minimum[j] + maximum[j]) / 2.f;
+        halfExtent = std::max(halfExtent, (maximum[j] - minimum[j]) / 2.f);
+    }
+    quantizedMesh.scale = halfExtent / MAX_QUANTIZED_POSITION;
+    quantizedMesh.positions.resize(vertexCount * 3);
+    quantizedMesh.normals.resize(vertexCount * 3);
+    quantizedMesh.maxPositionError = 0.f;
+    quantizedMesh.maxNormalError = 0.f;
+    for (unsigned int i = 0; i < vertexCount; ++i) {
+        // Position quantisieren und Abstand zur Original-Position bestimmen
+        float positionError = 0.f;
+        for (int j = 0; j < 3; ++j) {
+            long value = lrintf((mesh.positions[i * 3 + j] - quantizedMesh.offset[j])
+                    / quantizedMesh.scale);
+            value = std::max(-MAX_QUANTIZED_POSITION, std::min(MAX_QUANTIZED_POSITION, value));
+            quantizedMesh.positions[i * 3 + j] = (short)value;
+            float d = value * quantizedMesh.scale + quantizedMesh.offset[j]
+                    - mesh.positions[i * 3 + j];
+            positionError += d * d;
+        }
+        quantizedMesh.maxPositionError = std::max(quantizedMesh.maxPositionError,
+                sqrtf(positionError));
+        // Normale quantisieren und den Winkel zur Original-Normalen bestimmen
+        // GL bildet einen Byte-Wert c auf (2c + 1) / 255 ab.
+        float normal[3];
+        for (int j = 0; j < 3; ++j) {
+            long value = lrintf((mesh.normals[i * 3 + j] * 255.f - 1.f) / 2.f);
+            value = std::max(-MAX_QUANTIZED_NORMAL - 1, std::min(MAX_QUANTIZED_NORMAL, value));
+            quantizedMesh.normals[i * 3 + j] = (signed char)value;
+            normal[j] = (2.f * value + 1.f) / 255.f;
+        }
+        normalize(normal);
+        float cosAngle = normal[0] * mesh.normals[i * 3] + normal[1] * mesh.normals[i * 3 + 1]
+                + normal[2] * mesh.normals[i * 3 + 2];
+        float angle = acosf(std::min(1.f, cosAngle)) * 180.f / (float)M_PI;
+        quantizedMesh.maxNormalError = std::max(quantizedMesh.maxNormalError, angle);
+    }
+}
+
+/**
+ * Erzeugt den Inhalt der Model-Datei (siehe jni/meshFile.h) aus dem quantisierten Model.
+ *
+ * @param mesh Das indizierte Model (für die Indizes).
+ * @param quantizedMesh Das quantisierte Model.
+ * @param data Inhalt der Model-Datei (Ausgabe).
+ */
+static void buildMeshFile(const Mesh &mesh, const QuantizedMesh &quantizedMesh,
+        std::vector<unsigned char> &data) {
+    // alle Detailstufen hintereinander in einen Index-Buffer legen
+    std::vector<unsigned short> indices = mesh.indices;
+    std::vector<MeshLevelOfDetail> levelsOfDetail;
+    MeshLevelOfDetail levelOfDetail = { 0, (int32_t)indices.size() };
+    levelsOfDetail.push_back(levelOfDetail);
+    for (size_t i = 0; i < mesh.levelsOfDetail.size(); ++i) {
+        levelOfDetail.firstIndex = indices.size();
+        levelOfDetail.indexCount = mesh.levelsOfDetail[i].size();
+        levelsOfDetail.push_back(levelOfDetail);
+        indices.insert(indices.end(), mesh.levelsOfDetail[i].begin(),
+                mesh.levelsOfDetail[i].end());
+    }
+    std::vector<MeshVertex> vertices(quantizedMesh.positions.size() / 3);
+    for (size_t i = 0; i < vertices.size(); ++i) {
+        memset(&vertices[i], 0, sizeof(MeshVertex));
+        for (int j = 0; j < 3; ++j) {
+            vertices[i].position[j] = quantizedMesh.positions[i * 3 + j];
+            vertices[i].normal[j] = quantizedMesh.normals[i * 3 + j];
+        }
+    }
+    MeshFileHeader header;
+    memset(&header, 0, sizeof(MeshFileHeader));
+    memcpy(header.magic, MESH_FILE_MAGIC, 4);
+    header.version = MESH_FILE_VERSION;
+    header.vertexCount = vertices.size();
+    header.indexCount = indices.size();
+    header.levelOfDetailCount = levelsOfDetail.size();
+    memcpy(header.positionOffset, quantizedMesh.offset, sizeof(header.positionOffset));
+    header.positionScale = quantizedMesh.scale;
+    // Abschnitte ohne Lücken hintereinander schreiben
+    const unsigned char *bytes = (const unsigned char*)&header;
+    data.assign(bytes, bytes + sizeof(MeshFileHeader));
+    bytes = (const unsigned char*)&levelsOfDetail[0];
+    data.insert(data.end(), bytes, bytes + levelsOfDetail.size() * sizeof(MeshLevelOfDetail));
+    bytes = (const unsigned char*)&vertices[0];
+    data.insert(data.end(), bytes, bytes + vertices.size() * sizeof(MeshVertex));
+    bytes = (const unsigned char*)&indices[0];
+    data.insert(data.end(), bytes, bytes + indices.size() * sizeof(unsigned short));
+}
+
+/**
+ * Schreibt die Model-Datei.
+ *
+ * @param data Inhalt der Model-Datei.
+ * @param fileName Name der Ausgabedatei.
+ * @return True, wenn die Datei geschrieben werden konnte.
+ */
+static bool writeMeshFile(const std::vector<unsigned char> &data, const char *fileName) {
+    FILE *file = fopen(fileName, "wb");
+    if (file == NULL) {
+        fprintf(stderr, "Could not open %s\n", fileName);
+        return false;
+    }
+    bool written = fwrite(&data[0], 1, data.size(), file) == data.size();
+    written = fclose(file) == 0 && written;
+    if (!written) {
+        fprintf(stderr, "Could not write %s\n", fileName);
+    }
+    return written;
+}
+
+/**
+ * Liest die geschriebene Model-Datei so, wie es der Loader zur Laufzeit tut (in den Speicher
+ * abgebildet und ohne Kopie), und prüft sie gegen das indizierte Model.
+ *
+ * Geprüft werden Kennung, Version, Größe der Abschnitte, Detailstufen und Indizes. Außerdem müssen
+ * die über Verschiebung und Skalierung zurückgerechneten Positionen innerhalb des
+ * Quantisierungsfehlers bei den Original-Positionen liegen.
+ *
+ * @param fileName Name der Model-Datei.
+ * @param mesh Das indizierte Model.
+ * @param quantizedMesh Das quantisierte Model (für den Quantisierungsfehler).
+ * @return True, wenn die Datei gültig ist und zum Model passt.
+ */
+static bool verifyMeshFile(const char *fileName, const Mesh &mesh,
+        const QuantizedMesh &quantizedMesh) {
+    int fileDescriptor = open(fileName, O_RDONLY);
+    if (fileDescriptor < 0) {
+        fprintf(stderr, "Could not open %s\n", fileName);
+        return false;
+    }
+    struct stat fileStatus;
+    fstat(fileDescriptor, &fileStatus);
+    size_t size = fileStatus.st_size;
+    void *data = mmap(NULL, size, PROT_READ, MAP_PRIVATE, fileDescriptor, 0);
+    close(fileDescriptor);
+    if (data == MAP_FAILED) {
+        fprintf(stderr, "Could not map %s\n", fileName);
+        return false;
+    }
+    bool valid = true;
+    const MeshFileHeader *header = (const MeshFileHeader*)data;
+    if (size < sizeof(MeshFileHeader) || memcmp(header->magic, MESH_FILE_MAGIC, 4) != 0
+            || header->version != MESH_FILE_VERSION) {
+        fprintf(stderr, "Mesh file: invalid header\n");
+        valid = false;
+    } else if (size != sizeof(MeshFileHeader)
+            + header->levelOfDetailCount * sizeof(MeshLevelOfDetail)
+            + header->vertexCount * sizeof(MeshVertex)
+            + header->indexCount * sizeof(unsigned short)) {
+        fprintf(stderr, "Mesh file: size %u does not match header\n", (unsigned int)size);
+        valid = false;
+    } else if (header->vertexCount != mesh.positions.size() / 3
+            || header->levelOfDetailCount != mesh.levelsOfDetail.size() + 1) {
+        fprintf(stderr, "Mesh file: counts do not match mesh\n");
+        valid = false;
+    }
+    if (valid) {
+        const MeshLevelOfDetail *levelsOfDetail = (const MeshLevelOfDetail*)(header + 1);
+        const MeshVertex *vertices =
+                (const MeshVertex*)(levelsOfDetail + header->levelOfDetailCount);
+        const unsigned short *indices = (const unsigned short*)(vertices + header->vertexCount);
+        // Detailstufen und Indizes
+        for (unsigned int i = 0; valid && i < header->levelOfDetailCount; ++i) {
+            const std::vector<unsigned short> &expected =
+                    i == 0 ? mesh.indices : mesh.levelsOfDetail[i - 1];
+            if (levelsOfDetail[i].indexCount != (int32_t)expected.size()
+                    || levelsOfDetail[i].firstIndex + levelsOfDetail[i].indexCount
+                            > (int32_t)header->indexCount
+                    || !std::equal(expected.begin(), expected.end(),
+                            indices + levelsOfDetail[i].firstIndex)) {
+                fprintf(stderr, "Mesh file: level of detail %u does not match mesh\n", i);
+                valid = false;
+            }
+        }
+        for (unsigned int i = 0; valid && i < header->indexCount; ++i) {
+            if (indices[i] >= header->vertexCount) {
+                fprintf(stderr, "Mesh file: index %u out of range\n", i);
+                valid = false;
+            }
+        }
+        // zurückgerechnete Positionen
+        float tolerance = quantizedMesh.maxPositionError * 1.001f + 1e-6f;
+        for (unsigned int i = 0; valid && i < header->vertexCount; ++i) {
+            float distanceSquared = 0.f;
+            for (int j = 0; j < 3; ++j) {
+                float difference = header->positionOffset[j]
+                        + header->positionScale * vertices[i].position[j]
+                        - mesh.positions[i * 3 + j];
+                distanceSquared += difference * difference;
+            }
+            if (sqrtf(distanceSquared) > tolerance) {
+                fprintf(stderr, "Mesh file: vertex %u does not match mesh\n", i);
+                valid = false;
+            }
+        }
+    }
+    munmap(data, size);
+    return valid;
+}
+
+/**
+ * Extrahiert das Profil der Spielfigur aus den Quelldaten. Die Spielfigur ist ein Rotationskörper
+ * um die z-Achse, deshalb liegt das Profil als Naht der Vertices mit dem Winkel 0 (y = 0, x >= 0)
+ * in den Quelldaten vor. Die Naht wird über die Kanten der Quell-Dreiecke vom unteren zum oberen
+ * Pol verfolgt.
+ *
+ * @param profile Das Profil als r-z-Paare von unten nach oben (Ausgabe).
+ * @return True, wenn die Naht ein zusammenhängender Linienzug von Pol zu Pol ist.
+ */
+static bool extractProfile(std::vector<float> &profile) {
+    std::map<PositionKey, unsigned int> seamIndices;
+    std::vector<int> seamVertices;
+    std::vector<std::set<unsigned int> > neighbours;
+    for (int t = 0; t < PAWN_VERTICES_COUNT / 3; ++t) {
+        int seam[3];
+        for (int j = 0; j < 3; ++j) {
+            int vertex = t * 3 + j;
+            seam[j] = -1;
+            if (fabsf(pawnVertices[vertex * 3 + 1]) < 1e-6f
+                    && pawnVertices[vertex * 3] > -1e-6f) {
+                PositionKey key = sourcePositionKey(vertex);
+                std::map<PositionKey, unsigned int>::iterator it = seamIndices.find(key);
+                if (it == seamIndices.end()) {
+                    it = seamIndices.insert(std::make_pair(key, seamVertices.size())).first;
+                    seamVertices.push_back(vertex);
+                    neighbours.push_back(std::set<unsigned int>());
+                }
+                seam[j] = it->second;
+            }
+        }
+        for (int a = 0; a < 3; ++a) {
+            for (int b = 0; b < 3; ++b) {
+                if (seam[a] >= 0 && seam[b] >= 0 && seam[a] != seam[b]) {
+                    neighbours[seam[a]].insert(seam[b]);
+                }
+            }
+        }
+    }
+    // am unteren Pol beginnen
+    int current = -1;
+    for (unsigned int i = 0; i < seamVertices.size(); ++i) {
+        const float *position = &pawnVertices[seamVertices[i] * 3];
+        if (neighbours[i].size() == 1 && (current < 0
+                || position[2] < pawnVertices[seamVertices[current] * 3 + 2])) {
+            current = i;
+        }
+    }
+    profile.clear();
+    int previous = -1;
+    while (current >= 0) {
+        const float *position = &pawnVertices[seamVertices[current] * 3];
+        profile.push_back(std::max(0.f, position[0]));
+        profile.push_back(position[2]);
+        if (neighbours[current].size() > 2) {
+            fprintf(stderr, "Profile branches at z = %g\n", position[2]);
+            return false;
+        }
+        int next = -1;
+        for (std::set<unsigned int>::iterator it = neighbours[current].begin();
+                it != neighbours[current].end(); ++it) {
+            if ((int)*it != previous) {
+                next = *it;
+            }
+        }
+        previous = current;
+        current = next;
+    }
+    if (profile.size() / 2 != seamVertices.size() || profile[0] > 1e-6f
+            || profile[profile.size() - 2] > 1e-6f) {
+        fprintf(stderr, "Profile is not a single line from pole to pole\n");
+        return false;
+    }
+    return true;
+}
+
+/**
+ * Schreibt das Profil der Spielfigur als Header-Datei.
+ *
+ * @param profile Das Profil als r-z-Paare.
+ * @param fileName Name der Ausgabedatei.
+ * @return True, wenn die Datei geschrieben werden konnte.
+ */
+static bool writeProfile(const std::vector<float> &profile, const char *fileName) {
+    FILE *file = fopen(fileName, "w");
+    if (file == NULL) {
+        fprintf(stderr, "Could not open %s\n", fileName);
+        return false;
+    }
+    fprintf(file, "/**\n"
+            " * @file pawnProfile.h\n"
+            " *\n"
+            " * @brief Profil der Spielfigur, aus dem sie als Rotationskörper erzeugt wird.\n"
+            " *\n"
+            " * @details Diese Datei wurde von tools/meshBuilder.cpp aus media/pawnSource.h erzeugt"
+            " und sollte\n"
+            " *      nicht von Hand bearbeitet werden.\n"
+            " */\n\n"
+            "#ifndef PAWN_PROFILE_H\n"
+            "#define PAWN_PROFILE_H\n\n");
+    fprintf(file, "/**\n * Anzahl der Profil-Punkte.\n */\n#define PAWN_PROFILE_POINT_COUNT %u\n\n",
+            (unsigned int)profile.size() / 2);
+    fprintf(file, "/**\n * Profil-Punkte (jeweils Radius und Höhe) vom unteren zum oberen Pol.\n"
+            " */\nstatic const float pawnProfile[] = {\n");
+    for (size_t i = 0; i < profile.size(); i += 2) {
+        // "%#g" sorgt auch bei ganzen Zahlen für einen Dezimalpunkt und damit für gültiges "f"
+        fprintf(file, "  %#.9gf, %#.9gf,\n", profile[i], profile[i + 1]);
+    }
+    fprintf(file, "};\n\n#endif\n");
+    return fclose(file) == 0;
+}
+
+/**
+ * Einstiegspunkt des Werkzeugs.
+ *
+ * @param argc Anzahl der Argumente.
+ * @param argv Argumente.
+ * @return 0 bei Erfolg, sonst 1.
+ */
+int main(int argc, char **argv) {
+    float creaseAngle = DEFAULT_CREASE_ANGLE;
+    int levelOfDetailCount = DEFAULT_LEVEL_OF_DETAIL_COUNT;
+    const char *outputFileName = NULL;
+    const char *profileFileName = NULL;
+    for (int i = 1; i < argc; ++i) {
+        if (strcmp(argv[i], "-c") == 0 && i + 1 < argc) {
+            creaseAngle = atof(argv[++i]);
+        } else if (strcmp(argv[i], "-l") == 0 && i + 1 < argc) {
+            levelOfDetailCount = std::max(1, atoi(argv[++i]));
+        } else if (strcmp(argv[i], "-p") == 0 && i + 1 < argc) {
+            profileFileName = argv[++i];
+        } else {
+            outputFileName = argv[i];
+        }
+    }
+    if (outputFileName == NULL) {
+        fprintf(stderr, "Usage: %s [-c creaseAngle] [-l levelOfDetailCount] [-p profile.h] "
+                "output.mesh\n", argv[0]);
+        return 1;
+    }
+    if (profileFileName != NULL) {
+        std::vector<float> profile;
+        if (!extractProfile(profile) || !writeProfile(profile, profileFileName)) {
+            return 1;
+        }
+        printf("Profile points:   %u\n", (unsigned int)profile.size() / 2);
+    }
+    Mesh mesh;
+    if (!buildIndexedMesh(creaseAngle, mesh)) {
+        return 1;
+    }
+    if (!verifyIndexedMesh(mesh, creaseAngle)) {
+        return 1;
+    }
+    buildLevelsOfDetail(mesh, levelOfDetailCount);
+    // Dreiecke und Vertices für den Vertex-Cache umsortieren und ACMR vorher und nachher messen
+    std::vector<float> cacheMissRatios;
+    std::vector<std::vector<std::vector<float> > > triangles(mesh.levelsOfDetail.size() + 1);
+    for (size_t i = 0; i < triangles.size(); ++i) {
+        const std::vector<unsigned short> &indices =
+                i == 0 ? mesh.indices : mesh.levelsOfDetail[i - 1];
+        cacheMissRatios.push_back(averageCacheMissRatio(indices, ACMR_CACHE_SIZE));
+        sortedTriangles(mesh, indices, triangles[i]);
+    }
+    optimizeVertexCache(mesh);
+    // Das Umsortieren darf die Geometrie nicht verändern
+    for (size_t i = 0; i < triangles.size(); ++i) {
+        std::vector<std::vector<float> > optimizedTriangles;
+        sortedTriangles(mesh, i == 0 ? mesh.indices : mesh.levelsOfDetail[i - 1],
+                optimizedTriangles);
+        if (optimizedTriangles != triangles[i]) {
+            fprintf(stderr, "Vertex cache optimization changed level of detail %u\n",
+                    (unsigned int)i);
+            return 1;
+        }
+    }
+    QuantizedMesh quantizedMesh;
+    quantizeMesh(mesh, quantizedMesh);
+    unsigned int vertexCount = mesh.positions.size() / 3;
+    printf("Source vertices:  %d\n", PAWN_VERTICES_COUNT);
+    printf("Unique vertices:  %u (%.2fx fewer vertex transforms)\n", vertexCount,
+            (float)PAWN_VERTICES_COUNT / vertexCount);
+    printf("Triangles:        %u (verified against source)\n",
+            (unsigned int)mesh.indices.size() / 3);
+    printf("Vertex size:      %u bytes (float source: %u bytes)\n",
+            (unsigned int)sizeof(MeshVertex), (unsigned int)(6 * sizeof(float)));
+    printf("Position error:   %g model units max (%g of the model height)\n",
+            quantizedMesh.maxPositionError, quantizedMesh.maxPositionError
+                    / (quantizedMesh.scale * MAX_QUANTIZED_POSITION * 2.f));
+    printf("Normal error:     %g degrees max\n", quantizedMesh.maxNormalError);
+    for (size_t i = 0; i < mesh.levelsOfDetail.size(); ++i) {
+        std::vector<bool> referenced(vertexCount, false);
+        unsigned int referencedCount = 0;
+        for (size_t j = 0; j < mesh.levelsOfDetail[i].size(); ++j) {
+            if (!referenced[mesh.levelsOfDetail[i][j]]) {
+                referenced[mesh.levelsOfDetail[i][j]] = true;
+                ++referencedCount;
+            }
+        }
+        printf("Level of detail %u: %u triangles, %u vertices\n", (unsigned int)i + 1,
+                (unsigned int)mesh.levelsOfDetail[i].size() / 3, referencedCount);
+    }
+    for (size_t i = 0; i < cacheMissRatios.size(); ++i) {
+        const std::vector<unsigned short> &indices =
+                i == 0 ? mesh.indices : mesh.levelsOfDetail[i - 1];
+        printf("ACMR level %u:     %.3f -> %.3f (FIFO cache, %d entries)\n", (unsigned int)i,
+                cacheMissRatios[i], averageCacheMissRatio(indices, ACMR_CACHE_SIZE),
+                ACMR_CACHE_SIZE);
+    }
+    std::vector<unsigned char> data;
+    buildMeshFile(mesh, quantizedMesh, data);
+    if (!writeMeshFile(data, outputFileName)) {
+        return 1;
+    }
+    if (!verifyMeshFile(outputFileName, mesh, quantizedMesh)) {
+        return 1;
+    }
+    printf("Mesh file:        %u bytes (verified by reading it back)\n",
+            (unsigned int)data.size());
+    return 0;
+}
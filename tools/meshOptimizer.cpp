@@ -0,0 +1,254 @@
+/**
+ * @file meshOptimizer.cpp
+ *
+ * @brief Sortiert die Dreiecke und Vertices eines Models für den Vertex-Cache der GPU um.
+ *
+ * @details Die Dreiecke jeder Detailstufe werden mit dem Verfahren von Tom Forsyth ("Linear-Speed
+ *      Vertex Cache Optimisation") so sortiert, dass möglichst viele Vertices eines Dreiecks noch
+ *      von den vorherigen Dreiecken im Post-Transform-Cache liegen. Anschließend werden die
+ *      Vertices in der Reihenfolge ihrer ersten Verwendung in der vollen Detailstufe abgelegt,
+ *      damit sie beim Zeichnen möglichst linear aus dem Speicher gelesen werden.
+ *
+ *      Als Maß dient die durchschnittliche Anzahl an Cache-Fehlern pro Dreieck (ACMR) bei einem
+ *      FIFO-Cache. Der beste erreichbare Wert liegt bei etwa 0,5, der schlechteste bei 3.
+ *
+ * @author Alexander Bertram
+ *
+ * @date 15.10.2026
+ */
+
+#include <math.h>
+
+#include <algorithm>
+
+#include "meshOptimizer.h"
+
+/**
+ * Größe des simulierten LRU-Caches, mit dem die Dreiecke bewertet werden.
+ */
+#define CACHE_SIZE 32
+
+/**
+ * Exponent, mit dem die Bewertung eines Vertex mit seiner Position im Cache abfällt.
+ */
+#define CACHE_DECAY_POWER 1.5f
+
+/**
+ * Bewertung der Vertices des zuletzt hinzugefügten Dreiecks. Sie ist etwas niedriger als die der
+ * folgenden Cache-Positionen, damit nicht immer wieder dieselben Vertices verwendet werden.
+ */
+#define LAST_TRIANGLE_SCORE 0.75f
+
+/**
+ * Faktor des Bonus für Vertices, die nur noch wenige Dreiecke haben.
+ */
+#define VALENCE_BOOST_SCALE 2.f
+
+/**
+ * Exponent des Bonus für Vertices, die nur noch wenige Dreiecke haben.
+ */
+#define VALENCE_BOOST_POWER 0.5f
+
+/**
+ * Bewertet einen Vertex anhand seiner Position im Cache und der Anzahl seiner noch nicht
+ * ausgegebenen Dreiecke.
+ *
+ * @param cachePosition Position im Cache oder -1, wenn der Vertex nicht im Cache liegt.
+ * @param remainingTriangles Anzahl der noch nicht ausgegebenen Dreiecke des Vertex.
+ * @return Bewertung des Vertex.
+ */
+static float vertexScore(int cachePosition, unsigned int remainingTriangles) {
+    if (remainingTriangles == 0) {
+        return -1.f;
+    }
+    float score = 0.f;
+    if (cachePosition >= 0) {
+        if (cachePosition < 3) {
+            score = LAST_TRIANGLE_SCORE;
+        } else {
+            score = powf(1.f - (cachePosition - 3) / (float)(CACHE_SIZE - 3), CACHE_DECAY_POWER);
+        }
+    }
+    // Vertices mit wenigen verbleibenden Dreiecken bevorzugen, damit keine einzelnen Dreiecke
+    // übrig bleiben, die später einen Cache-Fehler verursachen
+    return score + VALENCE_BOOST_SCALE * powf((float)remainingTriangles, -VALENCE_BOOST_POWER);
+}
+
+/**
+ * Sortiert die Dreiecke einer Index-Liste für den Vertex-Cache um.
+ *
+ * @param indices Die Indizes (jeweils drei pro Dreieck), werden in der neuen Reihenfolge abgelegt.
+ * @param vertexCount Anzahl der Vertices des Models.
+ */
+static void optimizeTriangleOrder(std::vector<unsigned short> &indices, unsigned int vertexCount) {
+    unsigned int triangleCount = indices.size() / 3;
+    if (triangleCount == 0) {
+        return;
+    }
+    // Dreiecke je Vertex sammeln
+    std::vector<unsigned int> remainingTriangles(vertexCount, 0);
+    for (size_t i = 0; i < indices.size(); ++i) {
+        ++remainingTriangles[indices[i]];
+    }
+    std::vector<unsigned int> firstTriangle(vertexCount + 1, 0);
+    for (unsigned int v = 0; v < vertexCount; ++v) {
+        firstTriangle[v + 1] = firstTriangle[v] + remainingTriangles[v];
+    }
+    std::vector<unsigned int> vertexTriangles(indices.size());
+    std::vector<unsigned int> fill(firstTriangle.begin(), firstTriangle.end() - 1);
+    for (size_t i = 0; i < indices.size(); ++i) {
+        vertexTriangles[fill[indices[i]]++] = i / 3;
+    }
+    // Bewertungen initialisieren
+    std::vector<int> cachePosition(vertexCount, -1);
+    std::vector<float> score(vertexCount);
+    for (unsigned int v = 0; v < vertexCount; ++v) {
+        score[v] = vertexScore(-1, remainingTriangles[v]);
+    }
+    std::vector<float> triangleScore(triangleCount);
+    for (unsigned int t = 0; t < triangleCount; ++t) {
+        triangleScore[t] = score[indices[t * 3]] + score[indices[t * 3 + 1]]
+                + score[indices[t * 3 + 2]];
+    }
+    std::vector<bool> triangleAdded(triangleCount, false);
+    std::vector<unsigned short> cache;
+    std::vector<unsigned short> optimized;
+    optimized.reserve(indices.size());
+    unsigned int nextUnaddedTriangle = 0;
+    for (unsigned int added = 0; added < triangleCount; ++added) {
+        // bestes Dreieck unter den Dreiecken der Vertices im Cache suchen
+        int bestTriangle = -1;
+        float bestScore = -1.f;
+        for (size_t c = 0; c < cache.size(); ++c) {
+            unsigned short v = cache[c];
+            for (unsigned int i = firstTriangle[v]; i < firstTriangle[v + 1]; ++i) {
+                unsigned int t = vertexTriangles[i];
+                if (!triangleAdded[t] && triangleScore[t] > bestScore) {
+                    bestScore = triangleScore[t];
+                    bestTriangle = t;
+                }
+            }
+        }
+        // Ist keines vorhanden (am Anfang oder nach einem abgeschlossenen Teil des Models), mit dem
+        // nächsten noch nicht ausgegebenen Dreieck weitermachen
+        if (bestTriangle < 0) {
+            while (triangleAdded[nextUnaddedTriangle]) {
+                ++nextUnaddedTriangle;
+            }
+            bestTriangle = nextUnaddedTriangle;
+        }
+        // Dreieck ausgeben und seine Vertices an den Anfang des Caches schieben
+        triangleAdded[bestTriangle] = true;
+        const unsigned short *triangle = &indices[bestTriangle * 3];
+        optimized.insert(optimized.end(), triangle, triangle + 3);
+        for (int j = 2; j >= 0; --j) {
+            unsigned short v = triangle[j];
+            --remainingTriangles[v];
+            std::vector<unsigned short>::iterator cached = std::find(cache.begin(), cache.end(), v);
+            if (cached != cache.end()) {
+                cache.erase(cached);
+            }
+            cache.insert(cache.begin(), v);
+        }
+        // Vertices, die aus dem Cache fallen, verlieren ihre Cache-Bewertung
+        while (cache.size() > CACHE_SIZE) {
+            cachePosition[cache.back()] = -1;
+            score[cache.back()] = vertexScore(-1, remainingTriangles[cache.back()]);
+            cache.pop_back();
+        }
+        // Bewertungen der Vertices im Cache und ihrer Dreiecke aktualisieren
+        for (size_t c = 0; c < cache.size(); ++c) {
+            cachePosition[cache[c]] = c;
+            score[cache[c]] = vertexScore(c, remainingTriangles[cache[c]]);
+        }
+        for (size_t c = 0; c < cache.size(); ++c) {
+            unsigned short v = cache[c];
+            for (unsigned int i = firstTriangle[v]; i < firstTriangle[v + 1]; ++i) {
+                unsigned int t = vertexTriangles[i];
+                triangleScore[t] = score[indices[t * 3]] + score[indices[t * 3 + 1]]
+                        + score[indices[t * 3 + 2]];
+            }
+        }
+    }
+    indices.swap(optimized);
+}
+
+/**
+ * Sortiert die Vertices in der Reihenfolge ihrer ersten Verwendung in der vollen Detailstufe um
+ * und passt die Indizes aller Detailstufen an.
+ *
+ * @param mesh Das Model.
+ */
+static void optimizeVertexOrder(Mesh &mesh) {
+    unsigned int vertexCount = mesh.positions.size() / 3;
+    std::vector<int> newIndex(vertexCount, -1);
+    unsigned int nextIndex = 0;
+    for (size_t i = 0; i < mesh.indices.size(); ++i) {
+        if (newIndex[mesh.indices[i]] < 0) {
+            newIndex[mesh.indices[i]] = nextIndex++;
+        }
+    }
+    // nicht verwendete Vertices (sollte es nicht geben) ans Ende legen
+    for (unsigned int v = 0; v < vertexCount; ++v) {
+        if (newIndex[v] < 0) {
+            newIndex[v] = nextIndex++;
+        }
+    }
+    std::vector<float> positions(mesh.positions.size());
+    std::vector<float> normals(mesh.normals.size());
+    for (unsigned int v = 0; v < vertexCount; ++v) {
+        std::copy(&mesh.positions[v * 3], &mesh.positions[v * 3 + 3], &positions[newIndex[v] * 3]);
+        std::copy(&mesh.normals[v * 3], &mesh.normals[v * 3 + 3], &normals[newIndex[v] * 3]);
+    }
+    mesh.positions.swap(positions);
+    mesh.normals.swap(normals);
+    for (size_t i = 0; i < mesh.indices.size(); ++i) {
+        mesh.indices[i] = newIndex[mesh.indices[i]];
+    }
+    for (size_t l = 0; l < mesh.levelsOfDetail.size(); ++l) {
+        for (size_t i = 0; i < mesh.levelsOfDetail[l].size(); ++i) {
+            mesh.levelsOfDetail[l][i] = newIndex[mesh.levelsOfDetail[l][i]];
+        }
+    }
+}
+
+/**
+ * Sortiert die Dreiecke aller Detailstufen für den Post-Transform-Cache und danach die Vertices
+ * für das lineare Lesen aus dem Speicher um. Die Geometrie bleibt dabei unverändert.
+ *
+ * @param mesh Das Model.
+ */
+void optimizeVertexCache(Mesh &mesh) {
+    unsigned int vertexCount = mesh.positions.size() / 3;
+    optimizeTriangleOrder(mesh.indices, vertexCount);
+    for (size_t l = 0; l < mesh.levelsOfDetail.size(); ++l) {
+        optimizeTriangleOrder(mesh.levelsOfDetail[l], vertexCount);
+    }
+    optimizeVertexOrder(mesh);
+}
+
+/**
+ * Berechnet die durchschnittliche Anzahl an Cache-Fehlern pro Dreieck (ACMR) einer Index-Liste
+ * bei einem FIFO-Cache, wie ihn die meisten mobilen GPUs verwenden.
+ *
+ * @param indices Die Indizes (jeweils drei pro Dreieck).
+ * @param cacheSize Anzahl der Einträge des Caches.
+ * @return Durchschnittliche Anzahl an Cache-Fehlern pro Dreieck.
+ */
+float averageCacheMissRatio(const std::vector<unsigned short> &indices, unsigned int cacheSize) {
+    if (indices.empty()) {
+        return 0.f;
+    }
+    std::vector<unsigned short> cache;
+    unsigned int misses = 0;
+    for (size_t i = 0; i < indices.size(); ++i) {
+        if (std::find(cache.begin(), cache.end(), indices[i]) == cache.end()) {
+            ++misses;
+            cache.push_back(indices[i]);
+            if (cache.size() > cacheSize) {
+                cache.erase(cache.begin());
+            }
+        }
+    }
+    return misses / (indices.size() / 3.f);
+}
@@ -0,0 +1,19 @@
+/**
+ * @file meshOptimizer.h
+ *
+ * @brief Schnittstelle zu meshOptimizer.cpp.
+ *
+ * @author Alexander Bertram
+ *
+ * @date 15.10.2026
+ */
+
+#ifndef MESH_OPTIMIZER_H
+#define MESH_OPTIMIZER_H
+
+#include "mesh.h"
+
+void optimizeVertexCache(Mesh &mesh);
+float averageCacheMissRatio(const std::vector<unsigned short> &indices, unsigned int cacheSize);
+
+#endif
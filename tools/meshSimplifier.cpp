@@ -0,0 +1,498 @@
+/**
+ * @file meshSimplifier.cpp
+ *
+ * @brief Erzeugt vereinfachte Detailstufen eines Models durch Kanten-Kollaps mit quadratischen
+ *      Fehlermetriken (Garland/Heckbert).
+ *
+ * @details Eine Kante wird kollabiert, indem einer ihrer beiden Endpunkte auf den anderen gezogen
+ *      wird. Dadurch entstehen keine neuen Vertices und alle Detailstufen können denselben
+ *      Vertex-Buffer verwenden, es unterscheiden sich nur die Indizes. Weil die Vertices an
+ *      Knickkanten mehrfach (mit unterschiedlichen Normalen) vorkommen, wird auf geschweißten
+ *      Positionen gearbeitet. Beim Umhängen eines Dreiecks wird jeweils der Vertex der
+ *      Ziel-Position gewählt, dessen Normale am besten passt.
+ *
+ *      Kollapse, die Dreiecke umklappen oder nicht-mannigfaltige Kanten erzeugen würden, werden
+ *      verworfen.
+ *
+ * @author Alexander Bertram
+ *
+ * @date 14.10.2026
+ */
+
+#include <math.h>
+#include <string.h>
+
+#include <map>
+#include <queue>
+#include <set>
+
+#include "meshSimplifier.h"
+
+/**
+ * Kleinster Kosinus des Winkels, um den sich die Normale eines Dreiecks bei einem Kollaps drehen
+ * darf. Größere Drehungen deuten auf ein umklappendes Dreieck hin.
+ */
+#define MIN_NORMAL_ROTATION_COSINE 0.3
+
+/**
+ * @brief Symmetrische 4x4-Fehlermatrix (Quadrik), von der nur die obere Hälfte gespeichert wird.
+ */
+typedef struct Quadric {
+    /**
+     * Elemente a11, a12, a13, a14, a22, a23, a24, a33, a34 und a44.
+     */
+    double data[10];
+} Quadric;
+
+/**
+ * @brief Möglicher Kanten-Kollaps.
+ */
+typedef struct Collapse {
+    /**
+     * Fehler, der durch den Kollaps entsteht.
+     */
+    double cost;
+    /**
+     * Position, die entfernt wird.
+     */
+    unsigned int from;
+    /**
+     * Position, auf die die entfernte Position gezogen wird.
+     */
+    unsigned int to;
+    /**
+     * Version der entfernten Position zum Zeitpunkt der Kosten-Berechnung.
+     */
+    unsigned int fromVersion;
+    /**
+     * Version der Ziel-Position zum Zeitpunkt der Kosten-Berechnung.
+     */
+    unsigned int toVersion;
+
+    /**
+     * Sortiert die Warteschlange so, dass der günstigste Kollaps zuerst entnommen wird.
+     */
+    bool operator<(const Collapse &other) const {
+        return cost > other.cost;
+    }
+} Collapse;
+
+/**
+ * @brief Zustand der Vereinfachung.
+ */
+typedef struct Simplifier {
+    /**
+     * Das zu vereinfachende Model.
+     */
+    const Mesh *mesh;
+    /**
+     * Geschweißte Positionen (jeweils x, y und z).
+     */
+    std::vector<float> positions;
+    /**
+     * Geschweißte Position jedes Vertex.
+     */
+    std::vector<unsigned int> vertexPositions;
+    /**
+     * Vertices jeder geschweißten Position.
+     */
+    std::vector<std::vector<unsigned short> > positionVertices;
+    /**
+     * Angrenzende Dreiecke jeder geschweißten Position (kann bereits entfernte Dreiecke enthalten).
+     */
+    std::vector<std::vector<unsigned int> > positionTriangles;
+    /**
+     * Fehlermatrix jeder geschweißten Position.
+     */
+    std::vector<Quadric> quadrics;
+    /**
+     * Version jeder geschweißten Position. Wird bei jeder Änderung der Umgebung erhöht und macht
+     * ältere Einträge in der Warteschlange ungültig.
+     */
+    std::vector<unsigned int> versions;
+    /**
+     * Flag pro geschweißter Position, das anzeigt, ob sie noch nicht entfernt wurde.
+     */
+    std::vector<bool> positionAlive;
+    /**
+     * Aktuelle Indizes (jeweils drei pro Dreieck).
+     */
+    std::vector<unsigned short> indices;
+    /**
+     * Flag pro Dreieck, das anzeigt, ob es noch nicht entfernt wurde.
+     */
+    std::vector<bool> triangleAlive;
+    /**
+     * Anzahl der noch vorhandenen Dreiecke.
+     */
+    unsigned int triangleCount;
+    /**
+     * Warteschlange der möglichen Kollapse.
+     */
+    std::priority_queue<Collapse> collapses;
+} Simplifier;
+
+/**
+ * Addiert die Fehlermatrix einer Ebene a*x + b*y + c*z + d = 0 zu einer Fehlermatrix.
+ *
+ * @param q Fehlermatrix, zu der addiert wird.
+ * @param plane Ebenen-Koeffizienten a, b, c und d.
+ * @param weight Gewicht der Ebene (Dreiecksfläche).
+ */
+static void addPlaneQuadric(Quadric &q, const double *plane, double weight) {
+    int k = 0;
+    for (int i = 0; i < 4; ++i) {
+        for (int j = i; j < 4; ++j) {
+            q.data[k++] += plane[i] * plane[j] * weight;
+        }
+    }
+}
+
+/**
+ * Berechnet den quadratischen Fehler eines Punktes bezüglich der Summe zweier Fehlermatrizen.
+ *
+ * @param a 1. Fehlermatrix.
+ * @param b 2. Fehlermatrix.
+ * @param p Punkt (x, y und z).
+ * @return Fehler.
+ */
+static double evaluateQuadrics(const Quadric &a, const Quadric &b, const float *p) {
+    double v[4] = { p[0], p[1], p[2], 1.0 };
+    double result = 0.0;
+    int k = 0;
+    for (int i = 0; i < 4; ++i) {
+        for (int j = i; j < 4; ++j, ++k) {
+            double value = (a.data[k] + b.data[k]) * v[i] * v[j];
+            result += i == j ? value : 2.0 * value;
+        }
+    }
+    return result;
+}
+
+/**
+ * Berechnet die (nicht normalisierte) Normale eines Dreiecks aus drei Punkten.
+ *
+ * @param a 1. Punkt.
+ * @param b 2. Punkt.
+ * @param c 3. Punkt.
+ * @param normal Normale, deren Länge der doppelten Dreiecksfläche entspricht.
+ */
+static void triangleNormal(const float *a, const float *b, const float *c, double *normal) {
+    double u[3] = { b[0] - a[0], b[1] - a[1], b[2] - a[2] };
+    double v[3] = { c[0] - a[0], c[1] - a[1], c[2] - a[2] };
+    normal[0] = u[1] * v[2] - u[2] * v[1];
+    normal[1] = u[2] * v[0] - u[0] * v[2];
+    normal[2] = u[0] * v[1] - u[1] * v[0];
+}
+
+/**
+ * Gibt die geschweißte Position einer Dreiecks-Ecke zurück.
+ *
+ * @param s Zustand der Vereinfachung.
+ * @param triangle Index des Dreiecks.
+ * @param corner Ecke (0 bis 2).
+ * @return Geschweißte Position.
+ */
+static unsigned int cornerPosition(const Simplifier &s, unsigned int triangle, int corner) {
+    return s.vertexPositions[s.indices[triangle * 3 + corner]];
+}
+
+/**
+ * Sammelt die benachbarten Positionen einer geschweißten Position.
+ *
+ * @param s Zustand der Vereinfachung.
+ * @param position Geschweißte Position.
+ * @param neighbours Benachbarte Positionen.
+ */
+static void collectNeighbours(const Simplifier &s, unsigned int position,
+        std::set<unsigned int> &neighbours) {
+    neighbours.clear();
+    const std::vector<unsigned int> &triangles = s.positionTriangles[position];
+    for (size_t i = 0; i < triangles.size(); ++i) {
+        if (!s.triangleAlive[triangles[i]]) {
+            continue;
+        }
+        for (int k = 0; k < 3; ++k) {
+            unsigned int p = cornerPosition(s, triangles[i], k);
+            if (p != position) {
+                neighbours.insert(p);
+            }
+        }
+    }
+}
+
+/**
+ * Legt die Kollapse aller Kanten einer geschweißten Position in die Warteschlange.
+ *
+ * @param s Zustand der Vereinfachung.
+ * @param position Geschweißte Position.
+ */
+static void pushCollapses(Simplifier &s, unsigned int position) {
+    std::set<unsigned int> neighbours;
+    collectNeighbours(s, position, neighbours);
+    for (std::set<unsigned int>::iterator it = neighbours.begin(); it != neighbours.end(); ++it) {
+        // beide Richtungen einreihen, damit die andere Richtung versucht werden kann, falls die
+        // günstigere verworfen wird
+        for (int direction = 0; direction < 2; ++direction) {
+            Collapse collapse;
+            collapse.from = direction == 0 ? position : *it;
+            collapse.to = direction == 0 ? *it : position;
+            collapse.cost = evaluateQuadrics(s.quadrics[collapse.from], s.quadrics[collapse.to],
+                    &s.positions[collapse.to * 3]);
+            collapse.fromVersion = s.versions[collapse.from];
+            collapse.toVersion = s.versions[collapse.to];
+            s.collapses.push(collapse);
+        }
+    }
+}
+
+/**
+ * Initialisiert den Zustand der Vereinfachung.
+ *
+ * @param mesh Das zu vereinfachende Model.
+ * @param s Zustand der Vereinfachung.
+ */
+static void initSimplifier(const Mesh &mesh, Simplifier &s) {
+    s.mesh = &mesh;
+    // Positionen schweißen
+    std::map<std::vector<float>, unsigned int> positionIndices;
+    unsigned int vertexCount = mesh.positions.size() / 3;
+    s.vertexPositions.resize(vertexCount);
+    for (unsigned int i = 0; i < vertexCount; ++i) {
+        std::vector<float> key(&mesh.positions[i * 3], &mesh.positions[i * 3 + 3]);
+        std::map<std::vector<float>, unsigned int>::iterator it = positionIndices.find(key);
+        if (it == positionIndices.end()) {
+            it = positionIndices.insert(std::make_pair(key, (unsigned int)s.positionVertices
+                    .size())).first;
+            s.positions.insert(s.positions.end(), key.begin(), key.end());
+            s.positionVertices.push_back(std::vector<unsigned short>());
+        }
+        s.vertexPositions[i] = it->second;
+        s.positionVertices[it->second].push_back(i);
+    }
+    unsigned int positionCount = s.positionVertices.size();
+    s.positionTriangles.resize(positionCount);
+    Quadric zero;
+    memset(&zero, 0, sizeof(zero));
+    s.quadrics.assign(positionCount, zero);
+    s.versions.assign(positionCount, 0);
+    s.positionAlive.assign(positionCount, true);
+    // Dreiecke übernehmen und Fehlermatrizen aus den Dreiecksebenen aufbauen
+    s.indices = mesh.indices;
+    s.triangleCount = mesh.indices.size() / 3;
+    s.triangleAlive.assign(s.triangleCount, true);
+    for (unsigned int t = 0; t < s.triangleCount; ++t) {
+        double normal[3];
+        triangleNormal(&s.positions[cornerPosition(s, t, 0) * 3],
+                &s.positions[cornerPosition(s, t, 1) * 3],
+                &s.positions[cornerPosition(s, t, 2) * 3], normal);
+        double length = sqrt(normal[0] * normal[0] + normal[1] * normal[1] + normal[2]
+                * normal[2]);
+        for (int k = 0; k < 3; ++k) {
+            s.positionTriangles[cornerPosition(s, t, k)].push_back(t);
+        }
+        if (length == 0.0) {
+            continue;
+        }
+        const float *p = &s.positions[cornerPosition(s, t, 0) * 3];
+        double plane[4] = { normal[0] / length, normal[1] / length, normal[2] / length, 0.0 };
+        plane[3] = -(plane[0] * p[0] + plane[1] * p[1] + plane[2] * p[2]);
+        for (int k = 0; k < 3; ++k) {
+            addPlaneQuadric(s.quadrics[cornerPosition(s, t, k)], plane, length / 2.0);
+        }
+    }
+    for (unsigned int p = 0; p < positionCount; ++p) {
+        pushCollapses(s, p);
+    }
+}
+
+/**
+ * Sucht an einer geschweißten Position den Vertex, dessen Normale der Normalen eines anderen
+ * Vertex am ähnlichsten ist.
+ *
+ * @param s Zustand der Vereinfachung.
+ * @param vertex Vertex, dessen Normale verglichen wird.
+ * @param position Geschweißte Position, an der gesucht wird.
+ * @return Der ähnlichste Vertex.
+ */
+static unsigned short matchingVertex(const Simplifier &s, unsigned short vertex,
+        unsigned int position) {
+    const float *normal = &s.mesh->normals[vertex * 3];
+    const std::vector<unsigned short> &candidates = s.positionVertices[position];
+    unsigned short result = candidates[0];
+    float bestCosine = -2.f;
+    for (size_t i = 0; i < candidates.size(); ++i) {
+        const float *n = &s.mesh->normals[candidates[i] * 3];
+        float cosine = n[0] * normal[0] + n[1] * normal[1] + n[2] * normal[2];
+        if (cosine > bestCosine) {
+            bestCosine = cosine;
+            result = candidates[i];
+        }
+    }
+    return result;
+}
+
+/**
+ * Prüft, ob ein Kollaps die Topologie erhält und kein Dreieck umklappt.
+ *
+ * @param s Zustand der Vereinfachung.
+ * @param collapse Der zu prüfende Kollaps.
+ * @return True, wenn der Kollaps ausgeführt werden darf.
+ */
+static bool isCollapseValid(const Simplifier &s, const Collapse &collapse) {
+    // Die Kante muss noch existieren und die beiden Endpunkte dürfen höchstens zwei gemeinsame
+    // Nachbarn haben, sonst entsteht eine nicht-mannigfaltige Kante.
+    std::set<unsigned int> fromNeighbours;
+    std::set<unsigned int> toNeighbours;
+    collectNeighbours(s, collapse.from, fromNeighbours);
+    collectNeighbours(s, collapse.to, toNeighbours);
+    if (fromNeighbours.find(collapse.to) == fromNeighbours.end()) {
+        return false;
+    }
+    int commonNeighbourCount = 0;
+    for (std::set<unsigned int>::iterator it = fromNeighbours.begin(); it != fromNeighbours.end();
+            ++it) {
+        if (toNeighbours.find(*it) != toNeighbours.end()) {
+            ++commonNeighbourCount;
+        }
+    }
+    if (commonNeighbourCount > 2) {
+        return false;
+    }
+    // Dreiecke, die erhalten bleiben, dürfen nicht umklappen oder entarten
+    const std::vector<unsigned int> &triangles = s.positionTriangles[collapse.from];
+    for (size_t i = 0; i < triangles.size(); ++i) {
+        unsigned int t = triangles[i];
+        if (!s.triangleAlive[t]) {
+            continue;
+        }
+        const float *oldCorners[3];
+        const float *newCorners[3];
+        bool containsTo = false;
+        for (int k = 0; k < 3; ++k) {
+            unsigned int p = cornerPosition(s, t, k);
+            containsTo |= p == collapse.to;
+            oldCorners[k] = &s.positions[p * 3];
+            newCorners[k] = &s.positions[(p == collapse.from ? collapse.to : p) * 3];
+        }
+        if (containsTo) {
+            continue;
+        }
+        double oldNormal[3];
+        double newNormal[3];
+        triangleNormal(oldCorners[0], oldCorners[1], oldCorners[2], oldNormal);
+        triangleNormal(newCorners[0], newCorners[1], newCorners[2], newNormal);
+        double oldLength = sqrt(oldNormal[0] * oldNormal[0] + oldNormal[1] * oldNormal[1]
+                + oldNormal[2] * oldNormal[2]);
+        double newLength = sqrt(newNormal[0] * newNormal[0] + newNormal[1] * newNormal[1]
+                + newNormal[2] * newNormal[2]);
+        if (newLength == 0.0) {
+            return false;
+        }
+        if (oldLength > 0.0 && (oldNormal[0] * newNormal[0] + oldNormal[1] * newNormal[1]
+                + oldNormal[2] * newNormal[2]) / (oldLength * newLength)
+                < MIN_NORMAL_ROTATION_COSINE) {
+            return false;
+        }
+    }
+    return true;
+}
+
+/**
+ * Führt einen Kollaps aus.
+ *
+ * @param s Zustand der Vereinfachung.
+ * @param collapse Der auszuführende Kollaps.
+ */
+static void applyCollapse(Simplifier &s, const Collapse &collapse) {
+    std::vector<unsigned int> &triangles = s.positionTriangles[collapse.from];
+    for (size_t i = 0; i < triangles.size(); ++i) {
+        unsigned int t = triangles[i];
+        if (!s.triangleAlive[t]) {
+            continue;
+        }
+        bool containsTo = false;
+        for (int k = 0; k < 3; ++k) {
+            containsTo |= cornerPosition(s, t, k) == collapse.to;
+        }
+        if (containsTo) {
+            // Dreiecke an der kollabierten Kante entarten und werden entfernt
+            s.triangleAlive[t] = false;
+            --s.triangleCount;
+            continue;
+        }
+        // übrige Dreiecke auf die Ziel-Position umhängen
+        for (int k = 0; k < 3; ++k) {
+            if (cornerPosition(s, t, k) == collapse.from) {
+                s.indices[t * 3 + k] = matchingVertex(s, s.indices[t * 3 + k], collapse.to);
+            }
+        }
+        s.positionTriangles[collapse.to].push_back(t);
+    }
+    triangles.clear();
+    // entfernte Dreiecke aus der Liste der Ziel-Position löschen
+    std::vector<unsigned int> &toTriangles = s.positionTriangles[collapse.to];
+    std::vector<unsigned int> aliveTriangles;
+    for (size_t i = 0; i < toTriangles.size(); ++i) {
+        if (s.triangleAlive[toTriangles[i]]) {
+            aliveTriangles.push_back(toTriangles[i]);
+        }
+    }
+    toTriangles.swap(aliveTriangles);
+    // Fehlermatrix übernehmen und Kosten der Kanten an der Ziel-Position neu berechnen
+    for (int k = 0; k < 10; ++k) {
+        s.quadrics[collapse.to].data[k] += s.quadrics[collapse.from].data[k];
+    }
+    s.positionAlive[collapse.from] = false;
+    ++s.versions[collapse.from];
+    ++s.versions[collapse.to];
+    pushCollapses(s, collapse.to);
+}
+
+/**
+ * Vereinfacht das Model, bis höchstens die gewünschte Anzahl von Dreiecken übrig ist oder kein
+ * gültiger Kollaps mehr möglich ist.
+ *
+ * @param s Zustand der Vereinfachung.
+ * @param targetTriangleCount Gewünschte Anzahl der Dreiecke.
+ */
+static void simplify(Simplifier &s, unsigned int targetTriangleCount) {
+    while (s.triangleCount > targetTriangleCount && !s.collapses.empty()) {
+        Collapse collapse = s.collapses.top();
+        s.collapses.pop();
+        // veraltete Einträge überspringen
+        if (!s.positionAlive[collapse.from] || !s.positionAlive[collapse.to]
+                || collapse.fromVersion != s.versions[collapse.from]
+                || collapse.toVersion != s.versions[collapse.to]) {
+            continue;
+        }
+        if (isCollapseValid(s, collapse)) {
+            applyCollapse(s, collapse);
+        }
+    }
+}
+
+/**
+ * Erzeugt vereinfachte Detailstufen eines Models. Jede Detailstufe hat höchstens halb so viele
+ * Dreiecke wie die vorherige und entsteht durch weiteres Vereinfachen der vorherigen.
+ *
+ * @param mesh Das Model. Die Indizes der erzeugten Detailstufen werden in levelsOfDetail abgelegt.
+ * @param levelOfDetailCount Anzahl der Detailstufen inklusive der vollen Detailstufe.
+ */
+void buildLevelsOfDetail(Mesh &mesh, int levelOfDetailCount) {
+    mesh.levelsOfDetail.clear();
+    Simplifier s;
+    initSimplifier(mesh, s);
+    unsigned int targetTriangleCount = mesh.indices.size() / 3;
+    for (int level = 1; level < levelOfDetailCount; ++level) {
+        targetTriangleCount /= 2;
+        simplify(s, targetTriangleCount);
+        std::vector<unsigned short> indices;
+        for (unsigned int t = 0; t < s.triangleAlive.size(); ++t) {
+            if (s.triangleAlive[t]) {
+                indices.insert(indices.end(), &s.indices[t * 3], &s.indices[t * 3 + 3]);
+            }
+        }
+        mesh.levelsOfDetail.push_back(indices);
+    }
+}
@@ -0,0 +1,18 @@
+/**
+ * @file meshSimplifier.h
+ *
+ * @brief Schnittstelle zu meshSimplifier.cpp.
+ *
+ * @author Alexander Bertram
+ *
+ * @date 14.10.2026
+ */
+
+#ifndef MESH_SIMPLIFIER_H
+#define MESH_SIMPLIFIER_H
+
+#include "mesh.h"
+
+void buildLevelsOfDetail(Mesh &mesh, int levelOfDetailCount);
+
+#endif
@@ -0,0 +1,187 @@
+/**
+ * @file pngBenchmark.cpp
+ *
+ * @brief Werkzeug, das das native Dekodieren der Texturen (jni/pngDecoder.cpp) auf dem
+ *      Entwicklungsrechner mit dem früheren Weg über Java vergleicht und prüft.
+ *
+ * @details Der frühere Weg wird nachgebildet: Dekodieren in eine Bitmap (hier mit libpng),
+ *      Bitmap.getPixels() in ein int-Array (ARGB), Umpacken in ein byte-Array (RGBA) in
+ *      Texture.loadTextureFromApk(), Kopie durch GetByteArrayElements() und zeilenweises
+ *      Spiegeln in Texture::create(). Für beide Wege werden die in Bild-Puffer geschriebenen Byte
+ *      und die durchschnittliche Dauer ausgegeben. Das Ergebnis von decodePng() muss Pixel für
+ *      Pixel dem gespiegelten Ergebnis von libpng entsprechen, sonst bricht das Werkzeug ab.
+ *
+ *      Die Zeiten enthalten weder den Overhead von JNI noch den der Dalvik-VM und sind deshalb
+ *      eine untere Grenze für den früheren Weg.
+ *
+ *      Das Werkzeug wird über "ant png-benchmark" gebaut und ausgeführt.
+ *
+ * @author Alexander Bertram
+ *
+ * @date 16.10.2026
+ */
+
+#include <png.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+
+#include <vector>
+
+#include "../jni/pngDecoder.h"
+
+/**
+ * Mindestdauer einer Messung in Sekunden.
+ */
+#define MIN_MEASUREMENT_TIME 0.25
+
+/**
+ * Gibt die aktuelle Zeit in Sekunden zurück.
+ *
+ * @return Zeit in Sekunden.
+ */
+static double currentTime() {
+    struct timespec time;
+    clock_gettime(CLOCK_MONOTONIC, &time);
+    return time.tv_sec + time.tv_nsec / 1e9;
+}
+
+/**
+ * Liest eine Datei vollständig ein.
+ *
+ * @param fileName Name der Datei.
+ * @param data Erhält den Inhalt.
+ * @return true, wenn die Datei gelesen wurde.
+ */
+static bool readFile(const char *fileName, std::vector<uint8_t> &data) {
+    FILE *file = fopen(fileName, "rb");
+    if (file == NULL) {
+        return false;
+    }
+    fseek(file, 0, SEEK_END);
+    data.resize(ftell(file));
+    fseek(file, 0, SEEK_SET);
+    bool read = data.empty() || fread(&data[0], data.size(), 1, file) == 1;
+    fclose(file);
+    return read;
+}
+
+/**
+ * Bildet den früheren Weg über Java nach.
+ *
+ * @param data Inhalt der PNG-Datei.
+ * @param pixels Erhält das Bild (RGBA, erste Zeile unten) wie mData in Texture::create().
+ * @param width Erhält die Breite.
+ * @param height Erhält die Höhe.
+ * @return In Bild-Puffer geschriebene Byte oder 0 bei Fehlern.
+ */
+static size_t decodeLikeJava(const std::vector<uint8_t> &data, std::vector<uint8_t> &pixels,
+        uint32_t &width, uint32_t &height) {
+    // BitmapFactory.decodeStream()
+    png_image image;
+    memset(&image, 0, sizeof(image));
+    image.version = PNG_IMAGE_VERSION;
+    if (!png_image_begin_read_from_memory(&image, &data[0], data.size())) {
+        return 0;
+    }
+    image.format = PNG_FORMAT_BGRA;
+    width = image.width;
+    height = image.height;
+    size_t pixelCount = (size_t)width * height;
+    std::vector<uint8_t> bitmap(pixelCount * 4);
+    if (!png_image_finish_read(&image, NULL, &bitmap[0], 0, NULL)) {
+        return 0;
+    }
+    // Bitmap.getPixels() in int[] (ARGB, auf dem Host Little Endian wie BGRA)
+    std::vector<uint32_t> argb(pixelCount);
+    memcpy(&argb[0], &bitmap[0], pixelCount * 4);
+    // Umpacken in byte[] (RGBA)
+    std::vector<uint8_t> bytes(pixelCount * 4);
+    for (size_t p = 0; p < pixelCount; ++p) {
+        uint32_t colour = argb[p];
+        bytes[p * 4] = (uint8_t)(colour >> 16);
+        bytes[p * 4 + 1] = (uint8_t)(colour >> 8);
+        bytes[p * 4 + 2] = (uint8_t)colour;
+        bytes[p * 4 + 3] = (uint8_t)(colour >> 24);
+    }
+    // GetByteArrayElements() (kopiert unter Dalvik)
+    std::vector<uint8_t> elements(bytes);
+    // zeilenweise gespiegelt nach mData kopieren
+    pixels.resize(pixelCount * 4);
+    size_t rowSize = (size_t)width * 4;
+    for (uint32_t r = 0; r < height; ++r) {
+        memcpy(&pixels[rowSize * r], &elements[rowSize * (height - 1 - r)], rowSize);
+    }
+    return 5 * pixelCount * 4;
+}
+
+/**
+ * Einstiegspunkt des Werkzeugs.
+ *
+ * @param argc Anzahl der Argumente.
+ * @param argv Argumente: PNG-Dateien.
+ * @return 0 bei Erfolg, sonst 1.
+ */
+int main(int argc, char **argv) {
+    if (argc < 2) {
+        fprintf(stderr, "Usage: %s file.png...\n", argv[0]);
+        return 1;
+    }
+    printf("%-24s %10s %12s %10s %12s\n", "file", "java bytes", "java [us]", "native b.",
+            "native [us]");
+    for (int i = 1; i < argc; ++i) {
+        std::vector<uint8_t> data;
+        if (!readFile(argv[i], data)) {
+            fprintf(stderr, "Could not read %s\n", argv[i]);
+            return 1;
+        }
+        // früherer Weg
+        std::vector<uint8_t> reference;
+        uint32_t width = 0;
+        uint32_t height = 0;
+        size_t javaBytes = 0;
+        int iterations = 0;
+        double start = currentTime();
+        double javaTime;
+        do {
+            javaBytes = decodeLikeJava(data, reference, width, height);
+            if (javaBytes == 0) {
+                fprintf(stderr, "libpng could not decode %s\n", argv[i]);
+                return 1;
+            }
+            ++iterations;
+            javaTime = currentTime() - start;
+        } while (javaTime < MIN_MEASUREMENT_TIME);
+        javaTime /= iterations;
+        // nativer Weg
+        uint8_t *pixels = NULL;
+        uint32_t nativeWidth = 0;
+        uint32_t nativeHeight = 0;
+        iterations = 0;
+        start = currentTime();
+        double nativeTime;
+        do {
+            delete[] pixels;
+            if (!decodePng(&data[0], data.size(), &nativeWidth, &nativeHeight, &pixels)) {
+                fprintf(stderr, "decodePng could not decode %s\n", argv[i]);
+                return 1;
+            }
+            ++iterations;
+            nativeTime = currentTime() - start;
+        } while (nativeTime < MIN_MEASUREMENT_TIME);
+        nativeTime /= iterations;
+        size_t nativeBytes = (size_t)nativeWidth * nativeHeight * 4;
+        printf("%-24s %10u %12.1f %10u %12.1f\n", argv[i], (unsigned int)javaBytes,
+                javaTime * 1e6, (unsigned int)nativeBytes, nativeTime * 1e6);
+        bool equal = nativeWidth == width && nativeHeight == height
+                && memcmp(pixels, &reference[0], nativeBytes) == 0;
+        delete[] pixels;
+        if (!equal) {
+            fprintf(stderr, "decodePng does not match libpng for %s\n", argv[i]);
+            return 1;
+        }
+    }
+    return 0;
+}
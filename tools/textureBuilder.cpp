@@ -0,0 +1,706 @@
+/**
+ * @file textureBuilder.cpp
+ *
+ * @brief Werkzeug, das aus den Feld-Texturen (PNG) einen ETC1-komprimierten Textur-Atlas erzeugt.
+ *
+ * @details Die Texturen werden wie zur Laufzeit in createTextureAtlas() (jni/textureAtlas.cpp) um
+ *      den Rand verkleinert und mit wiederholten Randtexeln in einem Raster angeordnet, vier
+ *      Kacheln mit 256 Texeln ergeben so einen Atlas mit 512x512 Texeln. Für den Atlas wird die
+ *      vollständige Mipmap-Kette wie in Texture::upload() (jni/Texture.cpp) berechnet.
+ *
+ *      Da ETC1 keinen Alpha-Kanal kennt, werden zwei KTX-Dateien (siehe jni/ktxFile.h)
+ *      geschrieben: eine mit den Farben und eine mit dem Alpha-Kanal, der dafür in alle drei
+ *      Farbkanäle kopiert wird. Die Bereiche der Kacheln werden als Schlüssel-Wert-Paar in der
+ *      Farb-Datei abgelegt.
+ *
+ *      Nach dem Schreiben werden beide Dateien wieder eingelesen, mit jni/etc1.cpp dekodiert und
+ *      Kachel für Kachel gegen die verkleinerten Quellbilder verglichen. Der Fehler der Farben
+ *      wird dabei mit dem Alpha-Wert des Quellbildes gewichtet, weil er beim Blending nur in diesem
+ *      Maß sichtbar wird.
+ *      Unterschreitet das Signal-Rausch-Verhältnis (PSNR) der Farben MIN_COLOR_PSNR oder das des
+ *      Alpha-Kanals MIN_ALPHA_PSNR, bricht das Werkzeug mit einem Fehler ab.
+ *
+ *      Zum Schluss werden Grafikspeicher und Vorbereitung des Hochladens mit den früheren vier
+ *      einzelnen RGBA-Texturen ohne Mipmaps verglichen: deren PNG-Dekodierung gegen das
+ *      Dekodieren der Ebenen in RGBA4444 (ohne ETC1-Unterstützung), die komprimierten Ebenen
+ *      werden ohne CPU-Arbeit direkt aus der abgebildeten Datei geladen. Weil die früheren
+ *      Texturen keine Mipmaps hatten, wird dafür die größte Stufe verglichen; die Mipmap-Kette
+ *      kommt mit einem Drittel hinzu und wird getrennt ausgegeben. Belegt die größte Stufe des
+ *      ETC1-Atlas nicht mindestens um MIN_MEMORY_REDUCTION weniger Grafikspeicher, bricht das
+ *      Werkzeug ab.
+ *
+ *      Das Werkzeug läuft auf dem Entwicklungsrechner (benötigt libpng) und wird über
+ *      "ant textures" gebaut und ausgeführt. Aufruf: textureBuilder [-p Randbreite] Farb-Datei
+ *      Alpha-Datei Textur...
+ *
+ * @author Alexander Bertram
+ *
+ * @date 16.10.2026
+ */
+
+#include <fcntl.h>
+#include <math.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+#include <unistd.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+
+#include <vector>
+
+#include <png.h>
+
+#include "../jni/etc1.h"
+#include "../jni/ktxFile.h"
+#include "etc1Encoder.h"
+
+/**
+ * Standard-Breite des Randes um jede Kachel (TEXTURE_ATLAS_PADDING in jni/constants.h).
+ */
+#define DEFAULT_PADDING 8
+/**
+ * Kleinstes zulässiges Signal-Rausch-Verhältnis der Farben in dB zwischen Quellbild und
+ * dekodierter Kachel.
+ */
+#define MIN_COLOR_PSNR 28.0
+/**
+ * Kleinstes zulässiges Signal-Rausch-Verhältnis des Alpha-Kanals in dB zwischen Quellbild und
+ * dekodierter Kachel.
+ */
+#define MIN_ALPHA_PSNR 40.0
+/**
+ * Geforderter Faktor, um den die größte Stufe des ETC1-Atlas weniger Grafikspeicher belegt als
+ * die früheren einzelnen RGBA-Texturen, die ebenfalls keine Mipmaps hatten.
+ */
+#define MIN_MEMORY_REDUCTION 4.0
+/**
+ * Anzahl der Wiederholungen beim Messen der Dekodierung.
+ */
+#define TIMING_REPEAT_COUNT 20
+
+/**
+ * @brief RGBA-Bild, zeilenweise von unten nach oben (wie von OpenGL erwartet).
+ */
+typedef struct Image {
+    /**
+     * Breite in Pixeln.
+     */
+    uint32_t width;
+    /**
+     * Höhe in Pixeln.
+     */
+    uint32_t height;
+    /**
+     * Pixel (jeweils R, G, B und A).
+     */
+    std::vector<uint8_t> pixels;
+} Image;
+
+/**
+ * Gibt die aktuelle Zeit in Sekunden zurück.
+ *
+ * @return Zeit in Sekunden.
+ */
+static double currentTime() {
+    struct timespec time;
+    clock_gettime(CLOCK_MONOTONIC, &time);
+    return time.tv_sec + time.tv_nsec / 1e9;
+}
+
+/**
+ * Liest ein PNG-Bild und wandelt es in RGBA um. Die Zeilen werden wie in Texture::create()
+ * vertikal gespiegelt.
+ *
+ * @param fileName Name der PNG-Datei.
+ * @param image Erhält das Bild.
+ * @return True, wenn das Bild gelesen werden konnte.
+ */
+static bool loadPng(const char *fileName, Image &image) {
+    png_image png;
+    memset(&png, 0, sizeof(png));
+    png.version = PNG_IMAGE_VERSION;
+    if (!png_image_begin_read_from_file(&png, fileName)) {
+        fprintf(stderr, "Could not read %s: %s\n", fileName, png.message);
+        return false;
+    }
+    png.format = PNG_FORMAT_RGBA;
+    image.width = png.width;
+    image.height = png.height;
+    image.pixels.resize(PNG_IMAGE_SIZE(png));
+    // negative Zeilenlänge: die letzte Zeile des PNG-Bildes wird zuerst abgelegt
+    if (!png_image_finish_read(&png, NULL, &image.pixels[0], -(png_int_32)(image.width * 4),
+            NULL)) {
+        fprintf(stderr, "Could not decode %s: %s\n", fileName, png.message);
+        return false;
+    }
+    return true;
+}
+
+/**
+ * Bestimmt die kleinste Zweierpotenz, die mindestens so groß wie der übergebene Wert ist.
+ *
+ * @param value Der Wert.
+ * @return Die kleinste Zweierpotenz größer oder gleich value.
+ */
+static uint32_t nextPowerOfTwo(uint32_t value) {
+    uint32_t result = 1;
+    while (result < value) {
+        result <<= 1;
+    }
+    return result;
+}
+
+/**
+ * Verkleinert ein Bild wie scaleTile() in jni/textureAtlas.cpp mit einem Box-Filter, die Farben
+ * mit dem Alpha-Wert gewichtet.
+ *
+ * @param source Das Bild.
+ * @param width Breite des verkleinerten Bildes.
+ * @param height Höhe des verkleinerten Bildes.
+ * @param destination Erhält das verkleinerte Bild.
+ */
+static void scaleImage(const Image &source, uint32_t width, uint32_t height, Image &destination) {
+    const float scaleX = (float)source.width / width;
+    const float scaleY = (float)source.height / height;
+    destination.width = width;
+    destination.height = height;
+    destination.pixels.resize(width * height * 4);
+    for (uint32_t y = 0; y < height; ++y) {
+        float top = y * scaleY;
+        float bottom = (y + 1) * scaleY;
+        for (uint32_t x = 0; x < width; ++x) {
+            float left = x * scaleX;
+            float right = (x + 1) * scaleX;
+            float color[3] = { 0.f, 0.f, 0.f };
+            float alpha = 0.f;
+            float weightSum = 0.f;
+            for (int row = (int)top; row < bottom && row < (int)source.height; ++row) {
+                float weightY = (row + 1 < bottom ? row + 1 : bottom) - (row > top ? row : top);
+                for (int column = (int)left; column < right && column < (int)source.width;
+                        ++column) {
+                    float weight = weightY * ((column + 1 < right ? column + 1 : right)
+                            - (column > left ? column : left));
+                    const uint8_t *texel = &source.pixels[(row * source.width + column) * 4];
+                    for (int c = 0; c < 3; ++c) {
+                        color[c] += weight * texel[3] * texel[c];
+                    }
+                    alpha += weight * texel[3];
+                    weightSum += weight;
+                }
+            }
+            uint8_t *result = &destination.pixels[(y * width + x) * 4];
+            for (int c = 0; c < 3; ++c) {
+                result[c] = alpha == 0.f ? 0 : (uint8_t)(color[c] / alpha + 0.5f);
+            }
+            result[3] = (uint8_t)(alpha / weightSum + 0.5f);
+        }
+    }
+}
+
+/**
+ * Ordnet die Kacheln wie createTextureAtlas() in einem Atlas an. Der Rand liegt innerhalb der
+ * Zellen, die Kacheln werden dafür verkleinert.
+ *
+ * @param sources Die Kacheln.
+ * @param padding Breite des Randes um jede Kachel in Texeln.
+ * @param atlas Erhält den Atlas.
+ * @param tiles Erhält die verkleinerten Kacheln.
+ * @param regions Erhält für jede Kachel offset und scale (vier Werte pro Kachel).
+ * @return True, wenn der Rand Platz für die Kacheln lässt.
+ */
+static bool buildAtlas(const std::vector<Image> &sources, uint32_t padding, Image &atlas,
+        std::vector<Image> &tiles, std::vector<float> &regions) {
+    uint32_t cellWidth = 0;
+    uint32_t cellHeight = 0;
+    for (size_t i = 0; i < sources.size(); ++i) {
+        cellWidth = sources[i].width > cellWidth ? sources[i].width : cellWidth;
+        cellHeight = sources[i].height > cellHeight ? sources[i].height : cellHeight;
+    }
+    if (cellWidth <= 2 * padding || cellHeight <= 2 * padding) {
+        fprintf(stderr, "Padding %u too large for %ux%u cells\n", padding, cellWidth,
+                cellHeight);
+        return false;
+    }
+    tiles.resize(sources.size());
+    for (size_t i = 0; i < sources.size(); ++i) {
+        scaleImage(sources[i], cellWidth - 2 * padding, cellHeight - 2 * padding, tiles[i]);
+    }
+    // Anzahl der Spalten mit der kleinsten Atlas-Fläche, bei gleicher Fläche die quadratischere
+    uint32_t tileCount = tiles.size();
+    uint32_t columnCount = 0;
+    atlas.width = 0;
+    atlas.height = 0;
+    for (uint32_t columns = 1; columns <= tileCount; ++columns) {
+        uint32_t rows = (tileCount + columns - 1) / columns;
+        uint32_t w = nextPowerOfTwo(columns * cellWidth);
+        uint32_t h = nextPowerOfTwo(rows * cellHeight);
+        uint32_t area = atlas.width * atlas.height;
+        bool smaller = w * h < area;
+        bool squarer = w * h == area && (w > h ? w - h : h - w)
+                < (atlas.width > atlas.height ? atlas.width - atlas.height
+                        : atlas.height - atlas.width);
+        if (columnCount == 0 || smaller || squarer) {
+            columnCount = columns;
+            atlas.width = w;
+            atlas.height = h;
+        }
+    }
+    atlas.pixels.assign(atlas.width * atlas.height * 4, 0);
+    regions.clear();
+    for (uint32_t i = 0; i < tileCount; ++i) {
+        const Image &tile = tiles[i];
+        int x = (i % columnCount) * cellWidth + padding;
+        int y = (i / columnCount) * cellHeight + padding;
+        // Kachel mit Rand kopieren, im Rand die nächstgelegenen Randtexel wiederholen
+        for (int row = -(int)padding; row < (int)(tile.height + padding); ++row) {
+            int tileRow = row < 0 ? 0 : (row >= (int)tile.height ? tile.height - 1 : row);
+            for (int column = -(int)padding; column < (int)(tile.width + padding); ++column) {
+                int tileColumn = column < 0 ? 0
+                        : (column >= (int)tile.width ? tile.width - 1 : column);
+                memcpy(&atlas.pixels[((y + row) * atlas.width + x + column) * 4],
+                        &tile.pixels[(tileRow * tile.width + tileColumn) * 4], 4);
+            }
+        }
+        regions.push_back((float)x / atlas.width);
+        regions.push_back((float)y / atlas.height);
+        regions.push_back((float)tile.width / atlas.width);
+        regions.push_back((float)tile.height / atlas.height);
+    }
+    return true;
+}
+
+/**
+ * Berechnet die nächstkleinere Mipmap-Stufe wie Texture::upload(): Mittelwert von 2x2 Texeln, die
+ * Farben mit dem Alpha-Wert gewichtet.
+ *
+ * @param source Die größere Stufe.
+ * @param destination Erhält die kleinere Stufe.
+ */
+static void downsample(const Image &source, Image &destination) {
+    destination.width = source.width > 1 ? source.width / 2 : 1;
+    destination.height = source.height > 1 ? source.height / 2 : 1;
+    destination.pixels.resize(destination.width * destination.height * 4);
+    for (uint32_t y = 0; y < destination.height; ++y) {
+        uint32_t rows[2] = { 2 * y, source.height > 1 ? 2 * y + 1 : 2 * y };
+        for (uint32_t x = 0; x < destination.width; ++x) {
+            uint32_t columns[2] = { 2 * x, source.width > 1 ? 2 * x + 1 : 2 * x };
+            uint32_t color[3] = { 0, 0, 0 };
+            uint32_t alpha = 0;
+            for (int i = 0; i < 4; ++i) {
+                const uint8_t *texel =
+                        &source.pixels[(rows[i / 2] * source.width + columns[i % 2]) * 4];
+                for (int c = 0; c < 3; ++c) {
+                    color[c] += texel[c] * texel[3];
+                }
+                alpha += texel[3];
+            }
+            uint8_t *result = &destination.pixels[(y * destination.width + x) * 4];
+            for (int c = 0; c < 3; ++c) {
+                result[c] = alpha == 0 ? 0 : (color[c] + alpha / 2) / alpha;
+            }
+            result[3] = (alpha + 2) / 4;
+        }
+    }
+}
+
+/**
+ * Hängt einen 32-Bit-Wert (Little-Endian) an.
+ *
+ * @param data Die Daten.
+ * @param value Der Wert.
+ */
+static void appendUint32(std::vector<uint8_t> &data, uint32_t value) {
+    for (int i = 0; i < 4; ++i) {
+        data.push_back(value >> (8 * i));
+    }
+}
+
+/**
+ * Erzeugt den Inhalt einer KTX-Datei aus den Mipmap-Stufen.
+ *
+ * @param levels Die Mipmap-Stufen, beginnend mit der größten.
+ * @param alphaPlane True, wenn der Alpha-Kanal statt der Farben komprimiert werden soll.
+ * @param regions Bereiche der Kacheln, werden nur abgelegt, wenn nicht leer.
+ * @param data Erhält den Inhalt der Datei.
+ */
+static void buildKtxFile(const std::vector<Image> &levels, bool alphaPlane,
+        const std::vector<float> &regions, std::vector<uint8_t> &data) {
+    // Schlüssel-Wert-Paare
+    std::vector<uint8_t> keyValueData;
+    if (!regions.empty()) {
+        const char *key = KTX_ATLAS_REGIONS_KEY;
+        uint32_t size = strlen(key) + 1 + regions.size() * sizeof(float);
+        appendUint32(keyValueData, size);
+        keyValueData.insert(keyValueData.end(), key, key + strlen(key) + 1);
+        const uint8_t *value = (const uint8_t*)&regions[0];
+        keyValueData.insert(keyValueData.end(), value, value + regions.size() * sizeof(float));
+        while (keyValueData.size() % 4 != 0) {
+            keyValueData.push_back(0);
+        }
+    }
+    KtxFileHeader header;
+    memset(&header, 0, sizeof(header));
+    memcpy(header.identifier, KTX_FILE_IDENTIFIER, KTX_FILE_IDENTIFIER_LENGTH);
+    header.endianness = KTX_FILE_ENDIANNESS;
+    header.glTypeSize = 1;
+    header.glInternalFormat = KTX_ETC1_RGB8;
+    header.glBaseInternalFormat = KTX_RGB;
+    header.pixelWidth = levels[0].width;
+    header.pixelHeight = levels[0].height;
+    header.numberOfFaces = 1;
+    header.numberOfMipmapLevels = levels.size();
+    header.bytesOfKeyValueData = keyValueData.size();
+    data.assign((const uint8_t*)&header, (const uint8_t*)&header + sizeof(header));
+    data.insert(data.end(), keyValueData.begin(), keyValueData.end());
+    for (size_t i = 0; i < levels.size(); ++i) {
+        const Image &level = levels[i];
+        Image source = level;
+        if (alphaPlane) {
+            // Alpha-Kanal in alle Farbkanäle kopieren
+            for (size_t p = 0; p < source.pixels.size(); p += 4) {
+                source.pixels[p] = source.pixels[p + 1] = source.pixels[p + 2] =
+                        source.pixels[p + 3];
+            }
+        }
+        uint32_t size = etc1ImageSize(level.width, level.height);
+        appendUint32(data, size);
+        size_t offset = data.size();
+        data.resize(offset + size);
+        encodeEtc1Image(&source.pixels[0], level.width, level.height, &data[offset]);
+    }
+}
+
+/**
+ * Schreibt eine Datei.
+ *
+ * @param data Inhalt der Datei.
+ * @param fileName Name der Ausgabedatei.
+ * @return True, wenn die Datei geschrieben werden konnte.
+ */
+static bool writeFile(const std::vector<uint8_t> &data, const char *fileName) {
+    FILE *file = fopen(fileName, "wb");
+    if (file == NULL) {
+        fprintf(stderr, "Could not open %s\n", fileName);
+        return false;
+    }
+    bool written = fwrite(&data[0], 1, data.size(), file) == data.size();
+    written = fclose(file) == 0 && written;
+    if (!written) {
+        fprintf(stderr, "Could not write %s\n", fileName);
+    }
+    return written;
+}
+
+/**
+ * Liest eine KTX-Datei so, wie es der Loader zur Laufzeit tut (in den Speicher abgebildet), prüft
+ * den Header und die Größen der Stufen und dekodiert die größte Stufe.
+ *
+ * @param fileName Name der KTX-Datei.
+ * @param width Erwartete Breite.
+ * @param height Erwartete Höhe.
+ * @param levelCount Erwartete Anzahl der Mipmap-Stufen.
+ * @param image Erhält die dekodierte größte Stufe (Alpha ist 255).
+ * @param regions Erhält die Bereiche der Kacheln, falls vorhanden.
+ * @return True, wenn die Datei gültig ist.
+ */
+static bool readKtxFile(const char *fileName, uint32_t width, uint32_t height,
+        uint32_t levelCount, Image &image, std::vector<float> &regions) {
+    int fileDescriptor = open(fileName, O_RDONLY);
+    if (fileDescriptor < 0) {
+        fprintf(stderr, "Could not open %s\n", fileName);
+        return false;
+    }
+    struct stat fileStatus;
+    fstat(fileDescriptor, &fileStatus);
+    size_t size = fileStatus.st_size;
+    void *data = mmap(NULL, size, PROT_READ, MAP_PRIVATE, fileDescriptor, 0);
+    close(fileDescriptor);
+    if (data == MAP_FAILED) {
+        fprintf(stderr, "Could not map %s\n", fileName);
+        return false;
+    }
+    bool valid = true;
+    const KtxFileHeader *header = (const KtxFileHeader*)data;
+    if (size < sizeof(KtxFileHeader)
+            || memcmp(header->identifier, KTX_FILE_IDENTIFIER, KTX_FILE_IDENTIFIER_LENGTH) != 0
+            || header->endianness != KTX_FILE_ENDIANNESS
+            || header->glInternalFormat != KTX_ETC1_RGB8 || header->pixelWidth != width
+            || header->pixelHeight != height || header->numberOfMipmapLevels != levelCount
+            || header->bytesOfKeyValueData > size - sizeof(KtxFileHeader)) {
+        fprintf(stderr, "%s: invalid header\n", fileName);
+        valid = false;
+    }
+    // Schlüssel-Wert-Paare
+    const uint8_t *bytes = (const uint8_t*)data + sizeof(KtxFileHeader);
+    const uint8_t *end = valid ? bytes + header->bytesOfKeyValueData : bytes;
+    regions.clear();
+    while (bytes + 4 <= end) {
+        uint32_t pairSize = *(const uint32_t*)bytes;
+        const char *key = (const char*)bytes + 4;
+        size_t keySize = strlen(key) + 1;
+        if (strcmp(key, KTX_ATLAS_REGIONS_KEY) == 0) {
+            const float *values = (const float*)(key + keySize);
+            regions.assign(values, values + (pairSize - keySize) / sizeof(float));
+        }
+        bytes += 4 + ((pairSize + 3) & ~3u);
+    }
+    // Stufen
+    uint32_t levelWidth = width;
+    uint32_t levelHeight = height;
+    for (uint32_t i = 0; valid && i < levelCount; ++i) {
+        uint32_t expectedSize = etc1ImageSize(levelWidth, levelHeight);
+        if (bytes + 4 > (const uint8_t*)data + size || *(const uint32_t*)bytes != expectedSize
+                || bytes + 4 + expectedSize > (const uint8_t*)data + size) {
+            fprintf(stderr, "%s: level %u has an invalid size\n", fileName, i);
+            valid = false;
+            break;
+        }
+        if (i == 0) {
+            image.width = width;
+            image.height = height;
+            image.pixels.assign(width * height * 4, 255);
+            decodeEtc1Image(bytes + 4, width, height, &image.pixels[0]);
+        }
+        bytes += 4 + expectedSize;
+        levelWidth = levelWidth > 1 ? levelWidth / 2 : 1;
+        levelHeight = levelHeight > 1 ? levelHeight / 2 : 1;
+    }
+    if (valid && bytes != (const uint8_t*)data + size) {
+        fprintf(stderr, "%s: size %u does not match header\n", fileName, (unsigned int)size);
+        valid = false;
+    }
+    munmap(data, size);
+    return valid;
+}
+
+/**
+ * Berechnet das Signal-Rausch-Verhältnis aus einem mittleren quadratischen Fehler.
+ *
+ * @param squaredError Summe der quadratischen Fehler.
+ * @param count Anzahl der Werte.
+ * @return PSNR in dB (unendlich bei fehlerfreien Werten).
+ */
+static double peakSignalToNoiseRatio(double squaredError, double count) {
+    return count == 0 || squaredError == 0 ? INFINITY
+            : 10.0 * log10(255.0 * 255.0 / (squaredError / count));
+}
+
+/**
+ * Vergleicht die dekodierten Kacheln gegen die Quellbilder.
+ *
+ * @param tiles Die Quellbilder.
+ * @param colorPlane Der dekodierte Farb-Atlas.
+ * @param alphaPlane Der dekodierte Alpha-Atlas (Alpha im Rot-Kanal).
+ * @param regions Bereiche der Kacheln aus der Farb-Datei.
+ * @param fileNames Namen der Quellbilder (für die Ausgabe).
+ * @return True, wenn alle Kacheln MIN_COLOR_PSNR und MIN_ALPHA_PSNR erreichen.
+ */
+static bool verifyTiles(const std::vector<Image> &tiles, const Image &colorPlane,
+        const Image &alphaPlane, const std::vector<float> &regions, char **fileNames) {
+    if (regions.size() != tiles.size() * 4) {
+        fprintf(stderr, "Atlas regions missing or incomplete\n");
+        return false;
+    }
+    bool valid = true;
+    for (size_t i = 0; i < tiles.size(); ++i) {
+        const Image &tile = tiles[i];
+        uint32_t x0 = (uint32_t)(regions[i * 4] * colorPlane.width + 0.5f);
+        uint32_t y0 = (uint32_t)(regions[i * 4 + 1] * colorPlane.height + 0.5f);
+        double colorError = 0.0;
+        double colorCount = 0.0;
+        double alphaError = 0.0;
+        for (uint32_t y = 0; y < tile.height; ++y) {
+            for (uint32_t x = 0; x < tile.width; ++x) {
+                const uint8_t *source = &tile.pixels[(y * tile.width + x) * 4];
+                size_t offset = ((y0 + y) * colorPlane.width + x0 + x) * 4;
+                const uint8_t *color = &colorPlane.pixels[offset];
+                double d = alphaPlane.pixels[offset] - source[3];
+                alphaError += d * d;
+                // die Farbe ist nur im Maß ihres Alpha-Wertes sichtbar
+                double weight = source[3] / 255.0;
+                for (int c = 0; c < 3; ++c) {
+                    d = color[c] - source[c];
+                    colorError += weight * d * d;
+                }
+                colorCount += 3.0 * weight;
+            }
+        }
+        double colorPsnr = peakSignalToNoiseRatio(colorError, colorCount);
+        double alphaPsnr = peakSignalToNoiseRatio(alphaError, tile.width * tile.height);
+        printf("%-24s colour %.1f dB, alpha %.1f dB\n", fileNames[i], colorPsnr, alphaPsnr);
+        if (colorPsnr < MIN_COLOR_PSNR || alphaPsnr < MIN_ALPHA_PSNR) {
+            fprintf(stderr, "%s: decoded tile below %.0f/%.0f dB\n", fileNames[i],
+                    MIN_COLOR_PSNR, MIN_ALPHA_PSNR);
+            valid = false;
+        }
+    }
+    return valid;
+}
+
+/**
+ * Sucht die Stufen in einer mit buildKtxFile() erzeugten KTX-Datei.
+ *
+ * @param data Inhalt der Datei.
+ * @param levels Erhält die komprimierten Daten jeder Stufe.
+ */
+static void findKtxLevels(const std::vector<uint8_t> &data, std::vector<const uint8_t*> &levels) {
+    const KtxFileHeader *header = (const KtxFileHeader*)&data[0];
+    const uint8_t *bytes = &data[0] + sizeof(KtxFileHeader) + header->bytesOfKeyValueData;
+    levels.clear();
+    for (uint32_t i = 0; i < header->numberOfMipmapLevels; ++i) {
+        levels.push_back(bytes + 4);
+        bytes += 4 + *(const uint32_t*)bytes;
+    }
+}
+
+/**
+ * Misst, wie lange das Laden ohne ETC1-Unterstützung auf der CPU braucht: Dekodieren beider
+ * Ebenen und Packen in RGBA4444 wie uploadDecodedLevels() in jni/ktxTexture.cpp.
+ *
+ * @param colorData Inhalt der Farb-Datei.
+ * @param alphaData Inhalt der Alpha-Datei.
+ * @return Durchschnittliche Dauer in Sekunden.
+ */
+static double measureRgba4444Decoding(const std::vector<uint8_t> &colorData,
+        const std::vector<uint8_t> &alphaData) {
+    std::vector<const uint8_t*> colorLevels;
+    std::vector<const uint8_t*> alphaLevels;
+    findKtxLevels(colorData, colorLevels);
+    findKtxLevels(alphaData, alphaLevels);
+    const KtxFileHeader *header = (const KtxFileHeader*)&colorData[0];
+    std::vector<uint8_t> color(header->pixelWidth * header->pixelHeight * 4);
+    std::vector<uint8_t> alpha(color.size());
+    std::vector<uint16_t> packed(header->pixelWidth * header->pixelHeight);
+    double start = currentTime();
+    for (int repeat = 0; repeat < TIMING_REPEAT_COUNT; ++repeat) {
+        uint32_t width = header->pixelWidth;
+        uint32_t height = header->pixelHeight;
+        for (size_t level = 0; level < colorLevels.size(); ++level) {
+            decodeEtc1Image(colorLevels[level], width, height, &color[0]);
+            decodeEtc1Image(alphaLevels[level], width, height, &alpha[0]);
+            for (uint32_t i = 0; i < width * height; ++i) {
+                const uint8_t *c = &color[i * 4];
+                packed[i] = (uint16_t)(((c[0] * 15 + 127) / 255) << 12
+                        | ((c[1] * 15 + 127) / 255) << 8 | ((c[2] * 15 + 127) / 255) << 4
+                        | (alpha[i * 4 + 1] * 15 + 127) / 255);
+            }
+            width = width > 1 ? width / 2 : 1;
+            height = height > 1 ? height / 2 : 1;
+        }
+    }
+    return (currentTime() - start) / TIMING_REPEAT_COUNT;
+}
+
+/**
+ * Erzeugt den komprimierten Textur-Atlas.
+ *
+ * @param argc Anzahl der Argumente.
+ * @param argv Argumente.
+ * @return 0 bei Erfolg, sonst 1.
+ */
+int main(int argc, char **argv) {
+    uint32_t padding = DEFAULT_PADDING;
+    int first = 1;
+    if (argc > 2 && strcmp(argv[1], "-p") == 0) {
+        padding = atoi(argv[2]);
+        first = 3;
+    }
+    if (argc - first < 3) {
+        fprintf(stderr, "Usage: %s [-p padding] colour.ktx alpha.ktx tile.png...\n", argv[0]);
+        return 1;
+    }
+    const char *colorFileName = argv[first];
+    const char *alphaFileName = argv[first + 1];
+    char **tileFileNames = argv + first + 2;
+    std::vector<Image> sources(argc - first - 2);
+    for (size_t i = 0; i < sources.size(); ++i) {
+        if (!loadPng(tileFileNames[i], sources[i])) {
+            return 1;
+        }
+    }
+    // Atlas und Mipmap-Kette
+    std::vector<Image> levels(1);
+    std::vector<Image> tiles;
+    std::vector<float> regions;
+    if (!buildAtlas(sources, padding, levels[0], tiles, regions)) {
+        return 1;
+    }
+    while (levels.back().width > 1 || levels.back().height > 1) {
+        Image level;
+        downsample(levels.back(), level);
+        levels.push_back(level);
+    }
+    // Farben und Alpha-Kanal komprimieren und schreiben
+    std::vector<uint8_t> colorData;
+    std::vector<uint8_t> alphaData;
+    buildKtxFile(levels, false, regions, colorData);
+    buildKtxFile(levels, true, std::vector<float>(), alphaData);
+    if (!writeFile(colorData, colorFileName) || !writeFile(alphaData, alphaFileName)) {
+        return 1;
+    }
+    // Dateien wieder einlesen und gegen die Quellbilder prüfen
+    Image colorPlane;
+    Image alphaPlane;
+    std::vector<float> storedRegions;
+    std::vector<float> alphaRegions;
+    uint32_t width = levels[0].width;
+    uint32_t height = levels[0].height;
+    if (!readKtxFile(colorFileName, width, height, levels.size(), colorPlane, storedRegions)
+            || !readKtxFile(alphaFileName, width, height, levels.size(), alphaPlane,
+                    alphaRegions)) {
+        return 1;
+    }
+    if (storedRegions != regions) {
+        fprintf(stderr, "Atlas regions do not match\n");
+        return 1;
+    }
+    if (!verifyTiles(tiles, colorPlane, alphaPlane, regions, tileFileNames)) {
+        return 1;
+    }
+    // frühere einzelne RGBA-Texturen ohne Mipmaps, vor dem Hochladen aus den PNG-Dateien dekodiert
+    uint32_t baselineSize = 0;
+    for (size_t i = 0; i < sources.size(); ++i) {
+        baselineSize += sources[i].width * sources[i].height * 4;
+    }
+    double start = currentTime();
+    for (int repeat = 0; repeat < TIMING_REPEAT_COUNT; ++repeat) {
+        for (size_t i = 0; i < sources.size(); ++i) {
+            Image source;
+            loadPng(tileFileNames[i], source);
+        }
+    }
+    double baselineTime = (currentTime() - start) / TIMING_REPEAT_COUNT;
+    // Grafikspeicher mit ETC1 (Farb- und Alpha-Ebene) und RGBA4444, größte Stufe und alle Stufen
+    uint32_t compressedBaseSize = 2 * etc1ImageSize(width, height);
+    uint32_t compressedSize = 0;
+    uint32_t texelCount = 0;
+    for (size_t i = 0; i < levels.size(); ++i) {
+        compressedSize += 2 * etc1ImageSize(levels[i].width, levels[i].height);
+        texelCount += levels[i].width * levels[i].height;
+    }
+    double rgba4444Time = measureRgba4444Decoding(colorData, alphaData);
+    double reduction = (double)baselineSize / compressedBaseSize;
+    printf("Atlas:              %ux%u texels, %u mipmap levels\n", width, height,
+            (unsigned int)levels.size());
+    printf("Before:             %u bytes (%u RGBA textures without mipmaps), "
+            "%.1f ms decoding the PNGs\n", baselineSize, (unsigned int)sources.size(),
+            baselineTime * 1e3);
+    printf("ETC1 (ES 2.0):      %u bytes level 0 (%.1fx smaller), %u bytes with mipmaps "
+            "(%.1fx), no decoding\n", compressedBaseSize, reduction, compressedSize,
+            (double)baselineSize / compressedSize);
+    printf("RGBA4444 (ES 1.1):  %u bytes level 0 (%.1fx smaller), %u bytes with mipmaps "
+            "(%.1fx), %.1f ms decoding the planes\n", width * height * 2,
+            (double)baselineSize / (width * height * 2), texelCount * 2,
+            (double)baselineSize / (texelCount * 2), rgba4444Time * 1e3);
+    printf("KTX files:          %u + %u bytes (verified by decoding them)\n",
+            (unsigned int)colorData.size(), (unsigned int)alphaData.size());
+    if (reduction < MIN_MEMORY_REDUCTION) {
+        fprintf(stderr, "ETC1 atlas is only %.1fx smaller, %.0fx required\n", reduction,
+                MIN_MEMORY_REDUCTION);
+        return 1;
+    }
+    return 0;
+}